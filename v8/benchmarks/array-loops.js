@@ -0,0 +1,139 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// This benchmark measures counted loops over integer arrays: summing,
+// reverse summing, copying and a small stencil. The loops compare the
+// index against the array length, which lets the optimizing compiler
+// prove most element accesses in bounds.
+
+var ArrayLoops = new BenchmarkSuite('ArrayLoops', 100000, [
+  new Benchmark("Sum", ArrayLoopsSum, ArrayLoopsSetup, ArrayLoopsTearDown),
+  new Benchmark("ReverseSum", ArrayLoopsReverseSum,
+                ArrayLoopsSetup, ArrayLoopsTearDown),
+  new Benchmark("Copy", ArrayLoopsCopy, ArrayLoopsSetup, ArrayLoopsTearDown),
+  new Benchmark("Stencil", ArrayLoopsStencil,
+                ArrayLoopsSetup, ArrayLoopsTearDown)
+]);
+
+
+var kArrayLoopsSize = 10000;
+
+var arrayLoopsSource = null;
+var arrayLoopsTarget = null;
+
+
+function ArrayLoopsSetup() {
+  // The benchmark framework guarantees that Math.random is
+  // deterministic; see base.js.
+  arrayLoopsSource = [];
+  arrayLoopsTarget = [];
+  for (var i = 0; i < kArrayLoopsSize; i++) {
+    arrayLoopsSource.push(Math.floor(Math.random() * 1000));
+    arrayLoopsTarget.push(0);
+  }
+}
+
+
+function ArrayLoopsTearDown() {
+  arrayLoopsSource = null;
+  arrayLoopsTarget = null;
+}
+
+
+function ArrayLoopsSumOf(a) {
+  var sum = 0;
+  for (var i = 0; i < a.length; i++) {
+    sum = (sum + a[i]) | 0;
+  }
+  return sum;
+}
+
+
+function ArrayLoopsReverseSumOf(a) {
+  var sum = 0;
+  for (var i = a.length - 1; i >= 0; i--) {
+    sum = (sum + a[i]) | 0;
+  }
+  return sum;
+}
+
+
+function ArrayLoopsCopyTo(a, b) {
+  for (var i = 0; i < a.length; i++) {
+    b[i] = a[i];
+  }
+}
+
+
+function ArrayLoopsStencilOf(a) {
+  var sum = 0;
+  for (var i = 1; i < a.length; i++) {
+    sum = (sum + a[i] - a[i - 1]) | 0;
+  }
+  return sum;
+}
+
+
+function ArrayLoopsSum() {
+  for (var i = 0; i < 10; i++) {
+    if (ArrayLoopsSumOf(arrayLoopsSource) < 0) {
+      throw new Error("ArrayLoops: negative sum");
+    }
+  }
+}
+
+
+function ArrayLoopsReverseSum() {
+  for (var i = 0; i < 10; i++) {
+    if (ArrayLoopsReverseSumOf(arrayLoopsSource) !=
+        ArrayLoopsSumOf(arrayLoopsSource)) {
+      throw new Error("ArrayLoops: sums differ");
+    }
+  }
+}
+
+
+function ArrayLoopsCopy() {
+  for (var i = 0; i < 10; i++) {
+    ArrayLoopsCopyTo(arrayLoopsSource, arrayLoopsTarget);
+  }
+  if (arrayLoopsTarget[kArrayLoopsSize - 1] !=
+      arrayLoopsSource[kArrayLoopsSize - 1]) {
+    throw new Error("ArrayLoops: copy failed");
+  }
+}
+
+
+function ArrayLoopsStencil() {
+  for (var i = 0; i < 10; i++) {
+    var expected = arrayLoopsSource[kArrayLoopsSize - 1] - arrayLoopsSource[0];
+    if (ArrayLoopsStencilOf(arrayLoopsSource) != expected) {
+      throw new Error("ArrayLoops: stencil failed");
+    }
+  }
+}
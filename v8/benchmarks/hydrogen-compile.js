@@ -0,0 +1,81 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Times optimizing compilation of generated functions with thousands of
+// virtual registers. Each function keeps many values alive across a chain
+// of branches and a loop, which stresses live range construction and
+// register allocation. Run from this directory with:
+//
+//   d8 --allow-natives-syntax --hydrogen-stats hydrogen-compile.js
+//
+// --hydrogen-stats prints the time spent in each Hydrogen and Lithium
+// phase when the shell exits.
+
+// The largest size stays below the number of values the register
+// allocator accepts; bigger functions are not optimized at all.
+var kHydrogenCompileSizes = [ 50, 100, 150 ];
+var kHydrogenCompileRepetitions = 5;
+
+function HydrogenCompileSource(size) {
+  var source = "var x = a | 0;\n";
+  for (var i = 0; i < size; i++) {
+    source += "var v" + i + " = (x + " + i + ") | 0;\n";
+    source += "if (x > " + i + ") { x = (x ^ v" + i + ") | 0; } " +
+              "else { x = (x + b) | 0; }\n";
+  }
+  source += "for (var j = 0; j < b; j++) {\n";
+  for (var i = 0; i < size; i += 8) {
+    source += "  x = (x + v" + i + ") | 0;\n";
+  }
+  source += "}\n";
+  for (var i = 0; i < size; i++) source += "x = (x + v" + i + ") | 0;\n";
+  source += "return x;\n";
+  return source;
+}
+
+
+function HydrogenCompileTime(size) {
+  var f = new Function("a", "b", HydrogenCompileSource(size));
+  f(1, 2);
+  f(2, 1);
+  %OptimizeFunctionOnNextCall(f);
+  var start = new Date();
+  f(3, 4);
+  return new Date() - start;
+}
+
+
+for (var i = 0; i < kHydrogenCompileSizes.length; i++) {
+  var size = kHydrogenCompileSizes[i];
+  var times = [];
+  for (var n = 0; n < kHydrogenCompileRepetitions; n++) {
+    times.push(HydrogenCompileTime(size));
+  }
+  times.sort(function(a, b) { return a - b; });
+  print("HydrogenCompile " + size + ": " +
+        times[kHydrogenCompileRepetitions >> 1] + "ms (median)");
+}
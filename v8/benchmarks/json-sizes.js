@@ -0,0 +1,54 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Times JSON.parse and JSON.stringify on payloads from 1MB to 50MB. Run
+// from this directory with:
+//
+//   d8 --expose-gc base.js json.js json-sizes.js
+
+var kJSONPayloadSizesInMB = [ 1, 5, 10, 25, 50 ];
+
+function JSONTime(f) {
+  var start = new Date();
+  f();
+  return new Date() - start;
+}
+
+
+for (var i = 0; i < kJSONPayloadSizesInMB.length; i++) {
+  var megabytes = kJSONPayloadSizesInMB[i];
+  var text = JSONGeneratePayload(megabytes * 1024 * 1024);
+  var value;
+  var parse = JSONTime(function() { value = JSON.parse(text); });
+  var stringify = JSONTime(function() { JSON.stringify(value); });
+  print("JSON " + megabytes + "MB: parse " + parse + "ms, stringify " +
+        stringify + "ms");
+  text = null;
+  value = null;
+  if (typeof gc == 'function') gc();
+}
@@ -0,0 +1,95 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// This benchmark measures JSON.parse and JSON.stringify on a payload of
+// records of the same shape, as typically returned by web services.
+
+var JSONBenchmark = new BenchmarkSuite('JSON', 100000, [
+  new Benchmark("JSONParse", JSONParseRun, JSONSetup, JSONTearDown),
+  new Benchmark("JSONStringify", JSONStringifyRun, JSONSetup, JSONTearDown)
+]);
+
+
+// Size of the payload in bytes used by the benchmark suite.
+var kJSONPayloadSize = 256 * 1024;
+
+var jsonText = null;
+var jsonValue = null;
+
+
+// Builds a JSON text of roughly the given size in bytes.
+function JSONGeneratePayload(size) {
+  // The benchmark framework guarantees that Math.random is
+  // deterministic; see base.js.
+  var records = [];
+  var length = 2;
+  while (length < size) {
+    var id = Math.floor(Math.random() * 1000000);
+    var record = {
+      id: id,
+      name: "user" + id,
+      score: Math.random() * 100,
+      active: (id & 1) == 0,
+      tags: [ "tag" + (id % 7), "tag" + (id % 11) ],
+      location: { lat: Math.random() * 180 - 90,
+                  lng: Math.random() * 360 - 180 },
+      note: (id % 5) == 0 ? "line\nbreak \"quoted\" é" : null
+    };
+    records.push(record);
+    length += JSON.stringify(record).length + 1;
+  }
+  return JSON.stringify({ version: 1, records: records });
+}
+
+
+function JSONSetup() {
+  jsonText = JSONGeneratePayload(kJSONPayloadSize);
+  jsonValue = JSON.parse(jsonText);
+}
+
+
+function JSONTearDown() {
+  jsonText = null;
+  jsonValue = null;
+}
+
+
+function JSONParseRun() {
+  var value = JSON.parse(jsonText);
+  if (value.records.length != jsonValue.records.length) {
+    throw new Error("JSON: wrong number of records");
+  }
+}
+
+
+function JSONStringifyRun() {
+  var text = JSON.stringify(jsonValue);
+  if (text.length != jsonText.length) {
+    throw new Error("JSON: wrong text length");
+  }
+}
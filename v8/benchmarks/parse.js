@@ -0,0 +1,85 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+
+// This benchmark measures parsing and full compilation of generated
+// scripts of a few hundred lines. Every run compiles a fresh source so
+// that the compilation cache does not hide the work.
+
+var ParseBenchmark = new BenchmarkSuite('Parse', 100000, [
+  new Benchmark("Statements", ParseStatements, ParseSetup, ParseTearDown),
+  new Benchmark("Functions", ParseFunctions, ParseSetup, ParseTearDown)
+]);
+
+
+var kParseLines = 400;
+
+var parseStatementsSource = null;
+var parseFunctionsSource = null;
+var parseCount = 0;
+
+
+function ParseSetup() {
+  var statements = [];
+  var functions = [];
+  for (var i = 0; i < kParseLines; i++) {
+    statements.push("var o" + i + " = { a: " + i + ", b: [" + i + ", 'x" +
+                    i + "'], c: o" + (i >> 1) + " && o" + (i >> 1) +
+                    ".a + " + i + " * (x - 1) };");
+    functions.push("function f" + i + "(a, b) { var t = a * " + i +
+                   "; for (var k = 0; k < b; k++) { t += k % 3 ? a : b; } " +
+                   "return t > " + i + " ? f" + (i >> 1) + "(t, 0) : t; }");
+  }
+  // Top-level statements are compiled eagerly; function bodies are only
+  // preparsed until they are called.
+  parseStatementsSource = "if (x) {\n" + statements.join("\n") + "\n}\n";
+  parseFunctionsSource = functions.join("\n") + "\n";
+}
+
+
+function ParseTearDown() {
+  parseStatementsSource = null;
+  parseFunctionsSource = null;
+}
+
+
+function ParseCompile(source) {
+  // A unique comment defeats the compilation cache.
+  var f = new Function("x", "// " + (parseCount++) + "\n" + source);
+  f(false);
+}
+
+
+function ParseStatements() {
+  ParseCompile(parseStatementsSource);
+}
+
+
+function ParseFunctions() {
+  ParseCompile(parseFunctionsSource);
+}
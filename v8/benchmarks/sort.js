@@ -0,0 +1,109 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// This benchmark measures Array.prototype.sort on arrays of small
+// integers, doubles and strings, with the default ordering and with a
+// user supplied comparison function.
+
+var Sort = new BenchmarkSuite('Sort', 100000, [
+  new Benchmark("SortSmis", SortSmis, SortSetup, SortTearDown),
+  new Benchmark("SortDoubles", SortDoubles, SortSetup, SortTearDown),
+  new Benchmark("SortStrings", SortStrings, SortSetup, SortTearDown),
+  new Benchmark("SortComparator", SortComparator, SortSetup, SortTearDown)
+]);
+
+
+var kSortArraySize = 2000;
+
+var sortSmis = null;
+var sortDoubles = null;
+var sortStrings = null;
+
+
+function SortSetup() {
+  // The benchmark framework guarantees that Math.random is
+  // deterministic; see base.js.
+  sortSmis = [];
+  sortDoubles = [];
+  sortStrings = [];
+  for (var i = 0; i < kSortArraySize; i++) {
+    var value = Math.floor(Math.random() * 100000);
+    sortSmis.push(value);
+    sortDoubles.push(value / 7);
+    sortStrings.push('key-' + value);
+  }
+}
+
+
+function SortTearDown() {
+  sortSmis = null;
+  sortDoubles = null;
+  sortStrings = null;
+}
+
+
+function CheckSorted(array, compare) {
+  for (var i = 1; i < array.length; i++) {
+    if (compare(array[i - 1], array[i]) > 0) {
+      throw new Error("Sort: array not sorted at index " + i);
+    }
+  }
+}
+
+
+function CompareAsStrings(x, y) {
+  x = String(x);
+  y = String(y);
+  return x < y ? -1 : (x == y ? 0 : 1);
+}
+
+
+function CompareAsNumbers(x, y) {
+  return x - y;
+}
+
+
+function SortSmis() {
+  CheckSorted(sortSmis.slice().sort(), CompareAsStrings);
+}
+
+
+function SortDoubles() {
+  CheckSorted(sortDoubles.slice().sort(), CompareAsStrings);
+}
+
+
+function SortStrings() {
+  CheckSorted(sortStrings.slice().sort(), CompareAsStrings);
+}
+
+
+function SortComparator() {
+  var result = sortDoubles.slice().sort(CompareAsNumbers);
+  CheckSorted(result, CompareAsNumbers);
+}
@@ -0,0 +1,66 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+
+// Measures the heap used by substrings of a large text, and the time it
+// takes to make them. Run from this directory with:
+//
+//   d8 --expose-gc --allow-natives-syntax string-ropes-memory.js
+//
+// and compare with --nostring-slices, which copies every substring.
+
+var kSubstringLengths = [ 16, 64, 256, 1024 ];
+var kSubstringCount = 100000;
+
+function MakeText(length) {
+  var parts = [];
+  for (var i = 0; parts.length * 10 < length; i++) {
+    parts.push("line " + (1000 + i % 9000) + "\n");
+  }
+  return parts.join("");
+}
+
+var text = MakeText(2 * 1024 * 1024);
+
+for (var i = 0; i < kSubstringLengths.length; i++) {
+  var length = kSubstringLengths[i];
+  var substrings = new Array(kSubstringCount);
+  gc();
+  var before = %GetHeapUsage();
+  var start = new Date();
+  for (var j = 0; j < kSubstringCount; j++) {
+    var offset = (j * 37) % (text.length - length);
+    substrings[j] = text.substring(offset, offset + length);
+  }
+  var time = new Date() - start;
+  gc();
+  var kilobytes = Math.round((%GetHeapUsage() - before) / 1024);
+  print("Substrings of " + length + " chars: " + kilobytes + "KB, " +
+        time + "ms");
+  substrings = null;
+}
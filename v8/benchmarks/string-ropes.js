@@ -0,0 +1,135 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+
+// This benchmark measures string building and string slicing: taking
+// many substrings of a large text, and appending to a string while
+// reading characters from it, or reading from a few finished strings in
+// turn.
+
+var StringRopesBenchmark = new BenchmarkSuite('StringRopes', 100000, [
+  new Benchmark("Substring", StringRopesSubstring,
+                StringRopesSetup, StringRopesTearDown),
+  new Benchmark("SubstringRegExp", StringRopesSubstringRegExp,
+                StringRopesSetup, StringRopesTearDown),
+  new Benchmark("AppendAndRead", StringRopesAppendAndRead,
+                StringRopesSetup, StringRopesTearDown),
+  new Benchmark("AlternatingReads", StringRopesAlternatingReads,
+                StringRopesSetup, StringRopesTearDown)
+]);
+
+
+var kStringRopesTextLength = 64 * 1024;
+var kStringRopesLineLength = 80;
+
+var stringRopesText = null;
+
+
+function StringRopesSetup() {
+  // The benchmark framework guarantees that Math.random is
+  // deterministic; see base.js.
+  var words = [ "lorem", "ipsum", "dolor", "sit", "amet", "consectetur",
+                "adipiscing", "elit", "sed", "do", "eiusmod", "tempor" ];
+  var parts = [];
+  var length = 0;
+  while (length < kStringRopesTextLength) {
+    var word = words[Math.floor(Math.random() * words.length)];
+    parts.push(word);
+    length += word.length + 1;
+  }
+  stringRopesText = parts.join(" ");
+}
+
+
+function StringRopesTearDown() {
+  stringRopesText = null;
+}
+
+
+// Cuts the text into lines and looks at the first and last character of
+// each of them.
+function StringRopesSubstring() {
+  var text = stringRopesText;
+  var lines = [];
+  var sum = 0;
+  for (var i = 0; i + kStringRopesLineLength <= text.length;
+       i += kStringRopesLineLength / 2) {
+    var line = text.substring(i, i + kStringRopesLineLength);
+    sum += line.charCodeAt(0) + line.charCodeAt(line.length - 1);
+    lines.push(line);
+  }
+  if (sum == 0 || lines.length == 0) {
+    throw new Error("StringRopes: no lines");
+  }
+}
+
+
+// Matches a regular expression against lines cut out of the text.
+function StringRopesSubstringRegExp() {
+  var text = stringRopesText;
+  var re = /(\w+) (\w+)$/;
+  var count = 0;
+  for (var i = 0; i + kStringRopesLineLength <= text.length;
+       i += kStringRopesLineLength) {
+    if (re.exec(text.substr(i, kStringRopesLineLength))) count++;
+  }
+  if (count == 0) throw new Error("StringRopes: no matches");
+}
+
+
+// Builds a string one word at a time and peeks at it after every append,
+// the way a tokenizer accumulating its output would.
+function StringRopesAppendAndRead() {
+  var text = stringRopesText;
+  var result = "";
+  var spaces = 0;
+  for (var i = 0; i < 4096; i += 8) {
+    result += text.substring(i, i + 8);
+    if (result.charCodeAt(result.length - 1) == 32) spaces++;
+    if (result.charCodeAt(0) == 32) spaces++;
+  }
+  if (result.length != 4096) throw new Error("StringRopes: bad length");
+}
+
+
+// Builds a few strings by appending to a common prefix and reads all their
+// characters, one string after the other.  Each string should be flattened
+// once rather than have every character read from the rope.
+function StringRopesAlternatingReads() {
+  var base = stringRopesText.substring(0, 1000);
+  var sum = 0;
+  for (var r = 0; r < 20; r++) {
+    var ropes = [ base + String(r), base + String(r + 1) ];
+    for (var pass = 0; pass < 5; pass++) {
+      for (var i = 0; i < base.length; i++) {
+        sum += ropes[0].charCodeAt(i) + ropes[1].charCodeAt(i);
+      }
+    }
+  }
+  if (sum == 0) throw new Error("StringRopes: no characters");
+}
@@ -0,0 +1,145 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// This benchmark measures string searching through indexOf, split and
+// replace with string patterns, on one-byte (ASCII) and two-byte
+// subjects.
+
+var StringSearchBenchmark = new BenchmarkSuite('StringSearch', 100000, [
+  new Benchmark("IndexOfAscii", StringSearchIndexOfAscii,
+                StringSearchSetup, StringSearchTearDown),
+  new Benchmark("IndexOfTwoByte", StringSearchIndexOfTwoByte,
+                StringSearchSetup, StringSearchTearDown),
+  new Benchmark("SplitAscii", StringSearchSplitAscii,
+                StringSearchSetup, StringSearchTearDown),
+  new Benchmark("SplitTwoByte", StringSearchSplitTwoByte,
+                StringSearchSetup, StringSearchTearDown),
+  new Benchmark("ReplaceAscii", StringSearchReplaceAscii,
+                StringSearchSetup, StringSearchTearDown),
+  new Benchmark("ReplaceTwoByte", StringSearchReplaceTwoByte,
+                StringSearchSetup, StringSearchTearDown)
+]);
+
+
+var kStringSearchSubjectLength = 64 * 1024;
+
+// Patterns of one, two and more characters, both frequent and rare.
+var kStringSearchPatterns = [ "e", "q", "el", "qu", "dolor", "sit amet",
+                              "elite", "consectetur adipiscing" ];
+
+var stringSearchAscii = null;
+var stringSearchTwoByte = null;
+
+
+function StringSearchMakeSubject(length) {
+  // The benchmark framework guarantees that Math.random is
+  // deterministic; see base.js.
+  var words = [ "lorem", "ipsum", "dolor", "sit", "amet", "consectetur",
+                "adipiscing", "elit", "sed", "do", "eiusmod", "tempor" ];
+  var parts = [];
+  var subject_length = 0;
+  while (subject_length < length) {
+    var word = words[Math.floor(Math.random() * words.length)];
+    parts.push(word);
+    subject_length += word.length + 1;
+  }
+  return parts.join(" ");
+}
+
+
+function StringSearchSetup() {
+  stringSearchAscii = StringSearchMakeSubject(kStringSearchSubjectLength);
+  // The same text with a two-byte character in front.
+  stringSearchTwoByte = "—" + stringSearchAscii;
+}
+
+
+function StringSearchTearDown() {
+  stringSearchAscii = null;
+  stringSearchTwoByte = null;
+}
+
+
+function StringSearchIndexOf(subject) {
+  var count = 0;
+  for (var i = 0; i < kStringSearchPatterns.length; i++) {
+    var pattern = kStringSearchPatterns[i];
+    for (var index = subject.indexOf(pattern);
+         index >= 0;
+         index = subject.indexOf(pattern, index + 1)) {
+      count++;
+    }
+  }
+  if (count == 0) throw new Error("StringSearch: no matches");
+}
+
+
+function StringSearchSplit(subject) {
+  if (subject.split(" ").length < 2 || subject.split("or").length < 2) {
+    throw new Error("StringSearch: split failed");
+  }
+}
+
+
+function StringSearchReplace(subject) {
+  var result = subject.replace("consectetur", "x");
+  result = result.replace(/dolor/g, "y");
+  if (result.length >= subject.length) {
+    throw new Error("StringSearch: replace failed");
+  }
+}
+
+
+function StringSearchIndexOfAscii() {
+  StringSearchIndexOf(stringSearchAscii);
+}
+
+
+function StringSearchIndexOfTwoByte() {
+  StringSearchIndexOf(stringSearchTwoByte);
+}
+
+
+function StringSearchSplitAscii() {
+  StringSearchSplit(stringSearchAscii);
+}
+
+
+function StringSearchSplitTwoByte() {
+  StringSearchSplit(stringSearchTwoByte);
+}
+
+
+function StringSearchReplaceAscii() {
+  StringSearchReplace(stringSearchAscii);
+}
+
+
+function StringSearchReplaceTwoByte() {
+  StringSearchReplace(stringSearchTwoByte);
+}
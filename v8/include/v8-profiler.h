@@ -379,6 +379,64 @@ class V8EXPORT HeapSnapshot {
 };
 
 
+/**
+ * AllocationProfileNode represents a function in the call tree of
+ * sampled heap allocations.
+ */
+class V8EXPORT AllocationProfileNode {
+ public:
+  /** Returns function name (empty string for the root node.) */
+  Handle<String> GetFunctionName() const;
+
+  /** Returns resource name for script from where the function originates. */
+  Handle<String> GetScriptResourceName() const;
+
+  /**
+   * Returns the number, 1-based, of the line where the function originates.
+   * kNoLineNumberInfo if no line number information is available.
+   */
+  int GetLineNumber() const;
+
+  /**
+   * Returns the estimated number of bytes allocated while the function
+   * was on top of the JavaScript stack.
+   */
+  intptr_t GetSelfSize() const;
+
+  /** Returns the count of samples taken while the function was on top. */
+  int GetSelfSamplesCount() const;
+
+  /** Returns child nodes count of the node. */
+  int GetChildrenCount() const;
+
+  /** Retrieves a child node by index. */
+  const AllocationProfileNode* GetChild(int index) const;
+
+  static const int kNoLineNumberInfo = Message::kNoLineNumberInfo;
+};
+
+
+/**
+ * AllocationProfile is a top-down call tree of heap allocations, built
+ * from the JavaScript stacks captured every time another sample interval
+ * worth of bytes has been allocated.
+ */
+class V8EXPORT AllocationProfile {
+ public:
+  /** Returns the root node of the call tree. */
+  const AllocationProfileNode* GetRoot() const;
+
+  /** Returns the number of bytes between two samples. */
+  int GetSampleInterval() const;
+
+  /**
+   * Deletes the profile. All pointers to nodes previously returned
+   * become invalid.
+   */
+  void Delete();
+};
+
+
 class RetainedObjectInfo;
 
 /**
@@ -413,12 +471,44 @@ class V8EXPORT HeapProfiler {
       HeapSnapshot::Type type = HeapSnapshot::kFull,
       ActivityControl* control = NULL);
 
+  /**
+   * Takes a full heap snapshot and writes it to the stream in JSON format
+   * while the heap is being traversed, instead of keeping the snapshot in
+   * memory. The snapshot is not added to the list of taken snapshots.
+   * Dominators are not computed: every node is reported as dominated by
+   * the root, with its retained size equal to its self size. Returns
+   * false if the generation was aborted through the activity control,
+   * in which case the stream is ended where the generation stopped.
+   */
+  static bool StreamSnapshot(Handle<String> title,
+                             OutputStream* stream,
+                             ActivityControl* control = NULL);
+
   /**
    * Deletes all snapshots taken. All previously returned pointers to
    * snapshots and their contents become invalid after this call.
    */
   static void DeleteAllSnapshots();
 
+  /**
+   * Starts sampling heap allocations. Every time sample_interval more
+   * bytes have been allocated, the current JavaScript stack is recorded
+   * and charged with the bytes allocated since the previous sample.
+   * Objects allocated inline by generated code are not seen unless V8
+   * runs with --noinline-new. Does nothing if sampling is already on.
+   */
+  static void StartAllocationSampling(
+      int sample_interval = kDefaultAllocationSampleInterval);
+
+  /**
+   * Stops sampling heap allocations and returns the collected profile,
+   * or NULL if sampling was not started. The caller must Delete the
+   * profile when done with it.
+   */
+  static const AllocationProfile* StopAllocationSampling();
+
+  static const int kDefaultAllocationSampleInterval = 512 * 1024;
+
   /** Binds a callback to embedder's class ID. */
   static void DefineWrapperClass(
       uint16_t class_id,
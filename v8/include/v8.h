@@ -3373,6 +3373,19 @@ class V8EXPORT Context {
  * from V8, where you want to release the V8 lock for other threads to
  * use.
  *
+ * Each isolate has its own lock.  Passing an isolate to the Locker
+ * locks and enters that isolate for the lifetime of the Locker, so
+ * that threads running in different isolates never wait for each
+ * other:
+ *
+ * \code
+ * {
+ *   v8::Locker locker(isolate);
+ *   // isolate is locked and entered.
+ *   ...
+ * } // isolate is exited and unlocked.
+ * \endcode
+ *
  * The v8::Locker is a recursive lock.  That is, you can lock more than
  * once in a given thread.  This can be useful if you have code that can
  * be called either from code that holds the lock or from code that does
@@ -3404,14 +3417,24 @@ class V8EXPORT Context {
  */
 class V8EXPORT Unlocker {
  public:
-  Unlocker();
+  /**
+   * Unlocks the given isolate, or the current one if none is given.
+   */
+  explicit Unlocker(Isolate* isolate = NULL);
   ~Unlocker();
+ private:
+  internal::Isolate* isolate_;
+  bool exited_;
 };
 
 
 class V8EXPORT Locker {
  public:
-  Locker();
+  /**
+   * Locks the given isolate, or the default isolate if none is given.
+   * A non-default isolate is also entered until the Locker is destroyed.
+   */
+  explicit Locker(Isolate* isolate = NULL);
   ~Locker();
 
   /**
@@ -3429,9 +3452,10 @@ class V8EXPORT Locker {
   static void StopPreemption();
 
   /**
-   * Returns whether or not the locker is locked by the current thread.
+   * Returns whether or not the locker for the given isolate, or the
+   * current one if none is given, is locked by the current thread.
    */
-  static bool IsLocked();
+  static bool IsLocked(Isolate* isolate = NULL);
 
   /**
    * Returns whether v8::Locker is being used by this V8 instance.
@@ -3441,6 +3465,8 @@ class V8EXPORT Locker {
  private:
   bool has_lock_;
   bool top_level_;
+  bool entered_;
+  internal::Isolate* isolate_;
 
   static bool active_;
 
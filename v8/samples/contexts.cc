@@ -0,0 +1,175 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <v8.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * This sample measures how long it takes an embedder to get a fresh,
+ * ready-to-use context.  Each iteration creates a context, optionally runs
+ * a setup script in it (the way an embedder initializes its own
+ * environment), runs a trivial script and disposes the context again.
+ *
+ * Comparing a build that runs the setup script in every context with a
+ * build whose snapshot already contains it (snapshot=on
+ * snapshot_extra_code=setup.js) shows how much of the per-context cost the
+ * context snapshot removes.
+ *
+ * Usage: contexts [--iterations=<n>] [--setup=<file>] [<v8 flags>]
+ */
+
+v8::Handle<v8::String> ReadFile(const char* name);
+void ReportException(v8::TryCatch* try_catch);
+
+
+static const int kDefaultIterations = 1000;
+
+// How often the sample tells V8 that contexts have been disposed, so that
+// the garbage collector can reclaim them without waiting for a full heap.
+static const int kContextsPerDisposeNotification = 50;
+
+
+bool RunScript(v8::Handle<v8::String> source, v8::Handle<v8::String> name) {
+  v8::HandleScope handle_scope;
+  v8::TryCatch try_catch;
+  v8::Handle<v8::Script> script = v8::Script::Compile(source, name);
+  if (!script.IsEmpty()) script->Run();
+  if (try_catch.HasCaught()) {
+    ReportException(&try_catch);
+    return false;
+  }
+  return true;
+}
+
+
+int RunMain(int argc, char* argv[]) {
+  v8::V8::SetFlagsFromCommandLine(&argc, argv, true);
+  int iterations = kDefaultIterations;
+  const char* setup_file = NULL;
+  for (int i = 1; i < argc; i++) {
+    const char* str = argv[i];
+    if (strncmp(str, "--iterations=", 13) == 0) {
+      iterations = atoi(str + 13);
+    } else if (strncmp(str, "--setup=", 8) == 0) {
+      setup_file = str + 8;
+    } else {
+      printf("Unknown option: %s\n", str);
+      printf("Usage: %s [--iterations=<n>] [--setup=<file>]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (iterations <= 0) iterations = kDefaultIterations;
+
+  v8::HandleScope handle_scope;
+  v8::Persistent<v8::String> setup_source;
+  if (setup_file != NULL) {
+    v8::Handle<v8::String> source = ReadFile(setup_file);
+    if (source.IsEmpty()) {
+      printf("Error reading '%s'\n", setup_file);
+      return 1;
+    }
+    setup_source = v8::Persistent<v8::String>::New(source);
+  }
+  v8::Handle<v8::String> setup_name =
+      v8::String::New(setup_file != NULL ? setup_file : "setup");
+  v8::Handle<v8::String> probe = v8::String::New("this");
+  v8::Handle<v8::String> probe_name = v8::String::New("probe");
+
+  clock_t start = clock();
+  for (int i = 0; i < iterations; i++) {
+    v8::Persistent<v8::Context> context = v8::Context::New();
+    if (context.IsEmpty()) {
+      printf("Error creating context\n");
+      return 1;
+    }
+    {
+      v8::Context::Scope context_scope(context);
+      if (!setup_source.IsEmpty() && !RunScript(setup_source, setup_name)) {
+        return 1;
+      }
+      if (!RunScript(probe, probe_name)) return 1;
+    }
+    context.Dispose();
+    if ((i + 1) % kContextsPerDisposeNotification == 0) {
+      v8::V8::ContextDisposedNotification();
+    }
+  }
+  double elapsed_ms =
+      static_cast<double>(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+
+  printf("Contexts: %d\n", iterations);
+  printf("Setup: %s\n", setup_file != NULL ? setup_file : "(none)");
+  printf("Time per context: %.3f ms\n", elapsed_ms / iterations);
+  setup_source.Dispose();
+  return 0;
+}
+
+
+int main(int argc, char* argv[]) {
+  int result = RunMain(argc, argv);
+  v8::V8::Dispose();
+  return result;
+}
+
+
+// Reads a file into a v8 string.
+v8::Handle<v8::String> ReadFile(const char* name) {
+  FILE* file = fopen(name, "rb");
+  if (file == NULL) return v8::Handle<v8::String>();
+
+  fseek(file, 0, SEEK_END);
+  int size = ftell(file);
+  rewind(file);
+
+  char* chars = new char[size + 1];
+  chars[size] = '\0';
+  for (int i = 0; i < size;) {
+    int read = fread(&chars[i], 1, size - i, file);
+    i += read;
+  }
+  fclose(file);
+  v8::Handle<v8::String> result = v8::String::New(chars, size);
+  delete[] chars;
+  return result;
+}
+
+
+void ReportException(v8::TryCatch* try_catch) {
+  v8::HandleScope handle_scope;
+  v8::String::Utf8Value exception(try_catch->Exception());
+  v8::Handle<v8::Message> message = try_catch->Message();
+  if (message.IsEmpty()) {
+    printf("%s\n", *exception);
+  } else {
+    v8::String::Utf8Value filename(message->GetScriptResourceName());
+    printf("%s:%i: %s\n", *filename, message->GetLineNumber(), *exception);
+  }
+}
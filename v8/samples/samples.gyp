@@ -46,6 +46,26 @@
       'sources': [
         'process.cc',
       ],
+    },
+    {
+      'target_name': 'contexts',
+      'type': 'executable',
+      'dependencies': [
+        '../tools/gyp/v8.gyp:v8',
+      ],
+      'sources': [
+        'contexts.cc',
+      ],
+    },
+    {
+      'target_name': 'workers',
+      'type': 'executable',
+      'dependencies': [
+        '../tools/gyp/v8.gyp:v8',
+      ],
+      'sources': [
+        'workers.cc',
+      ],
     }
   ],
 }
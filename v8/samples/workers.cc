@@ -0,0 +1,383 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <v8.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// The pool uses V8's platform abstraction for threads and locks, which is
+// not part of the public API (see shell.cc).
+#ifndef USING_V8_SHARED
+#include "../src/v8.h"
+#endif  // USING_V8_SHARED
+
+/**
+ * This sample shows how an embedder can run JavaScript on several cores at
+ * once.  Isolates do not share any JavaScript state, so instead of sharing
+ * one isolate between threads under a v8::Locker, the embedder creates a
+ * pool of isolates, each pinned to a worker thread of its own, and talks to
+ * them by passing string messages:
+ *
+ *  - The pool runs a script in every isolate.  The script defines an
+ *    onmessage(job) function.
+ *  - Post() queues a job.  Whichever worker is idle takes it and calls its
+ *    onmessage function.
+ *  - The script calls postMessage(result) to send a result back, which the
+ *    embedder picks up with Receive().
+ *
+ * Run as a benchmark, the sample executes the same number of independent
+ * jobs with 1, 2, 4, ... worker threads and reports the throughput and how
+ * it scales with the number of threads.
+ *
+ * Usage: workers [--threads=<n>] [--jobs=<n>] [<script>] [<v8 flags>]
+ */
+
+#ifndef USING_V8_SHARED
+
+namespace i = v8::internal;
+
+
+// The default job: allocation-heavy work that exercises the compiler, the
+// garbage collector and the runtime of the isolate running it.
+static const char* kDefaultScript =
+    "function onmessage(job) {"
+    "  var seed = Number(job);"
+    "  var records = [];"
+    "  for (var i = 0; i < 20000; i++) {"
+    "    seed = (seed * 1103515245 + 12345) % 2147483648;"
+    "    records.push({ key: 'k' + (seed % 1000), value: seed });"
+    "  }"
+    "  records.sort(function(a, b) { return a.value - b.value; });"
+    "  var counts = {};"
+    "  for (var i = 0; i < records.length; i++) {"
+    "    var key = records[i].key;"
+    "    counts[key] = (counts[key] || 0) + 1;"
+    "  }"
+    "  var text = JSON.stringify(counts);"
+    "  postMessage(job + ':' + text.replace(/[0-9]+/g, 'n').length);"
+    "}";
+
+
+// A queue of string messages shared between threads.
+class MessageQueue {
+ public:
+  MessageQueue()
+      : mutex_(i::OS::CreateMutex()),
+        available_(i::OS::CreateSemaphore(0)),
+        head_(0),
+        closed_(false) { }
+
+  ~MessageQueue() {
+    delete available_;
+    delete mutex_;
+  }
+
+  void Enqueue(const std::string& message) {
+    {
+      i::ScopedLock lock(mutex_);
+      messages_.push_back(message);
+    }
+    available_->Signal();
+  }
+
+  // Waits for the next message.  Returns false once the queue is closed and
+  // empty.
+  bool Dequeue(std::string* message) {
+    available_->Wait();
+    i::ScopedLock lock(mutex_);
+    if (head_ == messages_.size()) {
+      // Closed.  Pass the wake-up on to the next waiting thread.
+      available_->Signal();
+      return false;
+    }
+    *message = messages_[head_++];
+    if (head_ == messages_.size()) {
+      messages_.clear();
+      head_ = 0;
+    }
+    return true;
+  }
+
+  void Close() {
+    i::ScopedLock lock(mutex_);
+    if (closed_) return;
+    closed_ = true;
+    available_->Signal();
+  }
+
+ private:
+  i::Mutex* mutex_;
+  i::Semaphore* available_;
+  std::vector<std::string> messages_;
+  size_t head_;
+  bool closed_;
+};
+
+
+// A pool of isolates, each owned by one worker thread.
+class IsolatePool {
+ public:
+  IsolatePool(int size, const std::string& source);
+  ~IsolatePool();
+
+  // Queues a job for the next idle worker.
+  void Post(const std::string& job) { jobs_.Enqueue(job); }
+
+  // Waits for the next result posted by a worker.
+  bool Receive(std::string* result) { return results_.Dequeue(result); }
+
+  // Returns false if the script failed to run in some worker.
+  bool ok() const { return ok_; }
+
+ private:
+  static i::Thread::Options GetThreadOptions() {
+    i::Thread::Options options;
+    options.name = "IsolatePoolWorker";
+    // Some systems default to a stack that is too small for V8.
+    options.stack_size = 2 << 20;
+    return options;
+  }
+
+  class WorkerThread : public i::Thread {
+   public:
+    explicit WorkerThread(IsolatePool* pool)
+        : i::Thread(NULL, GetThreadOptions()), pool_(pool) { }
+    virtual void Run() { pool_->RunWorker(); }
+   private:
+    IsolatePool* pool_;
+  };
+
+  void RunWorker();
+  static v8::Handle<v8::Value> PostMessage(const v8::Arguments& args);
+
+  std::string source_;
+  std::vector<WorkerThread*> threads_;
+  MessageQueue jobs_;
+  MessageQueue results_;
+  i::Semaphore* ready_;
+  bool ok_;
+};
+
+
+IsolatePool::IsolatePool(int size, const std::string& source)
+    : source_(source),
+      ready_(i::OS::CreateSemaphore(0)),
+      ok_(true) {
+  for (int i = 0; i < size; i++) {
+    WorkerThread* thread = new WorkerThread(this);
+    threads_.push_back(thread);
+    thread->Start();
+  }
+  // Wait until every worker has set up its isolate, so that the time spent
+  // on that is not counted as time spent on jobs.
+  for (int i = 0; i < size; i++) ready_->Wait();
+}
+
+
+IsolatePool::~IsolatePool() {
+  jobs_.Close();
+  for (size_t i = 0; i < threads_.size(); i++) {
+    threads_[i]->Join();
+    delete threads_[i];
+  }
+  delete ready_;
+}
+
+
+void IsolatePool::RunWorker() {
+  // The isolate is only ever used by this thread, so no locking is needed.
+  // An embedder that also uses v8::Locker would lock it with
+  // v8::Locker(isolate), which never waits for other isolates.
+  v8::Isolate* isolate = v8::Isolate::New();
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope;
+    v8::Handle<v8::ObjectTemplate> global = v8::ObjectTemplate::New();
+    v8::Handle<v8::Value> data = v8::External::New(this);
+    global->Set(v8::String::New("postMessage"),
+                v8::FunctionTemplate::New(PostMessage, data));
+    v8::Persistent<v8::Context> context = v8::Context::New(NULL, global);
+    {
+      v8::Context::Scope context_scope(context);
+      v8::TryCatch try_catch;
+      v8::Handle<v8::Script> script = v8::Script::Compile(
+          v8::String::New(source_.data(), static_cast<int>(source_.size())));
+      if (!script.IsEmpty()) script->Run();
+      v8::Handle<v8::Value> onmessage =
+          context->Global()->Get(v8::String::New("onmessage"));
+      if (try_catch.HasCaught() || !onmessage->IsFunction()) {
+        v8::String::Utf8Value exception(try_catch.Exception());
+        printf("Worker setup failed: %s\n",
+               try_catch.HasCaught() ? *exception : "no onmessage function");
+        ok_ = false;
+      }
+      ready_->Signal();
+
+      std::string job;
+      while (ok_ && jobs_.Dequeue(&job)) {
+        v8::HandleScope job_scope;
+        v8::Handle<v8::Value> argv[] = {
+          v8::String::New(job.data(), static_cast<int>(job.size()))
+        };
+        v8::Handle<v8::Function>::Cast(onmessage)->Call(
+            context->Global(), 1, argv);
+        if (try_catch.HasCaught()) {
+          v8::String::Utf8Value exception(try_catch.Exception());
+          results_.Enqueue(std::string("error: ") + *exception);
+          try_catch.Reset();
+        }
+      }
+    }
+    context.Dispose();
+  }
+  isolate->Dispose();
+}
+
+
+v8::Handle<v8::Value> IsolatePool::PostMessage(const v8::Arguments& args) {
+  IsolatePool* pool =
+      static_cast<IsolatePool*>(v8::External::Unwrap(args.Data()));
+  v8::String::Utf8Value message(args[0]);
+  pool->results_.Enqueue(std::string(*message, message.length()));
+  return v8::Undefined();
+}
+
+
+// Runs the given number of jobs on a pool with the given number of threads
+// and returns the time it took in milliseconds, or -1 on failure.
+double RunJobs(int threads, int jobs, const std::string& source) {
+  IsolatePool pool(threads, source);
+  if (!pool.ok()) return -1;
+  double start = i::OS::TimeCurrentMillis();
+  char job[16];
+  for (int i = 0; i < jobs; i++) {
+    i::OS::SNPrintF(i::Vector<char>(job, sizeof(job)), "%d", i + 1);
+    pool.Post(job);
+  }
+  std::string result;
+  for (int i = 0; i < jobs; i++) {
+    if (!pool.Receive(&result)) return -1;
+    if (result.compare(0, 7, "error: ") == 0) {
+      printf("%s\n", result.c_str());
+      return -1;
+    }
+  }
+  return i::OS::TimeCurrentMillis() - start;
+}
+
+#endif  // USING_V8_SHARED
+
+
+v8::Handle<v8::String> ReadFile(const char* name);
+
+
+int RunMain(int argc, char* argv[]) {
+  v8::V8::SetFlagsFromCommandLine(&argc, argv, true);
+  int max_threads = 4;
+  int jobs = 64;
+  const char* script_file = NULL;
+  for (int i = 1; i < argc; i++) {
+    const char* str = argv[i];
+    if (strncmp(str, "--threads=", 10) == 0) {
+      max_threads = atoi(str + 10);
+    } else if (strncmp(str, "--jobs=", 7) == 0) {
+      jobs = atoi(str + 7);
+    } else if (strncmp(str, "--", 2) == 0) {
+      printf("Warning: unknown flag %s.\n", str);
+    } else {
+      script_file = str;
+    }
+  }
+  if (max_threads < 1 || jobs < 1) {
+    printf("Usage: %s [--threads=<n>] [--jobs=<n>] [<script>]\n", argv[0]);
+    return 1;
+  }
+#ifdef USING_V8_SHARED
+  printf("Error: the isolate pool is not supported when linked with shared "
+         "library\n");
+  return 1;
+#else  // USING_V8_SHARED
+  std::string source = kDefaultScript;
+  if (script_file != NULL) {
+    v8::HandleScope handle_scope;
+    v8::Handle<v8::String> file_source = ReadFile(script_file);
+    if (file_source.IsEmpty()) {
+      printf("Error reading '%s'\n", script_file);
+      return 1;
+    }
+    v8::String::Utf8Value utf8_source(file_source);
+    source = std::string(*utf8_source, utf8_source.length());
+  }
+
+  printf("%7s %10s %10s %8s\n", "Threads", "Time (ms)", "Jobs/s", "Speedup");
+  double base_time = 0;
+  for (int threads = 1; ; threads *= 2) {
+    if (threads > max_threads) threads = max_threads;
+    double time = RunJobs(threads, jobs, source);
+    if (time < 0) return 1;
+    if (time < 1) time = 1;
+    if (base_time == 0) base_time = time;
+    printf("%7d %10.0f %10.1f %8.2f\n",
+           threads, time, jobs * 1000.0 / time, base_time / time);
+    if (threads == max_threads) break;
+  }
+  return 0;
+#endif  // USING_V8_SHARED
+}
+
+
+int main(int argc, char* argv[]) {
+  int result = RunMain(argc, argv);
+  v8::V8::Dispose();
+  return result;
+}
+
+
+// Reads a file into a v8 string.
+v8::Handle<v8::String> ReadFile(const char* name) {
+  FILE* file = fopen(name, "rb");
+  if (file == NULL) return v8::Handle<v8::String>();
+
+  fseek(file, 0, SEEK_END);
+  int size = ftell(file);
+  rewind(file);
+
+  char* chars = new char[size + 1];
+  chars[size] = '\0';
+  for (int i = 0; i < size;) {
+    int read = fread(&chars[i], 1, size - i, file);
+    i += read;
+  }
+  fclose(file);
+  v8::Handle<v8::String> result = v8::String::New(chars, size);
+  delete[] chars;
+  return result;
+}
@@ -5539,6 +5539,22 @@ const HeapSnapshot* HeapProfiler::TakeSnapshot(Handle<String> title,
 }
 
 
+bool HeapProfiler::StreamSnapshot(Handle<String> title,
+                                  OutputStream* stream,
+                                  ActivityControl* control) {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::HeapProfiler::StreamSnapshot");
+  ApiCheck(stream->GetOutputEncoding() == OutputStream::kAscii,
+           "v8::HeapProfiler::StreamSnapshot",
+           "Unsupported output encoding");
+  ApiCheck(stream->GetChunkSize() > 0,
+           "v8::HeapProfiler::StreamSnapshot",
+           "Invalid stream chunk size");
+  return i::HeapProfiler::StreamSnapshot(
+      *Utils::OpenHandle(*title), stream, control);
+}
+
+
 void HeapProfiler::DeleteAllSnapshots() {
   i::Isolate* isolate = i::Isolate::Current();
   IsDeadCheck(isolate, "v8::HeapProfiler::DeleteAllSnapshots");
@@ -5552,6 +5568,110 @@ void HeapProfiler::DefineWrapperClass(uint16_t class_id,
                                                              callback);
 }
 
+
+void HeapProfiler::StartAllocationSampling(int sample_interval) {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::HeapProfiler::StartAllocationSampling");
+  ApiCheck(sample_interval > 0,
+           "v8::HeapProfiler::StartAllocationSampling",
+           "Invalid sample interval");
+  i::HeapProfiler::StartAllocationSampling(sample_interval);
+}
+
+
+const AllocationProfile* HeapProfiler::StopAllocationSampling() {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::HeapProfiler::StopAllocationSampling");
+  return reinterpret_cast<const AllocationProfile*>(
+      i::HeapProfiler::StopAllocationSampling());
+}
+
+
+static const i::AllocationProfileNode* ToInternal(
+    const AllocationProfileNode* node) {
+  return reinterpret_cast<const i::AllocationProfileNode*>(node);
+}
+
+
+Handle<String> AllocationProfileNode::GetFunctionName() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetFunctionName");
+  return Handle<String>(ToApi<String>(
+      isolate->factory()->LookupAsciiSymbol(ToInternal(this)->name())));
+}
+
+
+Handle<String> AllocationProfileNode::GetScriptResourceName() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetScriptResourceName");
+  return Handle<String>(ToApi<String>(isolate->factory()->LookupAsciiSymbol(
+      ToInternal(this)->resource_name())));
+}
+
+
+int AllocationProfileNode::GetLineNumber() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetLineNumber");
+  return ToInternal(this)->line_number();
+}
+
+
+intptr_t AllocationProfileNode::GetSelfSize() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetSelfSize");
+  return ToInternal(this)->self_size();
+}
+
+
+int AllocationProfileNode::GetSelfSamplesCount() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetSelfSamplesCount");
+  return ToInternal(this)->self_samples();
+}
+
+
+int AllocationProfileNode::GetChildrenCount() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetChildrenCount");
+  return ToInternal(this)->children()->length();
+}
+
+
+const AllocationProfileNode* AllocationProfileNode::GetChild(int index) const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfileNode::GetChild");
+  return reinterpret_cast<const AllocationProfileNode*>(
+      ToInternal(this)->children()->at(index));
+}
+
+
+static i::AllocationProfile* ToInternal(const AllocationProfile* profile) {
+  return const_cast<i::AllocationProfile*>(
+      reinterpret_cast<const i::AllocationProfile*>(profile));
+}
+
+
+const AllocationProfileNode* AllocationProfile::GetRoot() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfile::GetRoot");
+  return reinterpret_cast<const AllocationProfileNode*>(
+      ToInternal(this)->root());
+}
+
+
+int AllocationProfile::GetSampleInterval() const {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfile::GetSampleInterval");
+  return ToInternal(this)->sample_interval();
+}
+
+
+void AllocationProfile::Delete() {
+  i::Isolate* isolate = i::Isolate::Current();
+  IsDeadCheck(isolate, "v8::AllocationProfile::Delete");
+  delete ToInternal(this);
+}
+
 #endif  // ENABLE_LOGGING_AND_PROFILING
 
 
@@ -4530,6 +4530,9 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   // Handle non-flat strings.
   __ tst(result_, Operand(kIsConsStringMask));
   __ b(eq, &call_runtime_);
+  // Sliced strings are read by the runtime system.
+  __ tst(result_, Operand(kSlicedNotConsMask));
+  __ b(ne, &call_runtime_);
 
   // ConsString.
   // Check whether the right hand side is the empty string (i.e. if
@@ -5168,8 +5171,9 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   __ and_(r4, r1, Operand(kStringRepresentationMask));
   STATIC_ASSERT(kSeqStringTag < kConsStringTag);
   STATIC_ASSERT(kConsStringTag < kExternalStringTag);
+  STATIC_ASSERT(kExternalStringTag < kSlicedStringTag);
   __ cmp(r4, Operand(kConsStringTag));
-  __ b(gt, &runtime);  // External strings go to runtime.
+  __ b(gt, &runtime);  // External and sliced strings go to runtime.
   __ b(lt, &seq_string);  // Sequential strings are handled directly.
 
   // Cons string. Try to recurse (once) on the first substring.
@@ -590,10 +590,14 @@ static void GenerateMonomorphicCacheProbe(MacroAssembler* masm,
   StubCompiler::GenerateLoadGlobalFunctionPrototype(
       masm, Context::BOOLEAN_FUNCTION_INDEX, r1);
 
-  // Probe the stub cache for the value object.
+  // Probe the stub cache for the value object. The probe with the
+  // receiver's own map has already counted a miss, so take it back to
+  // count the call once.
   __ bind(&probe);
-  Isolate::Current()->stub_cache()->GenerateProbe(
-      masm, flags, r1, r2, r3, r4, r5);
+  StubCache* stub_cache = Isolate::Current()->stub_cache();
+  __ DecrementCounter(stub_cache->miss_counter(StubCache::kCallCache), 1,
+                      r3, r4);
+  stub_cache->GenerateProbe(masm, flags, r1, r2, r3, r4, r5);
 
   __ bind(&miss);
 }
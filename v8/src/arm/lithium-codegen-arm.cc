@@ -3282,6 +3282,9 @@ void LCodeGen::DoStringCharCodeAt(LStringCharCodeAt* instr) {
   // Handle non-flat strings.
   __ tst(result, Operand(kIsConsStringMask));
   __ b(eq, deferred->entry());
+  // Sliced strings are read by the runtime system.
+  __ tst(result, Operand(kSlicedNotConsMask));
+  __ b(ne, deferred->entry());
 
   // ConsString.
   // Check whether the right hand side is the empty string (i.e. if
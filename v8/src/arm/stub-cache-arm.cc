@@ -47,8 +47,10 @@ static void ProbeTable(Isolate* isolate,
                        Register offset,
                        Register scratch,
                        Register scratch2) {
-  ExternalReference key_offset(isolate->stub_cache()->key_reference(table));
-  ExternalReference value_offset(isolate->stub_cache()->value_reference(table));
+  StubCache* stub_cache = isolate->stub_cache();
+  StubCache::CacheKind kind = StubCache::CacheKindForFlags(flags);
+  ExternalReference key_offset(stub_cache->key_reference(kind, table));
+  ExternalReference value_offset(stub_cache->value_reference(kind, table));
 
   uint32_t key_off_addr = reinterpret_cast<uint32_t>(key_offset.address());
   uint32_t value_off_addr = reinterpret_cast<uint32_t>(value_offset.address());
@@ -80,6 +82,8 @@ static void ProbeTable(Isolate* isolate,
 
   // Re-load code entry from cache.
   __ ldr(offset, MemOperand(offsets_base_addr, offset, LSL, 1));
+  __ IncrementCounter(stub_cache->hit_counter(kind, table), 1,
+                      scratch, scratch2);
 
   // Jump to the first instruction in the code stub.
   __ add(offset, offset, Operand(Code::kHeaderSize - kHeapObjectTag));
@@ -241,14 +245,19 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   __ tst(receiver, Operand(kSmiTagMask));
   __ b(eq, &miss);
 
+  // The table sizes are chosen at isolate creation, so the masks are
+  // loaded from the stub cache rather than embedded in the code.
+  ExternalReference primary_mask(mask_reference(kPrimary));
+  ExternalReference secondary_mask(mask_reference(kSecondary));
+
   // Get the map of the receiver and compute the hash.
   __ ldr(scratch, FieldMemOperand(name, String::kHashFieldOffset));
   __ ldr(ip, FieldMemOperand(receiver, HeapObject::kMapOffset));
   __ add(scratch, scratch, Operand(ip));
   __ eor(scratch, scratch, Operand(flags));
-  __ and_(scratch,
-          scratch,
-          Operand((kPrimaryTableSize - 1) << kHeapObjectTagSize));
+  __ mov(ip, Operand(primary_mask));
+  __ ldr(ip, MemOperand(ip));
+  __ and_(scratch, scratch, Operand(ip));
 
   // Probe the primary table.
   ProbeTable(isolate, masm, flags, kPrimary, name, scratch, extra, extra2);
@@ -256,9 +265,9 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Primary miss: Compute hash for secondary probe.
   __ sub(scratch, scratch, Operand(name));
   __ add(scratch, scratch, Operand(flags));
-  __ and_(scratch,
-          scratch,
-          Operand((kSecondaryTableSize - 1) << kHeapObjectTagSize));
+  __ mov(ip, Operand(secondary_mask));
+  __ ldr(ip, MemOperand(ip));
+  __ and_(scratch, scratch, Operand(ip));
 
   // Probe the secondary table.
   ProbeTable(isolate, masm, flags, kSecondary, name, scratch, extra, extra2);
@@ -266,6 +275,8 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Cache miss: Fall-through and let caller handle the miss by
   // entering the runtime system.
   __ bind(&miss);
+  __ IncrementCounter(miss_counter(CacheKindForFlags(flags)), 1,
+                      extra, extra2);
 }
 
 
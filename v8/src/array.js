@@ -1216,7 +1216,7 @@ function SetupArray() {
     "unshift", getFunction("unshift", ArrayUnshift, 1),
     "slice", getFunction("slice", ArraySlice, 2),
     "splice", getFunction("splice", ArraySplice, 2),
-    "sort", getFunction("sort", ArraySort),
+    "sort", getFunction("sort", ArraySort, 1),
     "filter", getFunction("filter", ArrayFilter, 1),
     "forEach", getFunction("forEach", ArrayForEach, 1),
     "some", getFunction("some", ArraySome, 1),
@@ -978,6 +978,190 @@ BUILTIN(ArrayConcat) {
 }
 
 
+// Compare two smi values as if they were converted to strings and then
+// compared lexicographically.  Same ordering as
+// Runtime_SmiLexicographicCompare, but without the digit buffers.
+static int SmiLexicographicCompare(int x_value, int y_value) {
+  if (x_value == y_value) return 0;
+
+  // If one of the integers is zero the normal integer order is the
+  // same as the lexicographic order of the string representations.
+  if (x_value == 0 || y_value == 0) return x_value < y_value ? -1 : 1;
+
+  // If only one of the integers is negative the negative number is
+  // smallest because the char code of '-' is less than the char code
+  // of any digit.  Otherwise, we compare the magnitudes, which are
+  // computed in 64 bits because -kMinInt does not fit in an int.
+  int64_t x_magnitude = x_value;
+  int64_t y_magnitude = y_value;
+  if (x_value < 0 || y_value < 0) {
+    if (y_value >= 0) return -1;
+    if (x_value >= 0) return 1;
+    x_magnitude = -x_magnitude;
+    y_magnitude = -y_magnitude;
+  }
+
+  // Pad the value with fewer digits with trailing zeros so both have the
+  // same number of digits; a plain integer comparison then gives the
+  // lexicographic order, except that a proper prefix sorts first.
+  int x_digits = 1;
+  for (int64_t v = x_magnitude; v >= 10; v /= 10) x_digits++;
+  int y_digits = 1;
+  for (int64_t v = y_magnitude; v >= 10; v /= 10) y_digits++;
+  int64_t x_scaled = x_magnitude;
+  int64_t y_scaled = y_magnitude;
+  for (int i = x_digits; i < y_digits; i++) x_scaled *= 10;
+  for (int i = y_digits; i < x_digits; i++) y_scaled *= 10;
+  if (x_scaled != y_scaled) return x_scaled < y_scaled ? -1 : 1;
+  return x_digits - y_digits;
+}
+
+
+static int CompareSmisLexicographically(Object* const* x, Object* const* y) {
+  return SmiLexicographicCompare(Smi::cast(*x)->value(),
+                                 Smi::cast(*y)->value());
+}
+
+
+template <typename lchar, typename rchar>
+static int CompareFlatStringChars(Vector<const lchar> x,
+                                  Vector<const rchar> y) {
+  int result = CompareChars(x.start(), y.start(), Min(x.length(), y.length()));
+  if (result != 0) return result;
+  return x.length() - y.length();
+}
+
+
+// Compares two flat strings by their UTF-16 code units, i.e. the order used
+// by the relational operators on strings.
+static int CompareFlatStrings(String* x, String* y) {
+  if (x == y) return 0;
+  if (x->IsAsciiRepresentation()) {
+    Vector<const char> x_chars = x->ToAsciiVector();
+    if (y->IsAsciiRepresentation()) {
+      return CompareFlatStringChars(Vector<const uint8_t>::cast(x_chars),
+                                    Vector<const uint8_t>::cast(
+                                        y->ToAsciiVector()));
+    }
+    return CompareFlatStringChars(Vector<const uint8_t>::cast(x_chars),
+                                  y->ToUC16Vector());
+  }
+  Vector<const uc16> x_chars = x->ToUC16Vector();
+  if (y->IsAsciiRepresentation()) {
+    return CompareFlatStringChars(x_chars,
+                                  Vector<const uint8_t>::cast(
+                                      y->ToAsciiVector()));
+  }
+  return CompareFlatStringChars(x_chars, y->ToUC16Vector());
+}
+
+
+// An element together with its string conversion, sorted by the key.
+struct DefaultSortEntry {
+  String* key;
+  Object* value;
+};
+
+
+static int CompareDefaultSortEntries(const DefaultSortEntry* x,
+                                     const DefaultSortEntry* y) {
+  return CompareFlatStrings(x->key, y->key);
+}
+
+
+// Sorts the first len elements of a packed fast-elements array holding only
+// smis, heap numbers and strings, using the default (string) ordering.
+// Returns NULL if the elements are not of that kind and the generic
+// JavaScript implementation has to be used.
+MUST_USE_RESULT static MaybeObject* SortWithDefaultComparator(
+    Isolate* isolate,
+    Handle<JSArray> array,
+    int len) {
+  Handle<FixedArray> elms(FixedArray::cast(array->elements()));
+  bool all_smis = true;
+  for (int i = 0; i < len; i++) {
+    Object* element = elms->get(i);
+    if (element->IsSmi()) continue;
+    all_smis = false;
+    if (!element->IsHeapNumber() && !element->IsString()) return NULL;
+  }
+
+  if (all_smis) {
+    // Smis can be ordered without materializing their strings, and
+    // storing them needs no write barrier.
+    AssertNoAllocation no_gc;
+    Vector<Object*>(elms->data_start(), len).Sort(
+        &CompareSmisLexicographically);
+    return *array;
+  }
+
+  // Convert every element to a flat string once, instead of once per
+  // comparison as the generic comparison function does.
+  Factory* factory = isolate->factory();
+  Handle<FixedArray> keys = factory->NewFixedArray(len);
+  for (int i = 0; i < len; i++) {
+    HandleScope scope(isolate);
+    Handle<Object> element(elms->get(i), isolate);
+    Handle<String> key = element->IsString()
+        ? FlattenGetString(Handle<String>::cast(element))
+        : factory->NumberToString(element);
+    keys->set(i, *key);
+  }
+
+  AssertNoAllocation no_gc;
+  ScopedVector<DefaultSortEntry> entries(len);
+  for (int i = 0; i < len; i++) {
+    entries[i].key = String::cast(keys->get(i));
+    entries[i].value = elms->get(i);
+  }
+  entries.Sort(&CompareDefaultSortEntries);
+  WriteBarrierMode mode = elms->GetWriteBarrierMode(no_gc);
+  for (int i = 0; i < len; i++) {
+    elms->set(i, entries[i].value, mode);
+  }
+  return *array;
+}
+
+
+BUILTIN(ArraySort) {
+  Heap* heap = isolate->heap();
+  Object* receiver = *args.receiver();
+  // A user supplied comparison function is called much more cheaply from
+  // the JavaScript implementation than through Execution::Call.
+  if (args.length() > 1 && args[1]->IsJSFunction()) {
+    return CallJsBuiltin(isolate, "ArraySort", args);
+  }
+  Object* elms_obj;
+  { MaybeObject* maybe_elms_obj =
+        EnsureJSArrayWithWritableFastElements(heap, receiver);
+    if (maybe_elms_obj == NULL) {
+      return CallJsBuiltin(isolate, "ArraySort", args);
+    }
+    if (!maybe_elms_obj->ToObject(&elms_obj)) return maybe_elms_obj;
+  }
+  FixedArray* elms = FixedArray::cast(elms_obj);
+  JSArray* array = JSArray::cast(receiver);
+
+  int len = Smi::cast(array->length())->value();
+  if (len < 2) return array;
+
+  // Holes and undefined values are moved to the end without consulting the
+  // comparison function; leave that to the JavaScript implementation.
+  for (int i = 0; i < len; i++) {
+    Object* element = elms->get(i);
+    if (element->IsTheHole() || element->IsUndefined()) {
+      return CallJsBuiltin(isolate, "ArraySort", args);
+    }
+  }
+
+  HandleScope scope(isolate);
+  MaybeObject* result =
+      SortWithDefaultComparator(isolate, Handle<JSArray>(array, isolate), len);
+  if (result == NULL) return CallJsBuiltin(isolate, "ArraySort", args);
+  return result;
+}
+
+
 // -----------------------------------------------------------------------------
 // Strict mode poison pills
 
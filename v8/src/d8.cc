@@ -31,6 +31,7 @@
 
 #include "v8.h"
 
+#include "../include/v8-profiler.h"
 #include "d8.h"
 #include "d8-debug.h"
 #include "debug.h"
@@ -44,6 +45,7 @@ namespace v8 {
 
 const char* Shell::kHistoryFileName = ".d8_history";
 const char* Shell::kPrompt = "d8> ";
+const char* Shell::kCpuProfileTitle = "d8";
 
 
 LineEditor *LineEditor::first_ = NULL;
@@ -90,6 +92,7 @@ i::SmartPointer<char> DumbLineEditor::Prompt(const char* prompt) {
 
 CounterMap* Shell::counter_map_;
 i::OS::MemoryMappedFile* Shell::counters_file_ = NULL;
+i::List<Worker*> Shell::workers_;
 CounterCollection Shell::local_counters_;
 CounterCollection* Shell::counters_ = &local_counters_;
 Persistent<Context> Shell::utility_context_;
@@ -437,6 +440,8 @@ void Shell::Initialize() {
   AddOSMethods(os_templ);
   global_template->Set(String::New("os"), os_templ);
 
+  AddWorkerFunctions(global_template);
+
   utility_context_ = Context::New(NULL, global_template);
   utility_context_->SetSecurityToken(Undefined());
   Context::Scope utility_scope(utility_context_);
@@ -505,10 +510,126 @@ void Shell::Initialize() {
     v8::Debug::SetDebugEventListener(HandleDebugEvent);
   }
 #endif
+
+#ifdef ENABLE_LOGGING_AND_PROFILING
+  // Start the CPU profiler if a collapsed stack profile was requested.
+  if (i::StrLength(i::FLAG_cpu_profile_collapsed) != 0) {
+    CpuProfiler::StartProfiling(String::New(kCpuProfileTitle));
+  }
+  if (i::StrLength(i::FLAG_allocation_profile_collapsed) != 0) {
+    HeapProfiler::StartAllocationSampling(i::FLAG_allocation_sample_interval);
+  }
+#endif
+}
+
+
+#ifdef ENABLE_LOGGING_AND_PROFILING
+static void AppendCollapsedName(const char* name, i::List<char>* stack) {
+  // Frames are separated by semicolons in the collapsed stack format.
+  for (; *name != '\0'; name++) stack->Add(*name == ';' ? ':' : *name);
+}
+
+
+static intptr_t SelfWeight(const CpuProfileNode* node) {
+  return static_cast<intptr_t>(node->GetSelfSamplesCount() + 0.5);
+}
+
+
+static intptr_t SelfWeight(const AllocationProfileNode* node) {
+  return node->GetSelfSize();
+}
+
+
+// Writes one "frame;frame;frame weight" line for every node of the
+// profile tree that has a self weight: samples for CPU profiles, bytes
+// for allocation profiles. This is the input format of flamegraph.pl and
+// most other flame graph tools.
+template <class Node>
+static void WriteCollapsedStacks(FILE* file,
+                                 const Node* node,
+                                 i::List<char>* stack) {
+  int length = stack->length();
+  if (length > 0) stack->Add(';');
+  String::Utf8Value name(node->GetFunctionName());
+  AppendCollapsedName(name.length() > 0 ? *name : "(anonymous function)",
+                      stack);
+  String::Utf8Value resource(node->GetScriptResourceName());
+  if (resource.length() > 0) {
+    i::EmbeddedVector<char, 16> line;
+    i::OS::SNPrintF(line, ":%d", node->GetLineNumber());
+    stack->Add(' ');
+    AppendCollapsedName(*resource, stack);
+    AppendCollapsedName(line.start(), stack);
+  }
+  intptr_t self_weight = SelfWeight(node);
+  if (self_weight > 0) {
+    fprintf(file, "%.*s %" V8_PTR_PREFIX "d\n",
+            stack->length(), &stack->first(), self_weight);
+  }
+  for (int i = 0; i < node->GetChildrenCount(); i++) {
+    WriteCollapsedStacks(file, node->GetChild(i), stack);
+  }
+  stack->Rewind(length);
+}
+#endif
+
+
+void Shell::WriteCpuProfile() {
+#ifdef ENABLE_LOGGING_AND_PROFILING
+  const char* file_name = i::FLAG_cpu_profile_collapsed;
+  if (i::StrLength(file_name) == 0) return;
+  Locker locker;
+  HandleScope scope;
+  const CpuProfile* profile =
+      CpuProfiler::StopProfiling(String::New(kCpuProfileTitle));
+  if (profile == NULL) return;
+  FILE* file = i::OS::FOpen(file_name, "w");
+  if (file == NULL) {
+    printf("Error writing '%s'\n", file_name);
+    return;
+  }
+  // The root node only groups the top level functions.
+  const CpuProfileNode* root = profile->GetTopDownRoot();
+  i::List<char> stack;
+  for (int i = 0; i < root->GetChildrenCount(); i++) {
+    WriteCollapsedStacks(file, root->GetChild(i), &stack);
+  }
+  fclose(file);
+#endif
+}
+
+
+void Shell::WriteAllocationProfile() {
+#ifdef ENABLE_LOGGING_AND_PROFILING
+  const char* file_name = i::FLAG_allocation_profile_collapsed;
+  if (i::StrLength(file_name) == 0) return;
+  Locker locker;
+  HandleScope scope;
+  AllocationProfile* profile = const_cast<AllocationProfile*>(
+      HeapProfiler::StopAllocationSampling());
+  if (profile == NULL) return;
+  FILE* file = i::OS::FOpen(file_name, "w");
+  if (file == NULL) {
+    printf("Error writing '%s'\n", file_name);
+    profile->Delete();
+    return;
+  }
+  // Allocations made while no JavaScript was running are left out
+  // together with the root node.
+  const AllocationProfileNode* root = profile->GetRoot();
+  i::List<char> stack;
+  for (int i = 0; i < root->GetChildrenCount(); i++) {
+    WriteCollapsedStacks(file, root->GetChild(i), &stack);
+  }
+  fclose(file);
+  profile->Delete();
+#endif
 }
 
 
 void Shell::OnExit() {
+  WriteCpuProfile();
+  WriteAllocationProfile();
   if (i::FLAG_dump_counters) {
     ::printf("+----------------------------------------+-------------+\n");
     ::printf("| Name                                   | Value       |\n");
@@ -678,6 +799,253 @@ void ShellThread::Run() {
 }
 
 
+MessageQueue::MessageQueue()
+    : mutex_(i::OS::CreateMutex()),
+      available_(i::OS::CreateSemaphore(0)),
+      head_(0),
+      closed_(false) { }
+
+
+MessageQueue::~MessageQueue() {
+  for (int i = head_; i < messages_.length(); i++) messages_[i].Dispose();
+  delete available_;
+  delete mutex_;
+}
+
+
+void MessageQueue::Enqueue(i::Vector<char> message) {
+  {
+    i::ScopedLock lock(mutex_);
+    if (closed_) {
+      // Nobody is going to read the message.
+      message.Dispose();
+      return;
+    }
+    messages_.Add(message);
+  }
+  available_->Signal();
+}
+
+
+bool MessageQueue::Dequeue(i::Vector<char>* message) {
+  available_->Wait();
+  i::ScopedLock lock(mutex_);
+  if (head_ == messages_.length()) {
+    // The queue has been closed.  Pass the wake-up on to the next reader.
+    ASSERT(closed_);
+    available_->Signal();
+    return false;
+  }
+  *message = messages_[head_++];
+  if (head_ == messages_.length()) {
+    messages_.Rewind(0);
+    head_ = 0;
+  }
+  return true;
+}
+
+
+void MessageQueue::Close() {
+  i::ScopedLock lock(mutex_);
+  if (closed_) return;
+  closed_ = true;
+  available_->Signal();
+}
+
+
+static i::Thread::Options GetWorkerThreadOptions() {
+  i::Thread::Options options;
+  options.name = "d8:WorkerThread";
+  // Leave room for the stack limit and the deep recursion of big scripts.
+  options.stack_size = 2 * i::MB;
+  return options;
+}
+
+
+Worker::WorkerThread::WorkerThread(Worker* worker)
+    : i::Thread(NULL, GetWorkerThreadOptions()), worker_(worker) { }
+
+
+Worker::Worker(i::Vector<const char> source)
+    : source_(i::Vector<char>::New(source.length())),
+      thread_(NULL) {
+  memcpy(source_.start(), source.start(), source.length());
+}
+
+
+Worker::~Worker() {
+  ASSERT(thread_ == NULL);
+  source_.Dispose();
+}
+
+
+void Worker::Start() {
+  ASSERT(thread_ == NULL);
+  thread_ = new WorkerThread(this);
+  thread_->Start();
+}
+
+
+void Worker::WaitForThread() {
+  Terminate();
+  if (thread_ == NULL) return;
+  thread_->Join();
+  delete thread_;
+  thread_ = NULL;
+}
+
+
+void Worker::ExecuteInThread() {
+  Isolate* isolate = Isolate::New();
+  {
+    // Lock and enter the worker's own isolate; this never waits for the
+    // shell or for other workers.
+    Locker locker(isolate);
+    HandleScope scope;
+    Handle<ObjectTemplate> global_template =
+        Shell::CreateWorkerGlobalTemplate();
+    global_template->Set(String::New("postMessage"),
+                         FunctionTemplate::New(PostMessageToShell,
+                                               External::New(this)));
+    Persistent<Context> context = Context::New(NULL, global_template);
+    {
+      Context::Scope context_scope(context);
+      Handle<String> source = String::New(source_.start(), source_.length());
+      if (Shell::ExecuteString(source, String::New("worker"), false, true)) {
+        Handle<Value> onmessage =
+            context->Global()->Get(String::New("onmessage"));
+        i::Vector<char> message;
+        while (onmessage->IsFunction() && in_queue_.Dequeue(&message)) {
+          HandleScope message_scope;
+          Handle<Value> argv[] = {
+            String::New(message.start(), message.length())
+          };
+          message.Dispose();
+          TryCatch try_catch;
+          Handle<Function>::Cast(onmessage)->Call(context->Global(), 1, argv);
+          if (try_catch.HasCaught()) Shell::ReportException(&try_catch);
+        }
+      }
+    }
+    context.Dispose();
+  }
+  out_queue_.Close();
+  isolate->Dispose();
+}
+
+
+Handle<Value> Worker::PostMessageToShell(const Arguments& args) {
+  Worker* worker = static_cast<Worker*>(External::Unwrap(args.Data()));
+  String::Utf8Value message(args[0]);
+  if (*message == NULL) {
+    return ThrowException(String::New("Error converting message"));
+  }
+  i::Vector<char> copy = i::Vector<char>::New(message.length());
+  memcpy(copy.start(), *message, message.length());
+  worker->out_queue_.Enqueue(copy);
+  return Undefined();
+}
+
+
+static Worker* GetWorker(const Arguments& args) {
+  if (args.This()->InternalFieldCount() < 1) return NULL;
+  return static_cast<Worker*>(args.This()->GetPointerFromInternalField(0));
+}
+
+
+Handle<Value> Shell::WorkerNew(const Arguments& args) {
+  if (!args.IsConstructCall()) {
+    return ThrowException(String::New("Worker must be called with new"));
+  }
+  String::Utf8Value source(args[0]);
+  if (args.Length() < 1 || *source == NULL) {
+    return ThrowException(String::New("Worker needs a source string"));
+  }
+  Worker* worker =
+      new Worker(i::Vector<const char>(*source, source.length()));
+  args.This()->SetPointerInInternalField(0, worker);
+  workers_.Add(worker);
+  worker->Start();
+  return Undefined();
+}
+
+
+Handle<Value> Shell::WorkerPostMessage(const Arguments& args) {
+  Worker* worker = GetWorker(args);
+  if (worker == NULL) return ThrowException(String::New("Not a worker"));
+  String::Utf8Value message(args[0]);
+  if (*message == NULL) {
+    return ThrowException(String::New("Error converting message"));
+  }
+  i::Vector<char> copy = i::Vector<char>::New(message.length());
+  memcpy(copy.start(), *message, message.length());
+  worker->PostMessage(copy);
+  return Undefined();
+}
+
+
+Handle<Value> Shell::WorkerGetMessage(const Arguments& args) {
+  Worker* worker = GetWorker(args);
+  if (worker == NULL) return ThrowException(String::New("Not a worker"));
+  i::Vector<char> message;
+  bool has_message;
+  {
+    // Let other shell threads run while waiting for the worker.
+    Unlocker unlocker;
+    has_message = worker->GetMessage(&message);
+  }
+  if (!has_message) return Undefined();
+  Handle<String> result = String::New(message.start(), message.length());
+  message.Dispose();
+  return result;
+}
+
+
+Handle<Value> Shell::WorkerTerminate(const Arguments& args) {
+  Worker* worker = GetWorker(args);
+  if (worker == NULL) return ThrowException(String::New("Not a worker"));
+  worker->Terminate();
+  return Undefined();
+}
+
+
+void Shell::AddWorkerFunctions(Handle<ObjectTemplate> global_template) {
+  Handle<FunctionTemplate> worker_template = FunctionTemplate::New(WorkerNew);
+  worker_template->SetClassName(String::New("Worker"));
+  worker_template->InstanceTemplate()->SetInternalFieldCount(1);
+  Handle<ObjectTemplate> proto = worker_template->PrototypeTemplate();
+  proto->Set(String::New("postMessage"),
+             FunctionTemplate::New(WorkerPostMessage));
+  proto->Set(String::New("getMessage"),
+             FunctionTemplate::New(WorkerGetMessage));
+  proto->Set(String::New("terminate"),
+             FunctionTemplate::New(WorkerTerminate));
+  global_template->Set(String::New("Worker"), worker_template);
+}
+
+
+// Workers get the shell functions that do not touch shell state.
+Handle<ObjectTemplate> Shell::CreateWorkerGlobalTemplate() {
+  Handle<ObjectTemplate> global_template = ObjectTemplate::New();
+  global_template->Set(String::New("print"), FunctionTemplate::New(Print));
+  global_template->Set(String::New("write"), FunctionTemplate::New(Write));
+  global_template->Set(String::New("read"), FunctionTemplate::New(Read));
+  global_template->Set(String::New("load"), FunctionTemplate::New(Load));
+  global_template->Set(String::New("version"), FunctionTemplate::New(Version));
+  return global_template;
+}
+
+
+void Shell::CleanupWorkers() {
+  for (int i = 0; i < workers_.length(); i++) {
+    Worker* worker = workers_[i];
+    worker->WaitForThread();
+    delete worker;
+  }
+  workers_.Clear();
+}
+
+
 int Shell::Main(int argc, char* argv[]) {
   i::FlagList::SetFlagsFromCommandLine(&argc, argv, true);
   if (i::FLAG_help) {
@@ -783,7 +1151,11 @@ int Shell::Main(int argc, char* argv[]) {
     thread->Join();
     delete thread;
   }
+  CleanupWorkers();
   OnExit();
+  // Tear down V8 once the workers' isolates are gone. This also prints
+  // statistics collected until exit, such as those of --hydrogen-stats.
+  V8::Dispose();
   return 0;
 }
 
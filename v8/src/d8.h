@@ -111,6 +111,65 @@ class CounterMap {
 };
 
 
+// A queue of messages passed between the shell and a worker.  Messages are
+// copied UTF-8 strings, so no V8 object is ever shared between isolates.
+class MessageQueue {
+ public:
+  MessageQueue();
+  ~MessageQueue();
+  // Adds a message to the queue, which takes ownership of it.  Messages
+  // added after the queue has been closed are dropped.
+  void Enqueue(i::Vector<char> message);
+  // Waits for the next message.  Returns false once the queue has been
+  // closed and all messages have been taken.
+  bool Dequeue(i::Vector<char>* message);
+  // Wakes up all waiting readers once the queued messages have been taken.
+  void Close();
+ private:
+  i::Mutex* mutex_;
+  i::Semaphore* available_;
+  i::List<i::Vector<char> > messages_;
+  int head_;
+  bool closed_;
+};
+
+
+// A worker runs a script in an isolate of its own, pinned to a thread of its
+// own, so workers run in parallel with the shell and with each other.  The
+// shell posts messages to the worker's onmessage function; the worker posts
+// messages back with postMessage.
+class Worker {
+ public:
+  explicit Worker(i::Vector<const char> source);
+  ~Worker();
+  void Start();
+  void PostMessage(i::Vector<char> message) { in_queue_.Enqueue(message); }
+  bool GetMessage(i::Vector<char>* message) {
+    return out_queue_.Dequeue(message);
+  }
+  // Lets the worker finish once it has handled the messages posted so far.
+  void Terminate() { in_queue_.Close(); }
+  void WaitForThread();
+
+ private:
+  class WorkerThread : public i::Thread {
+   public:
+    explicit WorkerThread(Worker* worker);
+    virtual void Run() { worker_->ExecuteInThread(); }
+   private:
+    Worker* worker_;
+  };
+
+  void ExecuteInThread();
+  static Handle<Value> PostMessageToShell(const Arguments& args);
+
+  i::Vector<char> source_;
+  MessageQueue in_queue_;
+  MessageQueue out_queue_;
+  WorkerThread* thread_;
+};
+
+
 class Shell: public i::AllStatic {
  public:
   static bool ExecuteString(Handle<String> source,
@@ -121,6 +180,8 @@ class Shell: public i::AllStatic {
   static void ReportException(TryCatch* try_catch);
   static void Initialize();
   static void OnExit();
+  static void WriteCpuProfile();
+  static void WriteAllocationProfile();
   static int* LookupCounter(const char* name);
   static void* CreateHistogram(const char* name,
                                int min,
@@ -187,10 +248,30 @@ class Shell: public i::AllStatic {
 
   static void AddOSMethods(Handle<ObjectTemplate> os_template);
 
+  // new Worker(source) starts a worker running the given script.
+  //
+  // worker.postMessage(message) converts the message to a string and
+  // passes it to the onmessage function of the worker.
+  //
+  // worker.getMessage() waits for the next message the worker passes to
+  // postMessage and returns it as a string, or returns undefined if the
+  // worker has finished.
+  //
+  // worker.terminate() lets the worker finish once it has handled the
+  // messages posted so far.
+  static Handle<Value> WorkerNew(const Arguments& args);
+  static Handle<Value> WorkerPostMessage(const Arguments& args);
+  static Handle<Value> WorkerGetMessage(const Arguments& args);
+  static Handle<Value> WorkerTerminate(const Arguments& args);
+  static void AddWorkerFunctions(Handle<ObjectTemplate> global_template);
+  static Handle<ObjectTemplate> CreateWorkerGlobalTemplate();
+  static void CleanupWorkers();
+
   static Handle<Context> utility_context() { return utility_context_; }
 
   static const char* kHistoryFileName;
   static const char* kPrompt;
+  static const char* kCpuProfileTitle;
  private:
   static Persistent<Context> utility_context_;
   static Persistent<Context> evaluation_context_;
@@ -200,6 +281,7 @@ class Shell: public i::AllStatic {
   static CounterCollection local_counters_;
   static CounterCollection* counters_;
   static i::OS::MemoryMappedFile* counters_file_;
+  static i::List<Worker*> workers_;
   static Counter* GetCounter(const char* name, bool is_histogram);
 };
 
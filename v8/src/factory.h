@@ -64,6 +64,7 @@ class Factory {
   Handle<String> LookupSymbol(Vector<const char> str);
   Handle<String> LookupAsciiSymbol(Vector<const char> str);
   Handle<String> LookupTwoByteSymbol(Vector<const uc16> str);
+  Handle<String> LookupSymbol(Handle<String> str);
   Handle<String> LookupAsciiSymbol(const char* str) {
     return LookupSymbol(CStrVector(str));
   }
@@ -113,8 +113,16 @@ DEFINE_bool(use_gvn, true, "use hydrogen global value numbering")
 DEFINE_bool(use_canonicalizing, true, "use hydrogen instruction canonicalizing")
 DEFINE_bool(use_inlining, true, "use function inlining")
 DEFINE_bool(limit_inlining, true, "limit code size growth from inlining")
+DEFINE_int(max_inlined_source_size, 600,
+           "maximum source size in bytes considered for a single inlining")
+DEFINE_int(max_inlined_nodes, 196,
+           "maximum number of AST nodes considered for a single inlining")
+DEFINE_int(max_inlined_nodes_cumulative, 196,
+           "maximum cumulative number of AST nodes considered for inlining")
 DEFINE_bool(eliminate_empty_blocks, true, "eliminate empty blocks")
 DEFINE_bool(loop_invariant_code_motion, true, "loop invariant code motion")
+DEFINE_bool(array_bounds_checks_elimination, true,
+            "eliminate redundant array bounds checks")
 DEFINE_bool(hydrogen_stats, false, "print statistics for hydrogen")
 DEFINE_bool(trace_hydrogen, false, "trace generated hydrogen to file")
 DEFINE_bool(trace_inlining, false, "trace inlining decisions")
@@ -122,6 +130,7 @@ DEFINE_bool(trace_alloc, false, "trace register allocator")
 DEFINE_bool(trace_all_uses, false, "trace all use positions")
 DEFINE_bool(trace_range, false, "trace range analysis")
 DEFINE_bool(trace_gvn, false, "trace global value numbering")
+DEFINE_bool(trace_bce, false, "trace array bounds check elimination")
 DEFINE_bool(trace_representation, false, "trace representation types")
 DEFINE_bool(stress_pointer_maps, false, "pointer map for every instruction")
 DEFINE_bool(stress_environments, false, "environment for every instruction")
@@ -132,6 +141,8 @@ DEFINE_bool(process_arguments_object, true, "try to deal with arguments object")
 DEFINE_bool(trap_on_deopt, false, "put a break point before deoptimizing")
 DEFINE_bool(deoptimize_uncommon_cases, true, "deoptimize uncommon cases")
 DEFINE_bool(polymorphic_inlining, true, "polymorphic inlining")
+DEFINE_int(max_call_polymorphism, 4,
+           "maximum number of receiver maps dispatched on at a call site")
 DEFINE_bool(aggressive_loop_invariant_motion, true,
             "aggressive motion of instructions out of loops")
 DEFINE_bool(use_osr, true, "use on-stack replacement")
@@ -264,6 +275,8 @@ DEFINE_bool(collect_maps, true,
             "garbage collect maps from which no objects can be reached")
 DEFINE_bool(flush_code, true,
             "flush code that we expect not to use again before full gc")
+DEFINE_bool(string_slices, true,
+            "share the characters of long substrings with their parent")
 
 // v8.cc
 DEFINE_bool(use_idle_notification, true,
@@ -307,6 +320,8 @@ DEFINE_int(max_map_space_pages, MapSpace::kMaxMapPageIndex - 1,
 // mksnapshot.cc
 DEFINE_bool(h, false, "print this message")
 DEFINE_bool(new_snapshot, true, "use new snapshot implementation")
+DEFINE_string(extra_code, NULL, "A filename with extra code to be included in"
+                  " the context snapshot (mksnapshot only)")
 
 // objects.cc
 DEFINE_bool(use_verbose_printer, true, "allows verbose printing")
@@ -315,9 +330,19 @@ DEFINE_bool(use_verbose_printer, true, "allows verbose printing")
 DEFINE_bool(allow_natives_syntax, false, "allow natives syntax")
 DEFINE_bool(strict_mode, true, "allow strict mode directives")
 
+// profile-generator.cc
+DEFINE_int(heap_snapshot_stream_window, 1024 * 1024,
+           "maximum number of references buffered per heap traversal "
+           "when streaming a heap snapshot")
+
 // rewriter.cc
 DEFINE_bool(optimize_ast, true, "optimize the ast")
 
+// runtime.cc
+DEFINE_bool(lazy_rope_flattening, true,
+            "read single characters of a cons string without flattening it "
+            "until it is read repeatedly")
+
 // simulator-arm.cc and simulator-mips.cc
 DEFINE_bool(trace_sim, false, "Trace simulator execution")
 DEFINE_bool(check_icache, false, "Check icache flushes in ARM simulator")
@@ -325,6 +350,14 @@ DEFINE_int(stop_sim_at, 0, "Simulator stop after x number of instructions")
 DEFINE_int(sim_stack_alignment, 8,
            "Stack alingment in bytes in simulator (4 or 8, 8 is default)")
 
+// stub-cache.cc
+DEFINE_int(stub_cache_primary_size, 2048,
+           "number of entries in each primary megamorphic stub cache table "
+           "(rounded up to a power of two)")
+DEFINE_int(stub_cache_secondary_size, 512,
+           "number of entries in each secondary megamorphic stub cache table "
+           "(rounded up to a power of two)")
+
 // top.cc
 DEFINE_bool(trace_exception, false,
             "print stack trace when throwing exceptions")
@@ -335,6 +368,12 @@ DEFINE_bool(preallocate_message_memory, false,
 DEFINE_bool(preemption, false,
             "activate a 100ms timer that switches between V8 threads")
 
+// zone.cc
+DEFINE_bool(zone_segment_pool, true,
+            "recycle zone segments between compilations")
+DEFINE_bool(trace_zone_stats, false,
+            "print zone allocation statistics on exit")
+
 // Regexp
 DEFINE_bool(trace_regexps, false, "trace regexp execution")
 DEFINE_bool(regexp_optimization, true, "generate optimized regexp code")
@@ -366,6 +405,14 @@ DEFINE_bool(remote_debugger, false, "Connect JavaScript debugger to the "
 DEFINE_bool(debugger_agent, false, "Enable debugger agent")
 DEFINE_int(debugger_port, 5858, "Port to use for remote debugging")
 DEFINE_string(map_counters, "", "Map counters to a file")
+DEFINE_string(cpu_profile_collapsed, "",
+              "Profile the shell and write collapsed stacks to a file")
+DEFINE_string(allocation_profile_collapsed, "",
+              "Sample heap allocations of the shell and write collapsed "
+              "stacks weighted by bytes to a file (add --noinline-new to "
+              "also see objects allocated by generated code)")
+DEFINE_int(allocation_sample_interval, 512 * 1024,
+           "Bytes allocated between two heap allocation samples")
 DEFINE_args(js_arguments, JSArguments(),
             "Pass all remaining arguments to the script. Alias for \"--\".")
 
@@ -504,6 +551,15 @@ DEFINE_bool(prof_lazy, false,
             " when profiler is active (implies --noprof_auto).")
 DEFINE_bool(prof_browser_mode, true,
             "Used with --prof, turns on browser-compatible mode for profiling.")
+#if defined(ANDROID)
+// Phones and tablets have processors that are much slower than desktop
+// and laptop computers for which current heuristics are tuned.
+DEFINE_int(prof_sampling_interval, 5,
+           "Interval between profiler ticks (in milliseconds).")
+#else
+DEFINE_int(prof_sampling_interval, 1,
+           "Interval between profiler ticks (in milliseconds).")
+#endif
 DEFINE_bool(log_regexp, false, "Log regular expression execution.")
 DEFINE_bool(sliding_state_window, false,
             "Update sliding state window counters.")
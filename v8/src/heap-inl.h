@@ -164,6 +164,7 @@ MaybeObject* Heap::AllocateRaw(int size_in_bytes,
     if (always_allocate() && result->IsFailure()) {
       space = retry_space;
     } else {
+      CountAllocationForSampling(result, size_in_bytes);
       return result;
     }
   }
@@ -183,10 +184,21 @@ MaybeObject* Heap::AllocateRaw(int size_in_bytes,
     result = map_space_->AllocateRaw(size_in_bytes);
   }
   if (result->IsFailure()) old_gen_exhausted_ = true;
+  CountAllocationForSampling(result, size_in_bytes);
   return result;
 }
 
 
+void Heap::CountAllocationForSampling(MaybeObject* result,
+                                      int size_in_bytes) {
+#ifdef ENABLE_LOGGING_AND_PROFILING
+  if (allocation_sample_interval_ == 0 || result->IsFailure()) return;
+  allocation_sample_countdown_ -= size_in_bytes;
+  if (allocation_sample_countdown_ <= 0) SampleAllocation();
+#endif
+}
+
+
 MaybeObject* Heap::NumberFromInt32(int32_t value) {
   if (Smi::IsValid(value)) return Smi::FromInt(value);
   // Bypass NumberFromDouble to avoid various redundant checks.
@@ -317,10 +329,10 @@ AllocationSpace Heap::TargetSpaceId(InstanceType type) {
   ASSERT(type != JS_GLOBAL_PROPERTY_CELL_TYPE);
 
   if (type < FIRST_NONSTRING_TYPE) {
-    // There are three string representations: sequential strings, cons
-    // strings, and external strings.  Only cons strings contain
-    // non-map-word pointers to heap objects.
-    return ((type & kStringRepresentationMask) == kConsStringTag)
+    // There are four string representations: sequential strings, cons
+    // strings, sliced strings and external strings.  Only cons and sliced
+    // strings contain non-map-word pointers to heap objects.
+    return ((type & kIsConsStringMask) != 0)
         ? OLD_POINTER_SPACE
         : OLD_DATA_SPACE;
   } else {
@@ -318,12 +318,14 @@ void RetainerTreeAggregator::Call(const JSObjectsCluster& cluster,
 
 HeapProfiler::HeapProfiler()
     : snapshots_(new HeapSnapshotsCollection()),
-      next_snapshot_uid_(1) {
+      next_snapshot_uid_(1),
+      allocation_profile_(NULL) {
 }
 
 
 HeapProfiler::~HeapProfiler() {
   delete snapshots_;
+  delete allocation_profile_;
 }
 
 
@@ -376,6 +378,16 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(String* name,
 }
 
 
+bool HeapProfiler::StreamSnapshot(String* name,
+                                  v8::OutputStream* stream,
+                                  v8::ActivityControl* control) {
+  ASSERT(Isolate::Current()->heap_profiler() != NULL);
+  return Isolate::Current()->heap_profiler()->StreamSnapshotImpl(name,
+                                                                 stream,
+                                                                 control);
+}
+
+
 void HeapProfiler::DefineWrapperClass(
     uint16_t class_id, v8::HeapProfiler::WrapperInfoCallback callback) {
   ASSERT(class_id != v8::HeapProfiler::kPersistentHandleNoClassId);
@@ -436,6 +448,26 @@ HeapSnapshot* HeapProfiler::TakeSnapshotImpl(String* name,
 }
 
 
+bool HeapProfiler::StreamSnapshotImpl(String* name,
+                                      v8::OutputStream* stream,
+                                      v8::ActivityControl* control) {
+  // The snapshot only holds the nodes while they are written out and is
+  // not added to the list of taken snapshots.
+  HeapSnapshot* snapshot = snapshots_->NewSnapshot(
+      HeapSnapshot::kFull, snapshots_->names()->GetName(name),
+      next_snapshot_uid_++);
+  HEAP->CollectAllGarbage(true);
+  bool generation_completed;
+  {
+    HeapSnapshotGenerator generator(snapshot, control);
+    generation_completed = generator.StreamSnapshot(stream);
+  }
+  snapshots_->SnapshotGenerationFinished(NULL);
+  delete snapshot;
+  return generation_completed;
+}
+
+
 int HeapProfiler::GetSnapshotsCount() {
   HeapProfiler* profiler = Isolate::Current()->heap_profiler();
   ASSERT(profiler != NULL);
@@ -464,11 +496,39 @@ void HeapProfiler::DeleteAllSnapshots() {
 }
 
 
+void HeapProfiler::StartAllocationSampling(int sample_interval) {
+  ASSERT(sample_interval > 0);
+  Isolate* isolate = Isolate::Current();
+  HeapProfiler* profiler = isolate->heap_profiler();
+  ASSERT(profiler != NULL);
+  if (profiler->allocation_profile_ != NULL) return;
+  profiler->allocation_profile_ = new AllocationProfile(sample_interval);
+  isolate->heap()->SetAllocationSampleInterval(sample_interval);
+}
+
+
+AllocationProfile* HeapProfiler::StopAllocationSampling() {
+  Isolate* isolate = Isolate::Current();
+  HeapProfiler* profiler = isolate->heap_profiler();
+  ASSERT(profiler != NULL);
+  isolate->heap()->SetAllocationSampleInterval(0);
+  AllocationProfile* profile = profiler->allocation_profile_;
+  profiler->allocation_profile_ = NULL;
+  return profile;
+}
+
+
 void HeapProfiler::ObjectMoveEvent(Address from, Address to) {
   snapshots_->ObjectMoveEvent(from, to);
 }
 
 
+void HeapProfiler::SampleAllocation(intptr_t size) {
+  ASSERT(allocation_profile_ != NULL);
+  allocation_profile_->RecordSample(Isolate::Current(), size);
+}
+
+
 const JSObjectsClusterTreeConfig::Key JSObjectsClusterTreeConfig::kNoKey;
 const JSObjectsClusterTreeConfig::Value JSObjectsClusterTreeConfig::kNoValue;
 
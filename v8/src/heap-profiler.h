@@ -36,6 +36,7 @@ namespace internal {
 
 #ifdef ENABLE_LOGGING_AND_PROFILING
 
+class AllocationProfile;
 class HeapSnapshot;
 class HeapSnapshotsCollection;
 
@@ -64,12 +65,20 @@ class HeapProfiler {
   static HeapSnapshot* TakeSnapshot(String* name,
                                     int type,
                                     v8::ActivityControl* control);
+  static bool StreamSnapshot(String* name,
+                             v8::OutputStream* stream,
+                             v8::ActivityControl* control);
   static int GetSnapshotsCount();
   static HeapSnapshot* GetSnapshot(int index);
   static HeapSnapshot* FindSnapshot(unsigned uid);
   static void DeleteAllSnapshots();
 
+  // Allocation sampling. The returned profile is owned by the caller.
+  static void StartAllocationSampling(int sample_interval);
+  static AllocationProfile* StopAllocationSampling();
+
   void ObjectMoveEvent(Address from, Address to);
+  void SampleAllocation(intptr_t size);
 
   void DefineWrapperClass(
       uint16_t class_id, v8::HeapProfiler::WrapperInfoCallback callback);
@@ -93,10 +102,14 @@ class HeapProfiler {
   HeapSnapshot* TakeSnapshotImpl(String* name,
                                  int type,
                                  v8::ActivityControl* control);
+  bool StreamSnapshotImpl(String* name,
+                          v8::OutputStream* stream,
+                          v8::ActivityControl* control);
   void ResetSnapshots();
 
   HeapSnapshotsCollection* snapshots_;
   unsigned next_snapshot_uid_;
+  AllocationProfile* allocation_profile_;
   List<v8::HeapProfiler::WrapperInfoCallback> wrapper_callbacks_;
 
 #endif  // ENABLE_LOGGING_AND_PROFILING
@@ -97,6 +97,8 @@ Heap::Heap()
 // generation can be aligned to its size.
       survived_since_last_expansion_(0),
       always_allocate_scope_depth_(0),
+      allocation_sample_interval_(0),
+      allocation_sample_countdown_(0),
       linear_allocation_scope_depth_(0),
       contexts_disposed_(0),
       new_space_(this),
@@ -383,6 +385,7 @@ void Heap::ReportStatisticsAfterGC() {
 void Heap::GarbageCollectionPrologue() {
   isolate_->transcendental_cache()->Clear();
   ClearJSFunctionResultCaches();
+  FlushRegExpResultsCache();
   gc_count_++;
   unflattened_strings_length_ = 0;
 #ifdef DEBUG
@@ -1278,6 +1281,10 @@ class ScavengingVisitor : public StaticVisitorBase {
                     &ObjectEvacuationStrategy<POINTER_OBJECT>::
                         template VisitSpecialized<ConsString::kSize>);
 
+    table_.Register(kVisitSlicedString,
+                    &ObjectEvacuationStrategy<POINTER_OBJECT>::
+                        template VisitSpecialized<SlicedString::kSize>);
+
     table_.Register(kVisitSharedFunctionInfo,
                     &ObjectEvacuationStrategy<POINTER_OBJECT>::
                         template VisitSpecialized<SharedFunctionInfo::kSize>);
@@ -2148,6 +2155,13 @@ bool Heap::CreateInitialObjects() {
   }
   set_single_character_string_cache(FixedArray::cast(obj));
 
+  // Allocate cache for the matches of global regexps.
+  { MaybeObject* maybe_obj =
+        AllocateFixedArray(kRegExpResultsCacheSize * 3, TENURED);
+    if (!maybe_obj->ToObject(&obj)) return false;
+  }
+  set_regexp_results_cache(FixedArray::cast(obj));
+
   // Allocate cache for external strings pointing to native source code.
   { MaybeObject* maybe_obj = AllocateFixedArray(Natives::GetBuiltinsCount());
     if (!maybe_obj->ToObject(&obj)) return false;
@@ -2241,6 +2255,48 @@ void Heap::SetNumberStringCache(Object* number, String* string) {
 }
 
 
+void Heap::FlushRegExpResultsCache() {
+  // Drop the cached matches at every GC, so that they do not keep subject
+  // strings alive and the keys never move while they are in the cache.
+  int len = regexp_results_cache()->length();
+  for (int i = 0; i < len; i++) {
+    regexp_results_cache()->set_undefined(this, i);
+  }
+}
+
+
+static inline int RegExpResultsCacheIndex(String* subject,
+                                          FixedArray* regexp_data) {
+  // Hashing the addresses avoids computing the hash of long subjects.
+  uintptr_t hash = reinterpret_cast<uintptr_t>(subject) ^
+      (reinterpret_cast<uintptr_t>(regexp_data) >> kObjectAlignmentBits);
+  hash >>= kObjectAlignmentBits;
+  return static_cast<int>(hash & (Heap::kRegExpResultsCacheSize - 1)) * 3;
+}
+
+
+Object* Heap::GetRegExpResultsCache(String* subject,
+                                    FixedArray* regexp_data) {
+  FixedArray* cache = regexp_results_cache();
+  int index = RegExpResultsCacheIndex(subject, regexp_data);
+  if (cache->get(index) == subject && cache->get(index + 1) == regexp_data) {
+    return cache->get(index + 2);
+  }
+  return undefined_value();
+}
+
+
+void Heap::SetRegExpResultsCache(String* subject,
+                                 FixedArray* regexp_data,
+                                 Object* matches) {
+  FixedArray* cache = regexp_results_cache();
+  int index = RegExpResultsCacheIndex(subject, regexp_data);
+  cache->set(index, subject);
+  cache->set(index + 1, regexp_data);
+  cache->set(index + 2, matches);
+}
+
+
 MaybeObject* Heap::NumberToString(Object* number,
                                   bool check_number_string_cache) {
   isolate_->counters()->number_to_string_runtime()->Increment();
@@ -2579,6 +2635,12 @@ MaybeObject* Heap::AllocateSubString(String* buffer,
   // Make an attempt to flatten the buffer to reduce access time.
   buffer = buffer->TryFlattenGetString();
 
+  if (FLAG_string_slices &&
+      length >= SlicedString::kMinLength &&
+      buffer->IsFlat()) {
+    return AllocateSlicedString(buffer, start, length, pretenure);
+  }
+
   Object* result;
   { MaybeObject* maybe_result = buffer->IsAsciiRepresentation()
                    ? AllocateRawAsciiString(length, pretenure )
@@ -2601,6 +2663,43 @@ MaybeObject* Heap::AllocateSubString(String* buffer,
 }
 
 
+MaybeObject* Heap::AllocateSlicedString(String* buffer,
+                                        int start,
+                                        int length,
+                                        PretenureFlag pretenure) {
+  ASSERT(buffer->IsFlat());
+  // Point at the underlying flat string so that there is never more than
+  // one level of indirection.
+  if (buffer->IsConsString()) {
+    buffer = ConsString::cast(buffer)->first();
+  } else if (buffer->IsSlicedString()) {
+    SlicedString* slice = SlicedString::cast(buffer);
+    start += slice->offset();
+    buffer = slice->parent();
+  }
+  ASSERT(buffer->IsSeqString() || buffer->IsExternalString());
+
+  Map* map = buffer->IsAsciiRepresentation()
+      ? sliced_ascii_string_map()
+      : sliced_string_map();
+  AllocationSpace space = (pretenure == TENURED) ? OLD_POINTER_SPACE
+                                                 : NEW_SPACE;
+  Object* result;
+  { MaybeObject* maybe_result = Allocate(map, space);
+    if (!maybe_result->ToObject(&result)) return maybe_result;
+  }
+
+  AssertNoAllocation no_gc;
+  SlicedString* slice = SlicedString::cast(result);
+  WriteBarrierMode mode = slice->GetWriteBarrierMode(no_gc);
+  slice->set_length(length);
+  slice->set_hash_field(String::kEmptyHashField);
+  slice->set_parent(buffer, mode);
+  slice->set_offset(start);
+  return result;
+}
+
+
 MaybeObject* Heap::AllocateExternalStringFromAscii(
     ExternalAsciiString::Resource* resource) {
   size_t length = resource->length();
@@ -2731,6 +2830,24 @@ void Heap::CreateFillerObjectAt(Address addr, int size) {
 }
 
 
+void Heap::SetAllocationSampleInterval(int sample_interval) {
+  ASSERT(sample_interval >= 0);
+  allocation_sample_interval_ = sample_interval;
+  allocation_sample_countdown_ = sample_interval;
+}
+
+
+void Heap::SampleAllocation() {
+#ifdef ENABLE_LOGGING_AND_PROFILING
+  // The sample stands for all bytes allocated since the previous one.
+  intptr_t sampled_bytes =
+      allocation_sample_interval_ - allocation_sample_countdown_;
+  allocation_sample_countdown_ = allocation_sample_interval_;
+  isolate_->heap_profiler()->SampleAllocation(sampled_bytes);
+#endif
+}
+
+
 MaybeObject* Heap::AllocateExternalArray(int length,
                                          ExternalArrayType array_type,
                                          void* external_pointer,
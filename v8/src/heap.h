@@ -74,6 +74,7 @@ inline Heap* _inline_get_heap_();
   V(Object, instanceof_cache_map, InstanceofCacheMap)                          \
   V(Object, instanceof_cache_answer, InstanceofCacheAnswer)                    \
   V(FixedArray, single_character_string_cache, SingleCharacterStringCache)     \
+  V(FixedArray, regexp_results_cache, RegExpResultsCache)                      \
   V(Object, termination_exception, TerminationException)                       \
   V(FixedArray, empty_fixed_array, EmptyFixedArray)                            \
   V(ByteArray, empty_byte_array, EmptyByteArray)                               \
@@ -93,6 +94,8 @@ inline Heap* _inline_get_heap_();
   V(Map, external_string_map, ExternalStringMap)                               \
   V(Map, external_string_with_ascii_data_map, ExternalStringWithAsciiDataMap)  \
   V(Map, external_ascii_string_map, ExternalAsciiStringMap)                    \
+  V(Map, sliced_string_map, SlicedStringMap)                                   \
+  V(Map, sliced_ascii_string_map, SlicedAsciiStringMap)                        \
   V(Map, undetectable_string_map, UndetectableStringMap)                       \
   V(Map, undetectable_ascii_string_map, UndetectableAsciiStringMap)            \
   V(Map, external_pixel_array_map, ExternalPixelArrayMap)                      \
@@ -731,7 +734,8 @@ class Heap {
 
   // Allocates a new sub string object which is a substring of an underlying
   // string buffer stretching from the index start (inclusive) to the index
-  // end (exclusive).
+  // end (exclusive).  Long substrings of flat strings are sliced strings
+  // that share the characters of the buffer (see --string_slices).
   // Returns Failure::RetryAfterGC(requested_bytes, space) if the allocation
   // failed.
   // Please note this does not perform a garbage collection.
@@ -741,6 +745,17 @@ class Heap {
       int end,
       PretenureFlag pretenure = NOT_TENURED);
 
+  // Allocates a sliced string of the given length that shares the
+  // characters of the flat string buffer starting at start.
+  // Returns Failure::RetryAfterGC(requested_bytes, space) if the allocation
+  // failed.
+  // Please note this does not perform a garbage collection.
+  MUST_USE_RESULT MaybeObject* AllocateSlicedString(
+      String* buffer,
+      int start,
+      int length,
+      PretenureFlag pretenure = NOT_TENURED);
+
   // Allocate a new external string object, which is backed by a string
   // resource that resides outside the V8 heap.
   // Returns Failure::RetryAfterGC(requested_bytes, space) if the allocation
@@ -764,6 +779,11 @@ class Heap {
                                                   AllocationSpace space,
                                                   AllocationSpace retry_space);
 
+  // Reports an allocation sample to the heap profiler every time
+  // sample_interval more bytes have been allocated through AllocateRaw.
+  // An interval of zero turns allocation sampling off.
+  void SetAllocationSampleInterval(int sample_interval);
+
   // Initialize a filler object to keep the ability to iterate over the heap
   // when shortening objects.
   void CreateFillerObjectAt(Address addr, int size);
@@ -1108,6 +1128,19 @@ class Heap {
   // Update the cache with a new number-string pair.
   void SetNumberStringCache(Object* number, String* str);
 
+  // Look up the matches of a global regexp on a subject string.  Returns
+  // the array stored by SetRegExpResultsCache or undefined if there is none.
+  Object* GetRegExpResultsCache(String* subject, FixedArray* regexp_data);
+
+  // Remember the matches of a global regexp on a subject string, or null
+  // if the regexp does not match.
+  void SetRegExpResultsCache(String* subject,
+                             FixedArray* regexp_data,
+                             Object* matches);
+
+  // Number of subject/regexp pairs in the regexp results cache.
+  static const int kRegExpResultsCacheSize = 64;
+
   // Adjusts the amount of registered external memory.
   // Returns the adjusted value.
   inline int AdjustAmountOfExternalAllocatedMemory(int change_in_bytes);
@@ -1262,6 +1295,12 @@ class Heap {
   int survived_since_last_expansion_;
 
   int always_allocate_scope_depth_;
+
+  // Bytes between allocation samples, zero when not sampling, and the
+  // bytes left until the next sample is taken.
+  int allocation_sample_interval_;
+  intptr_t allocation_sample_countdown_;
+
   int linear_allocation_scope_depth_;
 
   // For keeping track of context disposals.
@@ -1426,6 +1465,11 @@ class Heap {
 
   inline void UpdateOldSpaceLimits();
 
+  // Counts a successful raw allocation towards the next allocation sample.
+  inline void CountAllocationForSampling(MaybeObject* result,
+                                         int size_in_bytes);
+  void SampleAllocation();
+
   // Allocate an uninitialized object in map space.  The behavior is identical
   // to Heap::AllocateRaw(size_in_bytes, MAP_SPACE), except that (a) it doesn't
   // have to test the allocation space argument and (b) can reduce code size
@@ -1509,6 +1553,9 @@ class Heap {
   // Flush the number to string cache.
   void FlushNumberStringCache();
 
+  // Flush the regexp results cache.
+  void FlushRegExpResultsCache();
+
   void UpdateSurvivalRateTrend(int start_new_space_size);
 
   enum SurvivalRateTrend { INCREASING, STABLE, DECREASING, FLUCTUATING };
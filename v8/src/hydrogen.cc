@@ -1244,6 +1244,295 @@ void HStackCheckEliminator::RemoveStackCheck(HBasicBlock* block) {
 }
 
 
+// Removes array bounds checks that are implied by dominating integer
+// comparisons, by constant indices, or by the induction variables of
+// counted loops. A check is redundant if its index is known to be
+// non-negative and smaller than its length on every path reaching it.
+// Loop-invariant checks have already been hoisted by GVN at this point.
+class HBoundsCheckEliminator BASE_EMBEDDED {
+ public:
+  explicit HBoundsCheckEliminator(HGraph* graph)
+      : graph_(graph),
+        facts_(16),
+        checks_count_(0),
+        removed_count_(0) { }
+
+  void Process();
+
+ private:
+  // A relation that holds on the current path of the dominator tree:
+  // value < limit if limit is not NULL, otherwise value >= lower.
+  struct Fact {
+    HValue* value;
+    HValue* limit;
+    int lower;
+  };
+
+  // Bounds the recursion through induction variables and offsets.
+  static const int kMaxDepth = 4;
+
+  void ProcessBlock(HBasicBlock* block);
+  void AddControlFlowFacts(HTest* test, HBasicBlock* dest);
+  void AddCompareFacts(Token::Value op, HValue* value, HValue* other);
+  void AddFact(HValue* value, HValue* limit, int lower);
+  bool HasLowerBound(HValue* value, int lower, int depth);
+  bool IsLessThan(HValue* value, HValue* limit, int depth);
+  bool IsRedundant(HBoundsCheck* check);
+
+  HGraph* graph_;
+  ZoneList<Fact> facts_;
+  int checks_count_;
+  int removed_count_;
+};
+
+
+void TraceBCE(const char* msg, ...) {
+  if (FLAG_trace_bce) {
+    va_list arguments;
+    va_start(arguments, msg);
+    OS::VPrint(msg, arguments);
+    va_end(arguments);
+  }
+}
+
+
+// Representation changes that are not truncating preserve the numeric
+// value, so relations proven for the input hold for the result as well.
+static HValue* SkipValueChanges(HValue* value) {
+  while (value->IsChange() && !HChange::cast(value)->CanTruncateToInt32()) {
+    value = HChange::cast(value)->value();
+  }
+  return value;
+}
+
+
+static bool IsInteger32Constant(HValue* value, int32_t* result) {
+  if (!value->IsConstant()) return false;
+  HConstant* constant = HConstant::cast(value);
+  if (!constant->HasInteger32Value()) return false;
+  *result = constant->Integer32Value();
+  return true;
+}
+
+
+// Matches value == base + offset for an integer addition or subtraction
+// of a constant. Such operations either deoptimize on overflow or are
+// proven not to overflow by range analysis.
+static bool IsConstantOffset(HValue* value, HValue** base, int32_t* offset) {
+  if (!value->representation().IsInteger32()) return false;
+  if (value->IsAdd()) {
+    HAdd* add = HAdd::cast(value);
+    if (IsInteger32Constant(add->right(), offset)) {
+      *base = SkipValueChanges(add->left());
+      return true;
+    }
+    if (IsInteger32Constant(add->left(), offset)) {
+      *base = SkipValueChanges(add->right());
+      return true;
+    }
+  } else if (value->IsSub()) {
+    HSub* sub = HSub::cast(value);
+    int32_t subtrahend;
+    if (IsInteger32Constant(sub->right(), &subtrahend) &&
+        subtrahend != kMinInt) {
+      *base = SkipValueChanges(sub->left());
+      *offset = -subtrahend;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// Returns the value on loop entry of an induction variable that is only
+// increased (or only decreased) by a constant step in the loop, or NULL.
+static HValue* InductionVariableStart(HValue* value, bool increasing) {
+  if (!value->IsPhi()) return NULL;
+  HPhi* phi = HPhi::cast(value);
+  HBasicBlock* header = phi->block();
+  if (!header->IsLoopHeader() ||
+      !phi->representation().IsInteger32() ||
+      phi->OperandCount() != 2) {
+    return NULL;
+  }
+  HValue* start = NULL;
+  HValue* next = NULL;
+  for (int i = 0; i < phi->OperandCount(); ++i) {
+    HBasicBlock* pred = header->predecessors()->at(i);
+    if (pred == header || header->Dominates(pred)) {
+      next = phi->OperandAt(i);
+    } else {
+      start = phi->OperandAt(i);
+    }
+  }
+  if (start == NULL || next == NULL) return NULL;
+  HValue* base = NULL;
+  int32_t step = 0;
+  if (!IsConstantOffset(next, &base, &step) || base != phi) return NULL;
+  if (increasing ? step <= 0 : step >= 0) return NULL;
+  return SkipValueChanges(start);
+}
+
+
+void HBoundsCheckEliminator::Process() {
+  HPhase phase("Bounds check elimination", graph_);
+  ProcessBlock(graph_->blocks()->at(0));
+  if (FLAG_trace_hydrogen || FLAG_trace_bce) {
+    PrintF("Bounds check elimination: removed %d of %d checks\n",
+           removed_count_,
+           checks_count_);
+  }
+}
+
+
+void HBoundsCheckEliminator::ProcessBlock(HBasicBlock* block) {
+  int facts_length = facts_.length();
+
+  // Relations established by the branch leading to this block hold in all
+  // blocks it dominates.
+  if (block->predecessors()->length() == 1) {
+    HBasicBlock* pred = block->predecessors()->first();
+    if (pred->end()->IsTest()) {
+      AddControlFlowFacts(HTest::cast(pred->end()), block);
+    }
+  }
+
+  HInstruction* instr = block->first();
+  while (instr != NULL) {
+    HInstruction* next = instr->next();
+    if (instr->IsBoundsCheck()) {
+      HBoundsCheck* check = HBoundsCheck::cast(instr);
+      checks_count_++;
+      if (IsRedundant(check)) {
+        TraceBCE("Removing bounds check %d of %d against %d in B%d\n",
+                 check->id(),
+                 check->index()->id(),
+                 check->length()->id(),
+                 block->block_id());
+        check->ReplaceAndDelete(check->index());
+        removed_count_++;
+      }
+    }
+    instr = next;
+  }
+
+  for (int i = 0; i < block->dominated_blocks()->length(); ++i) {
+    ProcessBlock(block->dominated_blocks()->at(i));
+  }
+
+  facts_.Rewind(facts_length);
+}
+
+
+void HBoundsCheckEliminator::AddControlFlowFacts(HTest* test,
+                                                 HBasicBlock* dest) {
+  if (test->FirstSuccessor() == test->SecondSuccessor()) return;
+  if (!test->value()->IsCompare()) return;
+  HCompare* compare = HCompare::cast(test->value());
+  if (!compare->GetInputRepresentation().IsInteger32()) return;
+  Token::Value op = compare->token();
+  if (test->SecondSuccessor() == dest) op = Token::NegateCompareOp(op);
+  AddCompareFacts(op, compare->left(), compare->right());
+  AddCompareFacts(Token::InvertCompareOp(op), compare->right(),
+                  compare->left());
+}
+
+
+// We know that value [op] other.
+void HBoundsCheckEliminator::AddCompareFacts(Token::Value op,
+                                             HValue* value,
+                                             HValue* other) {
+  value = SkipValueChanges(value);
+  other = SkipValueChanges(other);
+  int32_t constant;
+  if (op == Token::LT) {
+    AddFact(value, other, 0);
+  } else if (op == Token::GT && IsInteger32Constant(other, &constant)) {
+    if (constant < kMaxInt) AddFact(value, NULL, constant + 1);
+  } else if (op == Token::GTE && IsInteger32Constant(other, &constant)) {
+    AddFact(value, NULL, constant);
+  }
+}
+
+
+void HBoundsCheckEliminator::AddFact(HValue* value, HValue* limit, int lower) {
+  Fact fact;
+  fact.value = value;
+  fact.limit = limit;
+  fact.lower = lower;
+  facts_.Add(fact);
+  if (limit != NULL) {
+    TraceBCE("Known %d < %d\n", value->id(), limit->id());
+  } else {
+    TraceBCE("Known %d >= %d\n", value->id(), lower);
+  }
+}
+
+
+bool HBoundsCheckEliminator::HasLowerBound(HValue* value,
+                                           int lower,
+                                           int depth) {
+  if (depth > kMaxDepth) return false;
+  value = SkipValueChanges(value);
+  int32_t constant;
+  if (IsInteger32Constant(value, &constant)) return constant >= lower;
+  if (value->range() != NULL && value->range()->lower() >= lower) {
+    return true;
+  }
+  for (int i = 0; i < facts_.length(); ++i) {
+    const Fact& fact = facts_[i];
+    if (fact.value == value && fact.limit == NULL && fact.lower >= lower) {
+      return true;
+    }
+  }
+  // base + c >= lower if base >= lower - c.
+  HValue* base = NULL;
+  int32_t offset = 0;
+  if (IsConstantOffset(value, &base, &offset)) {
+    int64_t base_lower = static_cast<int64_t>(lower) - offset;
+    if (base_lower >= kMinInt && base_lower <= kMaxInt &&
+        HasLowerBound(base, static_cast<int>(base_lower), depth + 1)) {
+      return true;
+    }
+  }
+  // An induction variable never drops below its start value.
+  HValue* start = InductionVariableStart(value, true);
+  return start != NULL && HasLowerBound(start, lower, depth + 1);
+}
+
+
+bool HBoundsCheckEliminator::IsLessThan(HValue* value,
+                                        HValue* limit,
+                                        int depth) {
+  if (depth > kMaxDepth) return false;
+  value = SkipValueChanges(value);
+  limit = SkipValueChanges(limit);
+  for (int i = 0; i < facts_.length(); ++i) {
+    const Fact& fact = facts_[i];
+    if (fact.value == value && fact.limit == limit) return true;
+  }
+  int32_t constant;
+  if (IsInteger32Constant(value, &constant)) {
+    return constant < kMaxInt && HasLowerBound(limit, constant + 1, depth);
+  }
+  // base - c < base <= limit for a positive constant c.
+  HValue* base = NULL;
+  int32_t offset = 0;
+  if (IsConstantOffset(value, &base, &offset) && offset < 0) {
+    if (base == limit || IsLessThan(base, limit, depth + 1)) return true;
+  }
+  // A decreasing induction variable never exceeds its start value.
+  HValue* start = InductionVariableStart(value, false);
+  return start != NULL && IsLessThan(start, limit, depth + 1);
+}
+
+
+bool HBoundsCheckEliminator::IsRedundant(HBoundsCheck* check) {
+  return HasLowerBound(check->index(), 0, 0) &&
+      IsLessThan(check->index(), check->length(), 0);
+}
+
+
 class HGlobalValueNumberer BASE_EMBEDDED {
  public:
   explicit HGlobalValueNumberer(HGraph* graph, CompilationInfo* info)
@@ -2285,6 +2574,11 @@ HGraph* HGraphBuilder::CreateGraph() {
     gvn.Analyze();
   }
 
+  if (FLAG_array_bounds_checks_elimination) {
+    HBoundsCheckEliminator bce(graph());
+    bce.Process();
+  }
+
   // Replace the results of check instructions with the original value, if the
   // result is used. This is safe now, since we don't do code motion after this
   // point. It enables better register allocation since the value produced by
@@ -3917,7 +4211,9 @@ void HGraphBuilder::HandlePolymorphicCallNamed(Call* expr,
   int argument_count = expr->arguments()->length() + 1;  // Includes receiver.
   int count = 0;
   HBasicBlock* join = NULL;
-  for (int i = 0; i < types->length() && count < kMaxCallPolymorphism; ++i) {
+  for (int i = 0;
+       i < types->length() && count < FLAG_max_call_polymorphism;
+       ++i) {
     Handle<Map> map = types->at(i);
     if (expr->ComputeTarget(map, name)) {
       if (count == 0) {
@@ -4019,7 +4315,8 @@ bool HGraphBuilder::TryInline(Call* expr) {
 
   // Do a quick check on source code length to avoid parsing large
   // inlining candidates.
-  if (FLAG_limit_inlining && target->shared()->SourceSize() > kMaxSourceSize) {
+  if (FLAG_limit_inlining &&
+      target->shared()->SourceSize() > FLAG_max_inlined_source_size) {
     TraceInline(target, "target text too big");
     return false;
   }
@@ -4058,7 +4355,8 @@ bool HGraphBuilder::TryInline(Call* expr) {
   }
 
   // We don't want to add more than a certain number of nodes from inlining.
-  if (FLAG_limit_inlining && inlined_count_ > kMaxInlinedNodes) {
+  if (FLAG_limit_inlining &&
+      inlined_count_ >= FLAG_max_inlined_nodes_cumulative) {
     TraceInline(target, "cumulative AST node limit reached");
     return false;
   }
@@ -4086,11 +4384,19 @@ bool HGraphBuilder::TryInline(Call* expr) {
 
   // Count the number of AST nodes added by inlining this call.
   int nodes_added = AstNode::Count() - count_before;
-  if (FLAG_limit_inlining && nodes_added > kMaxInlinedSize) {
+  if (FLAG_limit_inlining && nodes_added > FLAG_max_inlined_nodes) {
     TraceInline(target, "target AST is too large");
     return false;
   }
 
+  // The budget is shared by all calls inlined into the optimized function,
+  // including every target of a polymorphic call.
+  if (FLAG_limit_inlining &&
+      inlined_count_ + nodes_added > FLAG_max_inlined_nodes_cumulative) {
+    TraceInline(target, "cumulative AST node limit reached");
+    return false;
+  }
+
   // Check if we can handle all declarations in the inlined functions.
   VisitDeclarations(target_info.scope()->declarations());
   if (HasStackOverflow()) {
@@ -5975,12 +6281,11 @@ void HTracer::TraceLiveRange(LiveRange* range, const char* type) {
     int hint_index = -1;
     if (op != NULL && op->IsUnallocated()) hint_index = op->VirtualRegister();
     trace_.Add(" %d %d", parent_index, hint_index);
-    UseInterval* cur_interval = range->first_interval();
-    while (cur_interval != NULL && range->Covers(cur_interval->start())) {
+    for (int i = 0; i < range->interval_count(); ++i) {
+      const UseInterval& cur_interval = range->interval_at(i);
       trace_.Add(" [%d, %d[",
-                 cur_interval->start().Value(),
-                 cur_interval->end().Value());
-      cur_interval = cur_interval->next();
+                 cur_interval.start().Value(),
+                 cur_interval.end().Value());
     }
 
     UsePosition* current_pos = range->first_pos();
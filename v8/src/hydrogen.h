@@ -679,14 +679,9 @@ class HGraphBuilder: public AstVisitor {
 
   static const InlineFunctionGenerator kInlineFunctionGenerators[];
 
-  static const int kMaxCallPolymorphism = 4;
   static const int kMaxLoadPolymorphism = 4;
   static const int kMaxStorePolymorphism = 4;
 
-  static const int kMaxInlinedNodes = 196;
-  static const int kMaxInlinedSize = 196;
-  static const int kMaxSourceSize = 600;
-
   // Simple accessors.
   FunctionState* function_state() const { return function_state_; }
   void set_function_state(FunctionState* state) { function_state_ = state; }
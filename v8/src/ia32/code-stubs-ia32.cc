@@ -4467,6 +4467,9 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   // Handle non-flat strings.
   __ test(result_, Immediate(kIsConsStringMask));
   __ j(zero, &call_runtime_);
+  // Sliced strings are read by the runtime system.
+  __ test(result_, Immediate(kSlicedNotConsMask));
+  __ j(not_zero, &call_runtime_);
 
   // ConsString.
   // Check whether the right hand side is the empty string (i.e. if
@@ -3157,6 +3157,9 @@ void LCodeGen::DoStringCharCodeAt(LStringCharCodeAt* instr) {
   // Handle non-flat strings.
   __ test(result, Immediate(kIsConsStringMask));
   __ j(zero, deferred->entry());
+  // Sliced strings are read by the runtime system.
+  __ test(result, Immediate(kSlicedNotConsMask));
+  __ j(not_zero, deferred->entry());
 
   // ConsString.
   // Check whether the right hand side is the empty string (i.e. if
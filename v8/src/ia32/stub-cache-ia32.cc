@@ -46,8 +46,11 @@ static void ProbeTable(Isolate* isolate,
                        Register name,
                        Register offset,
                        Register extra) {
-  ExternalReference key_offset(isolate->stub_cache()->key_reference(table));
-  ExternalReference value_offset(isolate->stub_cache()->value_reference(table));
+  StubCache* stub_cache = isolate->stub_cache();
+  StubCache::CacheKind kind = StubCache::CacheKindForFlags(flags);
+  ExternalReference key_offset(stub_cache->key_reference(kind, table));
+  ExternalReference value_offset(stub_cache->value_reference(kind, table));
+  StatsCounter* hit_counter = stub_cache->hit_counter(kind, table);
 
   Label miss;
 
@@ -64,6 +67,7 @@ static void ProbeTable(Isolate* isolate,
     __ and_(offset, ~Code::kFlagsNotUsedInLookup);
     __ cmp(offset, flags);
     __ j(not_equal, &miss);
+    __ IncrementCounter(hit_counter, 1);
 
     // Jump to the first instruction in the code stub.
     __ add(Operand(extra), Immediate(Code::kHeaderSize - kHeapObjectTag));
@@ -87,6 +91,8 @@ static void ProbeTable(Isolate* isolate,
     __ cmp(offset, flags);
     __ j(not_equal, &miss);
 
+    __ IncrementCounter(hit_counter, 1);
+
     // Restore offset and re-load code entry from cache.
     __ pop(offset);
     __ mov(offset, Operand::StaticArray(offset, times_2, value_offset));
@@ -236,11 +242,16 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   __ test(receiver, Immediate(kSmiTagMask));
   __ j(zero, &miss, not_taken);
 
+  // The table sizes are chosen at isolate creation, so the masks are
+  // loaded from the stub cache rather than embedded in the code.
+  ExternalReference primary_mask(mask_reference(kPrimary));
+  ExternalReference secondary_mask(mask_reference(kSecondary));
+
   // Get the map of the receiver and compute the hash.
   __ mov(scratch, FieldOperand(name, String::kHashFieldOffset));
   __ add(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
   __ xor_(scratch, flags);
-  __ and_(scratch, (kPrimaryTableSize - 1) << kHeapObjectTagSize);
+  __ and_(scratch, Operand::StaticVariable(primary_mask));
 
   // Probe the primary table.
   ProbeTable(isolate, masm, flags, kPrimary, name, scratch, extra);
@@ -249,10 +260,10 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   __ mov(scratch, FieldOperand(name, String::kHashFieldOffset));
   __ add(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
   __ xor_(scratch, flags);
-  __ and_(scratch, (kPrimaryTableSize - 1) << kHeapObjectTagSize);
+  __ and_(scratch, Operand::StaticVariable(primary_mask));
   __ sub(scratch, Operand(name));
   __ add(Operand(scratch), Immediate(flags));
-  __ and_(scratch, (kSecondaryTableSize - 1) << kHeapObjectTagSize);
+  __ and_(scratch, Operand::StaticVariable(secondary_mask));
 
   // Probe the secondary table.
   ProbeTable(isolate, masm, flags, kSecondary, name, scratch, extra);
@@ -260,6 +271,7 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Cache miss: Fall-through and let caller handle the miss by
   // entering the runtime system.
   __ bind(&miss);
+  __ IncrementCounter(miss_counter(CacheKindForFlags(flags)), 1);
 }
 
 
@@ -480,6 +480,16 @@ MaybeObject* CallICBase::LoadFunction(State state,
     return TypeError("non_object_property_call", object, name);
   }
 
+  if (state == MEGAMORPHIC) {
+    Code::Flags flags = Code::ComputeFlags(kind_,
+                                           NOT_IN_LOOP,
+                                           MONOMORPHIC,
+                                           extra_ic_state,
+                                           NORMAL,
+                                           target()->arguments_count());
+    isolate()->stub_cache()->CountMegamorphicMiss(*name, *object, flags);
+  }
+
   // Check if the name is trivially convertible to an index and get
   // the element if so.
   uint32_t index;
@@ -857,6 +867,12 @@ MaybeObject* LoadIC::Load(State state,
     return TypeError("non_object_property_load", object, name);
   }
 
+  if (state == MEGAMORPHIC) {
+    Code::Flags flags =
+        Code::ComputeFlags(Code::LOAD_IC, NOT_IN_LOOP, MONOMORPHIC);
+    isolate()->stub_cache()->CountMegamorphicMiss(*name, *object, flags);
+  }
+
   if (FLAG_use_ic) {
     Code* non_monomorphic_stub =
         (state == UNINITIALIZED) ? pre_monomorphic_stub() : megamorphic_stub();
@@ -1431,6 +1447,14 @@ MaybeObject* StoreIC::Store(State state,
     return TypeError("non_object_property_store", object, name);
   }
 
+  if (state == MEGAMORPHIC) {
+    Code::Flags flags = Code::ComputeFlags(Code::STORE_IC,
+                                           NOT_IN_LOOP,
+                                           MONOMORPHIC,
+                                           strict_mode);
+    isolate()->stub_cache()->CountMegamorphicMiss(*name, *object, flags);
+  }
+
   if (!object->IsJSObject()) {
     // The length property of string values is read-only. Throw in strict mode.
     if (strict_mode == kStrictMode && object->IsString() &&
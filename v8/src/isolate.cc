@@ -526,6 +526,7 @@ void Isolate::Deinit() {
     TRACE_ISOLATE(deinit);
 
     if (FLAG_hydrogen_stats) HStatistics::Instance()->Print();
+    if (FLAG_trace_zone_stats) zone_.PrintStatistics();
 
     // We must stop the logger before we tear down other components.
     logger_->EnsureTickerStopped();
@@ -553,6 +554,7 @@ void Isolate::Deinit() {
     }
     heap_.TearDown();
     logger_->TearDown();
+    zone_.TearDown();
 
     // The default isolate is re-initializable due to legacy API.
     state_ = UNINITIALIZED;
@@ -985,7 +985,7 @@ class Isolate {
   Factory* factory() { return reinterpret_cast<Factory*>(this); }
 
   // SerializerDeserializer state.
-  static const int kPartialSnapshotCacheCapacity = 1400;
+  static const int kPartialSnapshotCacheCapacity = 4096;
 
   static const int kJSRegexpStaticOffsetsVectorSize = 50;
 
@@ -1246,6 +1246,7 @@ class Isolate {
   friend class TestMemoryAllocatorScope;
   friend class v8::Isolate;
   friend class v8::Locker;
+  friend class v8::Unlocker;
 
   DISALLOW_COPY_AND_ASSIGN(Isolate);
 };
@@ -0,0 +1,679 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef V8_JSON_PARSER_H_
+#define V8_JSON_PARSER_H_
+
+#include "v8.h"
+
+#include "char-predicates-inl.h"
+#include "conversions.h"
+#include "messages.h"
+#include "scanner-base.h"
+
+namespace v8 {
+namespace internal {
+
+// Character access for the string representations the JSON parser is
+// instantiated with.  The source is flat, so these never have to walk a
+// cons string.
+inline uc32 JsonCharAt(SeqAsciiString* source, int index) {
+  return source->SeqAsciiStringGet(index);
+}
+
+
+inline uc32 JsonCharAt(SeqTwoByteString* source, int index) {
+  return source->SeqTwoByteStringGet(index);
+}
+
+
+inline uc32 JsonCharAt(String* source, int index) {
+  return source->Get(index);
+}
+
+
+// JSON is a subset of JavaScript, as specified in, e.g., the ECMAScript 5
+// specification section 15.12.1 (and appendix A.8).
+// The grammar is given section 15.12.1.2 (and appendix A.8.2).
+//
+// The parser reads the characters of a flat string directly instead of
+// going through a character stream and a scanner.  StringType is
+// SeqAsciiString or SeqTwoByteString for sequential sources and String
+// for any other flat source.
+template <typename StringType>
+class JsonParser BASE_EMBEDDED {
+ public:
+  // Parse JSON input as a single JSON value.  The source must be flat.
+  // Returns null handle and sets exception if parsing failed.
+  static Handle<Object> Parse(Handle<String> source) {
+    ASSERT(source->IsFlat());
+    return JsonParser(Handle<StringType>::cast(source)).ParseJson();
+  }
+
+  static const int kEndOfString = -1;
+
+ private:
+  explicit JsonParser(Handle<StringType> source)
+      : isolate_(Isolate::Current()),
+        source_(source),
+        source_length_(source->length()),
+        position_(-1),
+        c0_(kEndOfString),
+        stack_overflow_(false),
+        first_property_map_count_(0) { }
+
+  Isolate* isolate() { return isolate_; }
+  Factory* factory() { return isolate_->factory(); }
+
+  inline void Advance() {
+    position_++;
+    if (position_ < source_length_) {
+      c0_ = JsonCharAt(*source_, position_);
+    } else {
+      c0_ = kEndOfString;
+    }
+  }
+
+  // The only allowed whitespace characters between tokens are tab,
+  // carriage-return, newline and space.
+  inline void SkipWhitespace() {
+    while (c0_ == ' ' || c0_ == '\t' || c0_ == '\r' || c0_ == '\n') {
+      Advance();
+    }
+  }
+
+  inline void AdvanceSkipWhitespace() {
+    Advance();
+    SkipWhitespace();
+  }
+
+  // Parse a string containing a single JSON value.
+  Handle<Object> ParseJson();
+  // Parse a single JSON value from input (grammar production JSONValue).
+  // A JSON value is either a (double-quoted) string literal, a number literal,
+  // one of "true", "false", or "null", or an object or array literal.
+  // Leaves c0_ at the first non-whitespace character after the value.
+  Handle<Object> ParseJsonValue();
+  // Parse a JSON object literal (grammar production JSONObject).
+  // An object literal is a squiggly-braced and comma separated sequence
+  // (possibly empty) of key/value pairs, where the key is a JSON string
+  // literal, the value is a JSON value, and the two are separated by a colon.
+  // A JSON array dosn't allow numbers and identifiers as keys, like a
+  // JavaScript array.
+  Handle<Object> ParseJsonObject();
+  // Parses a JSON array literal (grammar production JSONArray). An array
+  // literal is a square-bracketed and comma separated sequence (possibly empty)
+  // of JSON values.
+  // A JSON array doesn't allow leaving out values from the sequence, nor does
+  // it allow a terminal comma, like a JavaScript array does.
+  Handle<Object> ParseJsonArray();
+
+  // A JSON string (production JSONString) is subset of valid JavaScript string
+  // literals. The string must only be double-quoted (not single-quoted), and
+  // the only allowed backslash-escapes are ", /, \, b, f, n, r, t and
+  // four-digit hex escapes (uXXXX). Any other use of backslashes is invalid.
+  Handle<String> ParseJsonString();
+  // Parses a JSON string used as a property name and returns it as a
+  // symbol.  Recently seen names are found in a small cache without
+  // creating a string.
+  Handle<String> ParseJsonSymbol();
+  // Slow case of ParseJsonString for strings containing escapes.  The
+  // characters from begin up to position_ are known to need no decoding.
+  Handle<String> SlowParseJsonString(int begin);
+  // Decodes the characters between the quotes at begin and end into sink.
+  // The string must have been validated by SlowParseJsonString.
+  template <typename SinkChar>
+  void DecodeJsonString(int begin, int end, SinkChar* sink);
+
+  // A JSON number (production JSONNumber) is a subset of the valid JavaScript
+  // decimal number literals.
+  // It includes an optional minus sign, must have at least one
+  // digit before and after a decimal point, may not have prefixed zeros (unless
+  // the integer part is zero), and may include an exponent part (e.g., "e-10").
+  // Hexadecimal and octal numbers are not allowed.
+  Handle<Object> ParseJsonNumber();
+
+  // Used to recognize one of the literals "true", "false", or "null". These
+  // are the only valid JSON identifiers (productions JSONBooleanLiteral,
+  // JSONNullLiteral).
+  bool ParseJsonLiteral(const char* text);
+
+  // Adds a named property to a JSON object under construction.
+  void SetJsonProperty(Handle<JSObject> json_object,
+                       Handle<String> key,
+                       Handle<Object> value);
+
+  // Mark that a parsing error has happened at the current character, and
+  // return a null handle. Primarily for readability.
+  Handle<Object> ReportUnexpectedCharacter() { return Handle<Object>::null(); }
+  // Throws a SyntaxError describing the character at the current position.
+  void ThrowUnexpectedCharacter();
+
+  // Number of property name symbols remembered by ParseJsonSymbol.  Must be
+  // a power of two.
+  static const int kSymbolCacheSize = 64;
+  // Number of distinct first property names for which the map of an object
+  // having just that property is remembered.
+  static const int kMaxFirstPropertyMaps = 16;
+
+  Isolate* isolate_;
+  Handle<StringType> source_;
+  int source_length_;
+  int position_;
+  uc32 c0_;
+  bool stack_overflow_;
+
+  Handle<JSFunction> object_constructor_;
+  // Direct mapped cache of property name symbols, indexed by a hash of
+  // their characters.
+  Handle<FixedArray> symbol_cache_;
+  // Pairs of property name and the map an empty JSON object transitions to
+  // when that property is added.  Objects start out with the map of the
+  // Object function, which never gets map transitions, so without this
+  // every parsed object would get maps of its own.
+  Handle<FixedArray> first_property_maps_;
+  int first_property_map_count_;
+};
+
+
+template <typename StringType>
+Handle<Object> JsonParser<StringType>::ParseJson() {
+  object_constructor_ =
+      Handle<JSFunction>(isolate()->global_context()->object_function());
+  symbol_cache_ = factory()->NewFixedArray(kSymbolCacheSize);
+  first_property_maps_ = factory()->NewFixedArray(2 * kMaxFirstPropertyMaps);
+
+  AdvanceSkipWhitespace();
+  Handle<Object> result = ParseJsonValue();
+  if (result.is_null() || c0_ != kEndOfString) {
+    if (stack_overflow_) {
+      isolate()->StackOverflow();
+    } else {
+      ThrowUnexpectedCharacter();
+    }
+    return Handle<Object>::null();
+  }
+  return result;
+}
+
+
+template <typename StringType>
+void JsonParser<StringType>::ThrowUnexpectedCharacter() {
+  const char* message;
+  Handle<JSArray> array;
+  Factory* factory = this->factory();
+  if (c0_ == kEndOfString) {
+    message = "unexpected_eos";
+    array = factory->NewJSArray(0);
+  } else if (c0_ == '-' || IsDecimalDigit(c0_)) {
+    message = "unexpected_token_number";
+    array = factory->NewJSArray(0);
+  } else if (c0_ == '"') {
+    message = "unexpected_token_string";
+    array = factory->NewJSArray(0);
+  } else {
+    message = "unexpected_token";
+    Handle<FixedArray> element = factory->NewFixedArray(1);
+    element->set(0, *LookupSingleCharacterStringFromCode(c0_));
+    array = factory->NewJSArrayWithElements(element);
+  }
+
+  int end_position = position_ < source_length_ ? position_ + 1 : position_;
+  MessageLocation location(factory->NewScript(source_),
+                           position_,
+                           end_position);
+  Handle<Object> result = factory->NewSyntaxError(message, array);
+  isolate()->Throw(*result, &location);
+}
+
+
+// Parse any JSON value.
+template <typename StringType>
+Handle<Object> JsonParser<StringType>::ParseJsonValue() {
+  Handle<Object> result;
+  switch (c0_) {
+    case '"':
+      result = ParseJsonString();
+      break;
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      result = ParseJsonNumber();
+      break;
+    case 'f':
+      if (!ParseJsonLiteral("false")) return ReportUnexpectedCharacter();
+      result = factory()->false_value();
+      break;
+    case 't':
+      if (!ParseJsonLiteral("true")) return ReportUnexpectedCharacter();
+      result = factory()->true_value();
+      break;
+    case 'n':
+      if (!ParseJsonLiteral("null")) return ReportUnexpectedCharacter();
+      result = factory()->null_value();
+      break;
+    case '{':
+      result = ParseJsonObject();
+      break;
+    case '[':
+      result = ParseJsonArray();
+      break;
+    default:
+      return ReportUnexpectedCharacter();
+  }
+  if (!result.is_null()) SkipWhitespace();
+  return result;
+}
+
+
+template <typename StringType>
+bool JsonParser<StringType>::ParseJsonLiteral(const char* text) {
+  for (; *text != '\0'; text++) {
+    if (c0_ != *text) return false;
+    Advance();
+  }
+  return !isolate()->unicode_cache()->IsIdentifierPart(c0_);
+}
+
+
+// Parse a JSON object. Position must be at the '{'.
+template <typename StringType>
+Handle<Object> JsonParser<StringType>::ParseJsonObject() {
+  ASSERT_EQ('{', c0_);
+  Handle<JSObject> json_object = factory()->NewJSObject(object_constructor_);
+  AdvanceSkipWhitespace();
+  if (c0_ == '}') {
+    Advance();
+    return json_object;
+  }
+  if (StackLimitCheck(isolate()).HasOverflowed()) {
+    stack_overflow_ = true;
+    return Handle<Object>::null();
+  }
+  while (true) {
+    if (c0_ != '"') return ReportUnexpectedCharacter();
+    Handle<String> key = ParseJsonSymbol();
+    if (key.is_null()) return Handle<Object>::null();
+    SkipWhitespace();
+    if (c0_ != ':') return ReportUnexpectedCharacter();
+    AdvanceSkipWhitespace();
+    Handle<Object> value = ParseJsonValue();
+    if (value.is_null()) return Handle<Object>::null();
+
+    uint32_t index;
+    if (key->AsArrayIndex(&index)) {
+      SetOwnElement(json_object, index, value, kNonStrictMode);
+    } else if (*key == isolate()->heap()->Proto_symbol()) {
+      // We can't remove the __proto__ accessor since it's hardcoded
+      // in several places. Instead go along and add the value as
+      // the prototype of the created object if possible.
+      SetPrototype(json_object, value);
+    } else {
+      SetJsonProperty(json_object, key, value);
+    }
+
+    if (c0_ != ',') break;
+    AdvanceSkipWhitespace();
+  }
+  if (c0_ != '}') return ReportUnexpectedCharacter();
+  Advance();
+  return json_object;
+}
+
+
+template <typename StringType>
+void JsonParser<StringType>::SetJsonProperty(Handle<JSObject> json_object,
+                                             Handle<String> key,
+                                             Handle<Object> value) {
+  Map* initial_map = object_constructor_->initial_map();
+  if (json_object->map() != initial_map) {
+    // Later properties find the map transitions left by earlier objects.
+    SetLocalPropertyIgnoreAttributes(json_object, key, value, NONE);
+    return;
+  }
+
+  for (int i = 0; i < first_property_map_count_; i++) {
+    if (first_property_maps_->get(2 * i) != *key) continue;
+    Map* map = Map::cast(first_property_maps_->get(2 * i + 1));
+    MaybeObject* maybe_result =
+        json_object->AddFastPropertyUsingMap(map, *key, *value);
+    // On allocation failure take the generic path, which retries.
+    if (!maybe_result->IsFailure()) return;
+    break;
+  }
+
+  SetLocalPropertyIgnoreAttributes(json_object, key, value, NONE);
+  if (first_property_map_count_ < kMaxFirstPropertyMaps &&
+      json_object->HasFastProperties() &&
+      json_object->map() != initial_map) {
+    int i = first_property_map_count_++;
+    first_property_maps_->set(2 * i, *key);
+    first_property_maps_->set(2 * i + 1, json_object->map());
+  }
+}
+
+
+// Parse a JSON array. Position must be at the '['.
+template <typename StringType>
+Handle<Object> JsonParser<StringType>::ParseJsonArray() {
+  ASSERT_EQ('[', c0_);
+  ZoneScope zone_scope(DELETE_ON_EXIT);
+  ZoneList<Handle<Object> > elements(4);
+
+  AdvanceSkipWhitespace();
+  if (c0_ != ']') {
+    if (StackLimitCheck(isolate()).HasOverflowed()) {
+      stack_overflow_ = true;
+      return Handle<Object>::null();
+    }
+    while (true) {
+      Handle<Object> element = ParseJsonValue();
+      if (element.is_null()) return Handle<Object>::null();
+      elements.Add(element);
+      if (c0_ != ',') break;
+      AdvanceSkipWhitespace();
+    }
+    if (c0_ != ']') return ReportUnexpectedCharacter();
+  }
+  Advance();
+
+  // Allocate a fixed array with all the elements.
+  Handle<FixedArray> fast_elements =
+      factory()->NewFixedArray(elements.length());
+
+  for (int i = 0, n = elements.length(); i < n; i++) {
+    fast_elements->set(i, *elements[i]);
+  }
+
+  return factory()->NewJSArrayWithElements(fast_elements);
+}
+
+
+template <typename StringType>
+Handle<Object> JsonParser<StringType>::ParseJsonNumber() {
+  int begin = position_;
+  bool negative = false;
+  if (c0_ == '-') {
+    Advance();
+    negative = true;
+  }
+  if (c0_ == '0') {
+    Advance();
+    // Prefix zero is only allowed if it's the only digit before
+    // a decimal point or exponent.
+    if (IsDecimalDigit(c0_)) return ReportUnexpectedCharacter();
+  } else {
+    int i = 0;
+    int digits = 0;
+    if (c0_ < '1' || c0_ > '9') return ReportUnexpectedCharacter();
+    do {
+      i = i * 10 + c0_ - '0';
+      digits++;
+      Advance();
+    } while (IsDecimalDigit(c0_));
+    if (c0_ != '.' && c0_ != 'e' && c0_ != 'E' && digits < 10) {
+      return Handle<Object>(Smi::FromInt(negative ? -i : i), isolate());
+    }
+  }
+  if (c0_ == '.') {
+    Advance();
+    if (!IsDecimalDigit(c0_)) return ReportUnexpectedCharacter();
+    do {
+      Advance();
+    } while (IsDecimalDigit(c0_));
+  }
+  if (AsciiAlphaToLower(c0_) == 'e') {
+    Advance();
+    if (c0_ == '-' || c0_ == '+') Advance();
+    if (!IsDecimalDigit(c0_)) return ReportUnexpectedCharacter();
+    do {
+      Advance();
+    } while (IsDecimalDigit(c0_));
+  }
+
+  // The number has been validated and only consists of ASCII characters.
+  int length = position_ - begin;
+  ScopedVector<char> buffer(length);
+  for (int i = 0; i < length; i++) {
+    buffer[i] = static_cast<char>(JsonCharAt(*source_, begin + i));
+  }
+  double number = StringToDouble(isolate()->unicode_cache(),
+                                 Vector<const char>(buffer.start(), length),
+                                 NO_FLAGS,  // Hex, octal or trailing junk.
+                                 OS::nan_value());
+  return factory()->NewNumber(number);
+}
+
+
+template <typename StringType>
+Handle<String> JsonParser<StringType>::ParseJsonString() {
+  ASSERT_EQ('"', c0_);
+  Advance();
+  int begin = position_;
+  bool is_ascii = true;
+  // Fast case: no escapes, the characters are copied straight from the
+  // source.
+  while (c0_ != '"') {
+    // Check for control character (0x00-0x1f) or unterminated string (<0).
+    if (c0_ < 0x20) return Handle<String>::null();
+    if (c0_ == '\\') return SlowParseJsonString(begin);
+    if (c0_ > String::kMaxAsciiCharCode) is_ascii = false;
+    Advance();
+  }
+  int end = position_;
+  Advance();
+
+  int length = end - begin;
+  if (length == 0) return factory()->empty_string();
+  if (length == 1) {
+    return Handle<String>::cast(
+        LookupSingleCharacterStringFromCode(JsonCharAt(*source_, begin)));
+  }
+  if (is_ascii) {
+    Handle<SeqAsciiString> result =
+        Handle<SeqAsciiString>::cast(factory()->NewRawAsciiString(length));
+    String::WriteToFlat(*source_, result->GetChars(), begin, end);
+    return result;
+  }
+  Handle<SeqTwoByteString> result =
+      Handle<SeqTwoByteString>::cast(factory()->NewRawTwoByteString(length));
+  String::WriteToFlat(*source_, result->GetChars(), begin, end);
+  return result;
+}
+
+
+template <typename StringType>
+Handle<String> JsonParser<StringType>::SlowParseJsonString(int begin) {
+  // Validate the rest of the string and compute the decoded length.
+  int length = position_ - begin;
+  bool is_ascii = true;
+  for (int i = begin; i < position_; i++) {
+    if (JsonCharAt(*source_, i) > String::kMaxAsciiCharCode) is_ascii = false;
+  }
+  while (c0_ != '"') {
+    if (c0_ < 0x20) return Handle<String>::null();
+    uc32 c = c0_;
+    if (c0_ == '\\') {
+      Advance();
+      switch (c0_) {
+        case '"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+          c = c0_;
+          break;
+        case 'u': {
+          c = 0;
+          for (int i = 0; i < 4; i++) {
+            Advance();
+            int digit = HexValue(c0_);
+            if (digit < 0) return Handle<String>::null();
+            c = c * 16 + digit;
+          }
+          break;
+        }
+        default:
+          return Handle<String>::null();
+      }
+    }
+    if (c > String::kMaxAsciiCharCode) is_ascii = false;
+    length++;
+    Advance();
+  }
+  int end = position_;
+  Advance();
+
+  if (is_ascii) {
+    Handle<SeqAsciiString> result =
+        Handle<SeqAsciiString>::cast(factory()->NewRawAsciiString(length));
+    DecodeJsonString(begin, end, result->GetChars());
+    return result;
+  }
+  Handle<SeqTwoByteString> result =
+      Handle<SeqTwoByteString>::cast(factory()->NewRawTwoByteString(length));
+  DecodeJsonString(begin, end, result->GetChars());
+  return result;
+}
+
+
+template <typename StringType>
+template <typename SinkChar>
+void JsonParser<StringType>::DecodeJsonString(int begin,
+                                              int end,
+                                              SinkChar* sink) {
+  StringType* source = *source_;
+  int i = begin;
+  while (i < end) {
+    uc32 c = JsonCharAt(source, i++);
+    if (c == '\\') {
+      c = JsonCharAt(source, i++);
+      switch (c) {
+        case 'b':
+          c = '\x08';
+          break;
+        case 'f':
+          c = '\x0c';
+          break;
+        case 'n':
+          c = '\x0a';
+          break;
+        case 'r':
+          c = '\x0d';
+          break;
+        case 't':
+          c = '\x09';
+          break;
+        case 'u':
+          c = 0;
+          for (int j = 0; j < 4; j++) {
+            c = c * 16 + HexValue(JsonCharAt(source, i++));
+          }
+          break;
+        default:
+          break;
+      }
+    }
+    *sink++ = static_cast<SinkChar>(c);
+  }
+}
+
+
+template <typename StringType>
+Handle<String> JsonParser<StringType>::ParseJsonSymbol() {
+  ASSERT_EQ('"', c0_);
+  int begin = position_ + 1;
+  // Scan a name without escapes, hashing it on the way.
+  uint32_t hash = 0;
+  bool is_ascii = true;
+  int end = begin;
+  for (; end < source_length_; end++) {
+    uc32 c = JsonCharAt(*source_, end);
+    if (c == '"' || c == '\\' || c < 0x20) break;
+    if (c > String::kMaxAsciiCharCode) is_ascii = false;
+    hash = hash * 31 + c;
+  }
+  if (end == source_length_ || JsonCharAt(*source_, end) != '"') {
+    // Escapes or an error; take the general path.
+    Handle<String> name = ParseJsonString();
+    if (name.is_null()) return name;
+    return factory()->LookupSymbol(name);
+  }
+
+  int length = end - begin;
+  int cache_index = (hash + length) & (kSymbolCacheSize - 1);
+  Object* cached = symbol_cache_->get(cache_index);
+  if (cached->IsString() && String::cast(cached)->length() == length) {
+    String* symbol = String::cast(cached);
+    int i = 0;
+    while (i < length && symbol->Get(i) == JsonCharAt(*source_, begin + i)) {
+      i++;
+    }
+    if (i == length) {
+      position_ = end;
+      Advance();
+      return Handle<String>(symbol, isolate());
+    }
+  }
+
+  Handle<String> symbol;
+  if (is_ascii) {
+    ScopedVector<char> buffer(length);
+    for (int i = 0; i < length; i++) {
+      buffer[i] = static_cast<char>(JsonCharAt(*source_, begin + i));
+    }
+    symbol = factory()->LookupAsciiSymbol(
+        Vector<const char>(buffer.start(), length));
+  } else {
+    ScopedVector<uc16> buffer(length);
+    for (int i = 0; i < length; i++) {
+      buffer[i] = static_cast<uc16>(JsonCharAt(*source_, begin + i));
+    }
+    symbol = factory()->LookupTwoByteSymbol(
+        Vector<const uc16>(buffer.start(), length));
+  }
+  symbol_cache_->set(cache_index, *symbol);
+  position_ = end;
+  Advance();
+  return symbol;
+}
+
+} }  // namespace v8::internal
+
+#endif  // V8_JSON_PARSER_H_
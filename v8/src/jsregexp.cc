@@ -568,6 +568,223 @@ Handle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> jsregexp,
 }
 
 
+// Collects the capture registers of all matches of a global regexp in the
+// array that GlobalExec returns and caches.  The array is only allocated
+// once there is a match, and it is grown by doubling.
+class GlobalMatchBuilder {
+ public:
+  GlobalMatchBuilder(Isolate* isolate, int register_count)
+      : isolate_(isolate),
+        register_count_(register_count),
+        match_count_(0),
+        capacity_(0) { }
+
+  bool HasCapacity() { return match_count_ < capacity_; }
+
+  void EnsureCapacity() {
+    if (HasCapacity()) return;
+    int new_capacity = (capacity_ == 0) ? kInitialCapacity : capacity_ * 2;
+    Handle<FixedArray> new_array = isolate_->factory()->NewFixedArray(
+        RegExpImpl::kGlobalFirstMatch + new_capacity * register_count_);
+    if (capacity_ > 0) {
+      array_->CopyTo(0, *new_array, 0, array_->length());
+    }
+    array_ = new_array;
+    capacity_ = new_capacity;
+  }
+
+  void Add(int* registers) {
+    ASSERT(HasCapacity());
+    int offset = RegExpImpl::kGlobalFirstMatch + match_count_ * register_count_;
+    for (int i = 0; i < register_count_; i++) {
+      array_->set(offset + i, Smi::FromInt(registers[i]));
+    }
+    match_count_++;
+  }
+
+  // Returns the match array, or the null value if there were no matches.
+  Object* ToResult() {
+    if (match_count_ == 0) return isolate_->heap()->null_value();
+    array_->set(RegExpImpl::kGlobalRegisterCount,
+                Smi::FromInt(register_count_));
+    array_->set(RegExpImpl::kGlobalMatchCount, Smi::FromInt(match_count_));
+    return *array_;
+  }
+
+ private:
+  static const int kInitialCapacity = 8;
+
+  Isolate* isolate_;
+  Handle<FixedArray> array_;
+  int register_count_;
+  int match_count_;
+  int capacity_;
+};
+
+
+// Returns false if it ran out of space in the builder before the end of the
+// subject, in which case *pos is where the search must be resumed.
+template <typename SubjectChar, typename PatternChar>
+static bool AtomSearchGlobal(Isolate* isolate,
+                             Vector<const SubjectChar> subject,
+                             Vector<const PatternChar> pattern,
+                             GlobalMatchBuilder* builder,
+                             int* pos) {
+  int pattern_length = pattern.length();
+  int max_search_start = subject.length() - pattern_length;
+  StringSearch<PatternChar, SubjectChar> search(isolate, pattern);
+  while (*pos <= max_search_start) {
+    int index = search.Search(subject, *pos);
+    if (index < 0) break;
+    if (!builder->HasCapacity()) {
+      *pos = index;
+      return false;
+    }
+    int match[2] = { index, index + pattern_length };
+    builder->Add(match);
+    *pos = index + pattern_length;
+  }
+  return true;
+}
+
+
+static void AtomExecGlobal(Isolate* isolate,
+                           Handle<String> subject,
+                           Handle<String> needle,
+                           GlobalMatchBuilder* builder) {
+  ASSERT(subject->IsFlat());
+  if (needle->length() == 0) {
+    // The empty pattern matches at every position.
+    for (int i = 0; i <= subject->length(); i++) {
+      builder->EnsureCapacity();
+      int match[2] = { i, i };
+      builder->Add(match);
+    }
+    return;
+  }
+  int pos = 0;
+  while (true) {
+    AssertNoAllocation no_heap_allocation;  // ensure vectors stay valid
+    if (needle->IsAsciiRepresentation()) {
+      if (subject->IsAsciiRepresentation()) {
+        if (AtomSearchGlobal(isolate,
+                             subject->ToAsciiVector(),
+                             needle->ToAsciiVector(),
+                             builder,
+                             &pos)) break;
+      } else {
+        if (AtomSearchGlobal(isolate,
+                             subject->ToUC16Vector(),
+                             needle->ToAsciiVector(),
+                             builder,
+                             &pos)) break;
+      }
+    } else {
+      if (subject->IsAsciiRepresentation()) {
+        if (AtomSearchGlobal(isolate,
+                             subject->ToAsciiVector(),
+                             needle->ToUC16Vector(),
+                             builder,
+                             &pos)) break;
+      } else {
+        if (AtomSearchGlobal(isolate,
+                             subject->ToUC16Vector(),
+                             needle->ToUC16Vector(),
+                             builder,
+                             &pos)) break;
+      }
+    }
+    DisableAssertNoAllocation allow_allocation;
+    builder->EnsureCapacity();
+  }
+}
+
+
+// Returns false if executing the regexp threw an exception.
+static bool IrregexpExecGlobal(Handle<JSRegExp> regexp,
+                               Handle<String> subject,
+                               GlobalMatchBuilder* builder) {
+  int required_registers = RegExpImpl::IrregexpPrepare(regexp, subject);
+  if (required_registers < 0) return false;
+
+  OffsetsVector registers(required_registers);
+  Vector<int> register_vector(registers.vector(), registers.length());
+  int subject_length = subject->length();
+  int pos = 0;
+  while (true) {
+    RegExpImpl::IrregexpResult result =
+        RegExpImpl::IrregexpExecOnce(regexp, subject, pos, register_vector);
+    if (result == RegExpImpl::RE_EXCEPTION) return false;
+    if (result == RegExpImpl::RE_FAILURE) break;
+    builder->EnsureCapacity();
+    builder->Add(register_vector.start());
+    // Continue from where the match ended, unless it was an empty match.
+    int match_start = register_vector[0];
+    int match_end = register_vector[1];
+    pos = (match_start < match_end) ? match_end : match_end + 1;
+    if (pos > subject_length) break;
+  }
+  return true;
+}
+
+
+Handle<Object> RegExpImpl::GlobalExec(Handle<JSRegExp> regexp,
+                                      Handle<String> subject,
+                                      Handle<JSArray> last_match_info) {
+  ASSERT(regexp->GetFlags().is_global());
+  Isolate* isolate = regexp->GetIsolate();
+  Heap* heap = isolate->heap();
+  if (!subject->IsFlat()) FlattenString(subject);
+
+  // The cache is keyed on the flat contents, so a cons string that has been
+  // flattened hits the entry of its first part.
+  Handle<String> key = subject;
+  if (key->IsConsString()) {
+    key = Handle<String>(ConsString::cast(*subject)->first(), isolate);
+  }
+  Handle<FixedArray> regexp_data(FixedArray::cast(regexp->data()), isolate);
+
+  Object* cached = heap->GetRegExpResultsCache(*key, *regexp_data);
+  if (cached->IsUndefined()) {
+    isolate->counters()->regexp_results_cache_misses()->Increment();
+    if (regexp->TypeTag() == JSRegExp::ATOM) {
+      GlobalMatchBuilder builder(isolate, 2);
+      Handle<String> needle(
+          String::cast(regexp->DataAt(JSRegExp::kAtomPatternIndex)), isolate);
+      AtomExecGlobal(isolate, key, needle, &builder);
+      cached = builder.ToResult();
+    } else {
+      ASSERT_EQ(regexp->TypeTag(), JSRegExp::IRREGEXP);
+      GlobalMatchBuilder builder(isolate, (regexp->CaptureCount() + 1) * 2);
+      if (!IrregexpExecGlobal(regexp, subject, &builder)) {
+        ASSERT(isolate->has_pending_exception());
+        return Handle<Object>::null();
+      }
+      cached = builder.ToResult();
+    }
+    // Failures are cached as null.
+    heap->SetRegExpResultsCache(*key, *regexp_data, cached);
+  } else {
+    isolate->counters()->regexp_results_cache_hits()->Increment();
+  }
+  if (cached->IsNull()) return isolate->factory()->null_value();
+
+  Handle<FixedArray> matches(FixedArray::cast(cached), isolate);
+  int match_count = GlobalMatchCount(*matches);
+  int capture_register_count = GlobalRegisterCount(*matches);
+  last_match_info->EnsureSize(capture_register_count + kLastMatchOverhead);
+  AssertNoAllocation no_gc;
+  FixedArray* array = FixedArray::cast(last_match_info->elements());
+  for (int i = 0; i < capture_register_count; i++) {
+    SetCapture(array, i, GetGlobalCapture(*matches, match_count - 1, i));
+  }
+  SetLastCaptureCount(array, capture_register_count);
+  SetLastSubject(array, *subject);
+  SetLastInput(array, *subject);
+  return matches;
+}
+
+
 // -------------------------------------------------------------------
 // Implementation of the Irregexp regular expression engine.
 //
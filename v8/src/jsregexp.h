@@ -125,6 +125,38 @@ class RegExpImpl {
                                      int index,
                                      Handle<JSArray> lastMatchInfo);
 
+  // Finds all matches of a global regexp in the subject, the way
+  // String.prototype.replace and String.prototype.match step through them.
+  // On success the result is a FixedArray holding the number of capture
+  // registers per match and the number of matches, followed by the capture
+  // registers of every match, and lastMatchInfo is set to the last match.
+  // On a failure, the result is the null value.  Returns an empty handle in
+  // case of an exception.
+  // Results are cached on the heap per subject and regexp, so repeated
+  // global operations on the same string do not rerun the regexp.
+  static Handle<Object> GlobalExec(Handle<JSRegExp> regexp,
+                                   Handle<String> subject,
+                                   Handle<JSArray> lastMatchInfo);
+
+  // Used to access the match array returned by GlobalExec.
+  static const int kGlobalRegisterCount = 0;
+  static const int kGlobalMatchCount = 1;
+  static const int kGlobalFirstMatch = 2;
+
+  static int GlobalRegisterCount(FixedArray* matches) {
+    return Smi::cast(matches->get(kGlobalRegisterCount))->value();
+  }
+
+  static int GlobalMatchCount(FixedArray* matches) {
+    return Smi::cast(matches->get(kGlobalMatchCount))->value();
+  }
+
+  // Returns capture register 'index' of match number 'match'.
+  static int GetGlobalCapture(FixedArray* matches, int match, int index) {
+    int offset = kGlobalFirstMatch + match * GlobalRegisterCount(matches);
+    return Smi::cast(matches->get(offset + index))->value();
+  }
+
   // Array index in the lastMatchInfo array.
   static const int kLastCaptureCount = 0;
   static const int kLastSubject = 1;
@@ -110,15 +110,6 @@ bool UsePosition::RegisterIsBeneficial() const {
 }
 
 
-void UseInterval::SplitAt(LifetimePosition pos) {
-  ASSERT(Contains(pos) && pos.Value() != start().Value());
-  UseInterval* after = new UseInterval(pos, end_);
-  after->next_ = next_;
-  next_ = after;
-  end_ = pos;
-}
-
-
 #ifdef DEBUG
 
 
@@ -129,20 +120,11 @@ void LiveRange::Verify() const {
            cur->pos().Value() <= End().Value());
     cur = cur->next();
   }
-}
-
-
-bool LiveRange::HasOverlap(UseInterval* target) const {
-  UseInterval* current_interval = first_interval_;
-  while (current_interval != NULL) {
-    // Intervals overlap if the start of one is contained in the other.
-    if (current_interval->Contains(target->start()) ||
-        target->Contains(current_interval->start())) {
-      return true;
+  if (!intervals_reversed_) {
+    for (int i = 1; i < intervals_.length(); ++i) {
+      ASSERT(intervals_[i - 1].end().Value() <= intervals_[i].start().Value());
     }
-    current_interval = current_interval->next();
   }
-  return false;
 }
 
 
@@ -154,12 +136,11 @@ LiveRange::LiveRange(int id)
       spilled_(false),
       assigned_register_(kInvalidAssignment),
       assigned_register_kind_(NONE),
-      last_interval_(NULL),
-      first_interval_(NULL),
+      intervals_(0),
+      intervals_reversed_(true),
       first_pos_(NULL),
       parent_(NULL),
       next_(NULL),
-      current_interval_(NULL),
       last_processed_use_(NULL),
       spill_start_index_(kMaxInt) {
   spill_operand_ = new LUnallocated(LUnallocated::IGNORE);
@@ -267,63 +248,50 @@ LOperand* LiveRange::CreateAssignedOperand() {
 }
 
 
-UseInterval* LiveRange::FirstSearchIntervalForPosition(
-    LifetimePosition position) const {
-  if (current_interval_ == NULL) return first_interval_;
-  if (current_interval_->start().Value() > position.Value()) {
-    current_interval_ = NULL;
-    return first_interval_;
-  }
-  return current_interval_;
-}
-
-
-void LiveRange::AdvanceLastProcessedMarker(
-    UseInterval* to_start_of, LifetimePosition but_not_past) const {
-  if (to_start_of == NULL) return;
-  if (to_start_of->start().Value() > but_not_past.Value()) return;
-  LifetimePosition start =
-      current_interval_ == NULL ? LifetimePosition::Invalid()
-                                : current_interval_->start();
-  if (to_start_of->start().Value() > start.Value()) {
-    current_interval_ = to_start_of;
+int LiveRange::FirstIntervalEndingAfter(LifetimePosition position,
+                                        int from) const {
+  ASSERT(!intervals_reversed_);
+  // Intervals are disjoint and sorted by start, so their ends are sorted too.
+  int low = from;
+  int high = intervals_.length();
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    if (intervals_[mid].end().Value() > position.Value()) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
   }
+  return low;
 }
 
 
 void LiveRange::SplitAt(LifetimePosition position, LiveRange* result) {
   ASSERT(Start().Value() < position.Value());
   ASSERT(result->IsEmpty());
-  // Find the last interval that ends before the position. If the
-  // position is contained in one of the intervals in the chain, we
-  // split that interval and use the first part.
-  UseInterval* current = FirstSearchIntervalForPosition(position);
+  ASSERT(position.Value() < End().Value());
+  // Find the first interval that ends after the position. If the
+  // position is contained in it, we split that interval and keep the
+  // first part.
+  int index = FirstIntervalEndingAfter(position, 0);
+  UseInterval& current = intervals_[index];
 
   // If the split position coincides with the beginning of a use interval
   // we need to split use positons in a special way.
-  bool split_at_start = false;
-
-  while (current != NULL) {
-    if (current->Contains(position)) {
-      current->SplitAt(position);
-      break;
-    }
-    UseInterval* next = current->next();
-    if (next->start().Value() >= position.Value()) {
-      split_at_start = (next->start().Value() == position.Value());
-      break;
-    }
-    current = next;
-  }
+  bool split_at_start = (current.start().Value() == position.Value());
 
   // Partition original use intervals to the two live ranges.
-  UseInterval* before = current;
-  UseInterval* after = before->next();
-  result->last_interval_ = (last_interval_ == before)
-      ? after            // Only interval in the range after split.
-      : last_interval_;  // Last interval of the original range.
-  result->first_interval_ = after;
-  last_interval_ = before;
+  result->intervals_reversed_ = false;
+  int first_moved = index;
+  if (current.start().Value() < position.Value()) {
+    result->intervals_.Add(UseInterval(position, current.end()));
+    current.end_ = position;
+    first_moved++;
+  }
+  for (int i = first_moved; i < intervals_.length(); ++i) {
+    result->intervals_.Add(intervals_[i]);
+  }
+  intervals_.Rewind(first_moved);
 
   // Find the last use position before the split and the first use
   // position after it.
@@ -386,10 +354,12 @@ bool LiveRange::ShouldBeAllocatedBefore(const LiveRange* other) const {
 
 void LiveRange::ShortenTo(LifetimePosition start) {
   LAllocator::TraceAlloc("Shorten live range %d to [%d\n", id_, start.Value());
-  ASSERT(first_interval_ != NULL);
-  ASSERT(first_interval_->start().Value() <= start.Value());
-  ASSERT(start.Value() < first_interval_->end().Value());
-  first_interval_->set_start(start);
+  ASSERT(intervals_reversed_);
+  ASSERT(!IsEmpty());
+  UseInterval& first = intervals_.last();
+  ASSERT(first.start().Value() <= start.Value());
+  ASSERT(start.Value() < first.end().Value());
+  first.start_ = start;
 }
 
 
@@ -398,21 +368,16 @@ void LiveRange::EnsureInterval(LifetimePosition start, LifetimePosition end) {
                          id_,
                          start.Value(),
                          end.Value());
+  ASSERT(intervals_reversed_);
   LifetimePosition new_end = end;
-  while (first_interval_ != NULL &&
-         first_interval_->start().Value() <= end.Value()) {
-    if (first_interval_->end().Value() > end.Value()) {
-      new_end = first_interval_->end();
+  while (!intervals_.is_empty() &&
+         intervals_.last().start().Value() <= end.Value()) {
+    if (intervals_.last().end().Value() > end.Value()) {
+      new_end = intervals_.last().end();
     }
-    first_interval_ = first_interval_->next();
-  }
-
-  UseInterval* new_interval = new UseInterval(start, new_end);
-  new_interval->next_ = first_interval_;
-  first_interval_ = new_interval;
-  if (new_interval->next() == NULL) {
-    last_interval_ = new_interval;
+    intervals_.RemoveLast();
   }
+  intervals_.Add(UseInterval(start, new_end));
 }
 
 
@@ -421,29 +386,38 @@ void LiveRange::AddUseInterval(LifetimePosition start, LifetimePosition end) {
                          id_,
                          start.Value(),
                          end.Value());
-  if (first_interval_ == NULL) {
-    UseInterval* interval = new UseInterval(start, end);
-    first_interval_ = interval;
-    last_interval_ = interval;
+  ASSERT(intervals_reversed_);
+  if (intervals_.is_empty()) {
+    intervals_.Add(UseInterval(start, end));
   } else {
-    if (end.Value() == first_interval_->start().Value()) {
-      first_interval_->set_start(start);
-    } else if (end.Value() < first_interval_->start().Value()) {
-      UseInterval* interval = new UseInterval(start, end);
-      interval->set_next(first_interval_);
-      first_interval_ = interval;
+    UseInterval& first = intervals_.last();
+    if (end.Value() == first.start().Value()) {
+      first.start_ = start;
+    } else if (end.Value() < first.start().Value()) {
+      intervals_.Add(UseInterval(start, end));
     } else {
       // Order of instruction's processing (see ProcessInstructions) guarantees
       // that each new use interval either precedes or intersects with
       // last added interval.
-      ASSERT(start.Value() < first_interval_->end().Value());
-      first_interval_->start_ = Min(start, first_interval_->start_);
-      first_interval_->end_ = Max(end, first_interval_->end_);
+      ASSERT(start.Value() < first.end().Value());
+      first.start_ = Min(start, first.start_);
+      first.end_ = Max(end, first.end_);
     }
   }
 }
 
 
+void LiveRange::FinishBuilding() {
+  if (!intervals_reversed_) return;
+  for (int i = 0, j = intervals_.length() - 1; i < j; ++i, --j) {
+    UseInterval tmp = intervals_[i];
+    intervals_[i] = intervals_[j];
+    intervals_[j] = tmp;
+  }
+  intervals_reversed_ = false;
+}
+
+
 UsePosition* LiveRange::AddUsePosition(LifetimePosition pos,
                                        LOperand* operand) {
   LAllocator::TraceAlloc("Add to live range %d use position %d\n",
@@ -493,40 +467,31 @@ bool LiveRange::CanCover(LifetimePosition position) const {
 }
 
 
-bool LiveRange::Covers(LifetimePosition position) {
+bool LiveRange::Covers(LifetimePosition position) const {
   if (!CanCover(position)) return false;
-  UseInterval* start_search = FirstSearchIntervalForPosition(position);
-  for (UseInterval* interval = start_search;
-       interval != NULL;
-       interval = interval->next()) {
-    ASSERT(interval->next() == NULL ||
-           interval->next()->start().Value() >= interval->start().Value());
-    AdvanceLastProcessedMarker(interval, position);
-    if (interval->Contains(position)) return true;
-    if (interval->start().Value() > position.Value()) return false;
-  }
-  return false;
-}
-
-
-LifetimePosition LiveRange::FirstIntersection(LiveRange* other) {
-  UseInterval* b = other->first_interval();
-  if (b == NULL) return LifetimePosition::Invalid();
-  LifetimePosition advance_last_processed_up_to = b->start();
-  UseInterval* a = FirstSearchIntervalForPosition(b->start());
-  while (a != NULL && b != NULL) {
-    if (a->start().Value() > other->End().Value()) break;
-    if (b->start().Value() > End().Value()) break;
-    LifetimePosition cur_intersection = a->Intersect(b);
-    if (cur_intersection.IsValid()) {
-      return cur_intersection;
-    }
-    if (a->start().Value() < b->start().Value()) {
-      a = a->next();
-      if (a == NULL || a->start().Value() > other->End().Value()) break;
-      AdvanceLastProcessedMarker(a, advance_last_processed_up_to);
+  int index = FirstIntervalEndingAfter(position, 0);
+  return index < intervals_.length() && intervals_[index].Contains(position);
+}
+
+
+LifetimePosition LiveRange::FirstIntersection(const LiveRange* other) const {
+  if (IsEmpty() || other->IsEmpty()) return LifetimePosition::Invalid();
+  // Walk both sorted interval arrays in lock step, skipping over runs of
+  // intervals that end before the current interval of the other range
+  // with a binary search.
+  int a = FirstIntervalEndingAfter(other->Start(), 0);
+  int b = 0;
+  int a_count = intervals_.length();
+  int b_count = other->intervals_.length();
+  while (a < a_count && b < b_count) {
+    const UseInterval& a_interval = intervals_[a];
+    const UseInterval& b_interval = other->intervals_[b];
+    LifetimePosition cur_intersection = a_interval.Intersect(b_interval);
+    if (cur_intersection.IsValid()) return cur_intersection;
+    if (a_interval.start().Value() < b_interval.start().Value()) {
+      a = FirstIntervalEndingAfter(b_interval.start(), a + 1);
     } else {
-      b = b->next();
+      b = other->FirstIntervalEndingAfter(a_interval.start(), b + 1);
     }
   }
   return LifetimePosition::Invalid();
@@ -1303,6 +1268,19 @@ void LAllocator::BuildLiveRanges() {
     }
 #endif
   }
+
+  // Intervals were collected back to front; sort them for the allocator.
+  for (int i = 0; i < live_ranges_.length(); ++i) {
+    if (live_ranges_[i] != NULL) live_ranges_[i]->FinishBuilding();
+  }
+  for (int i = 0; i < fixed_live_ranges_.length(); ++i) {
+    LiveRange* range = fixed_live_ranges_[i];
+    if (range != NULL) range->FinishBuilding();
+  }
+  for (int i = 0; i < fixed_double_live_ranges_.length(); ++i) {
+    LiveRange* range = fixed_double_live_ranges_[i];
+    if (range != NULL) range->FinishBuilding();
+  }
 }
 
 
@@ -204,26 +204,21 @@ class UseIterator BASE_EMBEDDED {
 
 
 // Representation of the non-empty interval [start,end[.
-class UseInterval: public ZoneObject {
+class UseInterval {
  public:
   UseInterval(LifetimePosition start, LifetimePosition end)
-      : start_(start), end_(end), next_(NULL) {
+      : start_(start), end_(end) {
     ASSERT(start.Value() < end.Value());
   }
 
   LifetimePosition start() const { return start_; }
   LifetimePosition end() const { return end_; }
-  UseInterval* next() const { return next_; }
-
-  // Split this interval at the given position without effecting the
-  // live range that owns it. The interval must contain the position.
-  void SplitAt(LifetimePosition pos);
 
   // If this interval intersects with other return smallest position
   // that belongs to both of them.
-  LifetimePosition Intersect(const UseInterval* other) const {
-    if (other->start().Value() < start_.Value()) return other->Intersect(this);
-    if (other->start().Value() < end_.Value()) return other->start();
+  LifetimePosition Intersect(const UseInterval& other) const {
+    if (other.start().Value() < start_.Value()) return other.Intersect(*this);
+    if (other.start().Value() < end_.Value()) return other.start();
     return LifetimePosition::Invalid();
   }
 
@@ -232,14 +227,10 @@ class UseInterval: public ZoneObject {
   }
 
  private:
-  void set_start(LifetimePosition start) { start_ = start; }
-  void set_next(UseInterval* next) { next_ = next; }
-
   LifetimePosition start_;
   LifetimePosition end_;
-  UseInterval* next_;
 
-  friend class LiveRange;  // Assigns to start_.
+  friend class LiveRange;  // Assigns to start_ and end_.
 };
 
 // Representation of a use position.
@@ -280,7 +271,13 @@ class LiveRange: public ZoneObject {
 
   explicit LiveRange(int id);
 
-  UseInterval* first_interval() const { return first_interval_; }
+  // Use intervals of a live range are kept in a zone allocated array sorted
+  // by start position once the live ranges have been built.
+  int interval_count() const { return intervals_.length(); }
+  const UseInterval& interval_at(int index) const {
+    ASSERT(!intervals_reversed_);
+    return intervals_[index];
+  }
   UsePosition* first_pos() const { return first_pos_; }
   LiveRange* parent() const { return parent_; }
   LiveRange* TopLevel() { return (parent_ == NULL) ? this : parent_; }
@@ -288,7 +285,7 @@ class LiveRange: public ZoneObject {
   bool IsChild() const { return parent() != NULL; }
   int id() const { return id_; }
   bool IsFixed() const { return id_ < 0; }
-  bool IsEmpty() const { return first_interval() == NULL; }
+  bool IsEmpty() const { return intervals_.is_empty(); }
   LOperand* CreateAssignedOperand();
   int assigned_register() const { return assigned_register_; }
   int spill_start_index() const { return spill_start_index_; }
@@ -334,12 +331,12 @@ class LiveRange: public ZoneObject {
 
   LifetimePosition Start() const {
     ASSERT(!IsEmpty());
-    return first_interval()->start();
+    return FirstInterval().start();
   }
 
   LifetimePosition End() const {
     ASSERT(!IsEmpty());
-    return last_interval_->end();
+    return LastInterval().end();
   }
 
   bool HasAllocatedSpillOperand() const;
@@ -352,8 +349,8 @@ class LiveRange: public ZoneObject {
 
   bool ShouldBeAllocatedBefore(const LiveRange* other) const;
   bool CanCover(LifetimePosition position) const;
-  bool Covers(LifetimePosition position);
-  LifetimePosition FirstIntersection(LiveRange* other);
+  bool Covers(LifetimePosition position) const;
+  LifetimePosition FirstIntersection(const LiveRange* other) const;
 
   // Add a new interval or a new use position to this live range.
   void EnsureInterval(LifetimePosition start, LifetimePosition end);
@@ -363,29 +360,39 @@ class LiveRange: public ZoneObject {
   // Shorten the most recently added interval by setting a new start.
   void ShortenTo(LifetimePosition start);
 
+  // Put the intervals collected while building the live range into
+  // ascending order. No intervals can be added afterwards.
+  void FinishBuilding();
+
 #ifdef DEBUG
-  // True if target overlaps an existing interval.
-  bool HasOverlap(UseInterval* target) const;
   void Verify() const;
 #endif
 
  private:
   void ConvertOperands();
-  UseInterval* FirstSearchIntervalForPosition(LifetimePosition position) const;
-  void AdvanceLastProcessedMarker(UseInterval* to_start_of,
-                                  LifetimePosition but_not_past) const;
+
+  UseInterval& FirstInterval() const {
+    return intervals_reversed_ ? intervals_.last() : intervals_.first();
+  }
+  UseInterval& LastInterval() const {
+    return intervals_reversed_ ? intervals_.first() : intervals_.last();
+  }
+
+  // Binary search for the first interval at or after index from that ends
+  // after the given position. Returns interval_count() if there is none.
+  int FirstIntervalEndingAfter(LifetimePosition position, int from) const;
 
   int id_;
   bool spilled_;
   int assigned_register_;
   RegisterKind assigned_register_kind_;
-  UseInterval* last_interval_;
-  UseInterval* first_interval_;
+  // Liveness analysis visits instructions backwards, so intervals are
+  // appended in descending order until FinishBuilding reverses them.
+  ZoneList<UseInterval> intervals_;
+  bool intervals_reversed_;
   UsePosition* first_pos_;
   LiveRange* parent_;
   LiveRange* next_;
-  // This is used as a cache, it doesn't affect correctness.
-  mutable UseInterval* current_interval_;
   UsePosition* last_processed_use_;
   LOperand* spill_operand_;
   int spill_start_index_;
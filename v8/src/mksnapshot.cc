@@ -204,6 +204,40 @@ class CppByteSink : public i::SnapshotByteSink {
 };
 
 
+// Compiles and runs the embedder-provided script named by --extra-code in
+// the context that is about to be serialized, so that the objects it sets up
+// become part of the context snapshot instead of being rebuilt every time a
+// context is created.  Exits the process if the script cannot be run.
+static void RunExtraCode(Persistent<Context> context) {
+  const char* name = i::FLAG_extra_code;
+  bool exists;
+  i::Vector<const char> chars = i::ReadFile(name, &exists, false);
+  if (!exists) {
+    i::PrintF("Unable to read extra code file \"%s\"\n", name);
+    exit(1);
+  }
+  Context::Scope context_scope(context);
+  HandleScope scope;
+  TryCatch try_catch;
+  Local<Script> script =
+      Script::Compile(String::New(chars.start(), chars.length()),
+                      String::New(name));
+  if (!script.IsEmpty()) script->Run();
+  chars.Dispose();
+  if (try_catch.HasCaught()) {
+    String::Utf8Value exception(try_catch.Exception());
+    Local<Message> message = try_catch.Message();
+    if (message.IsEmpty()) {
+      i::PrintF("Failure running \"%s\": %s\n", name, *exception);
+    } else {
+      i::PrintF("%s:%d: %s\n",
+                name, message->GetLineNumber(), *exception);
+    }
+    exit(1);
+  }
+}
+
+
 int main(int argc, char** argv) {
 #ifdef ENABLE_LOGGING_AND_PROFILING
   // By default, log code create information in the snapshot.
@@ -226,6 +260,7 @@ int main(int argc, char** argv) {
       i::Isolate::Current()->bootstrapper()->NativesSourceLookup(i);
     }
   }
+  if (i::FLAG_extra_code != NULL) RunExtraCode(context);
   // If we don't do this then we end up with a stray root pointing at the
   // context even after we have disposed of the context.
   HEAP->CollectAllGarbage(true);
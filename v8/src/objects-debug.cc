@@ -317,6 +317,13 @@ void String::StringVerify() {
   if (IsSymbol()) {
     CHECK(!HEAP->InNewSpace(this));
   }
+  if (IsSlicedString()) {
+    SlicedString* slice = SlicedString::cast(this);
+    String* parent = slice->parent();
+    CHECK(parent->IsSeqString() || parent->IsExternalString());
+    CHECK(slice->offset() >= 0);
+    CHECK(slice->offset() + length() <= parent->length());
+  }
 }
 
 
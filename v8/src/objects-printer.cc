@@ -367,6 +367,8 @@ static const char* TypeToString(InstanceType type) {
     case STRING_TYPE: return "TWO_BYTE_STRING";
     case CONS_STRING_TYPE:
     case CONS_ASCII_STRING_TYPE: return "CONS_STRING";
+    case SLICED_STRING_TYPE:
+    case SLICED_ASCII_STRING_TYPE: return "SLICED_STRING";
     case EXTERNAL_ASCII_STRING_TYPE:
     case EXTERNAL_STRING_WITH_ASCII_DATA_TYPE:
     case EXTERNAL_STRING_TYPE: return "EXTERNAL_STRING";
@@ -28,6 +28,7 @@
 #ifdef ENABLE_LOGGING_AND_PROFILING
 
 #include "v8.h"
+#include "frames-inl.h"
 #include "global-handles.h"
 #include "heap-profiler.h"
 #include "scopeinfo.h"
@@ -488,48 +489,95 @@ void CpuProfile::Print() {
 
 
 CodeEntry* const CodeMap::kSharedFunctionCodeEntry = NULL;
-const CodeMap::CodeTreeConfig::Key CodeMap::CodeTreeConfig::kNoKey = NULL;
-const CodeMap::CodeTreeConfig::Value CodeMap::CodeTreeConfig::kNoValue =
-    CodeMap::CodeEntryInfo(NULL, 0);
 
 
-CodeEntry* CodeMap::FindEntry(Address addr) {
-  CodeTree::Locator locator;
-  if (tree_.FindGreatestLessThan(addr, &locator)) {
-    // locator.key() <= addr. Need to check that addr is within entry.
-    const CodeEntryInfo& entry = locator.value();
-    if (addr < (locator.key() + entry.size))
-      return entry.entry;
+int CodeMap::UpperBound(Address addr) {
+  int low = 0;
+  int high = entries_.length();
+  while (low < high) {
+    int mid = low + ((high - low) >> 1);
+    if (entries_[mid].start <= addr) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
   }
-  return NULL;
+  return low;
 }
 
 
-int CodeMap::GetSharedId(Address addr) {
-  CodeTree::Locator locator;
-  // For shared function entries, 'size' field is used to store their IDs.
-  if (tree_.Find(addr, &locator)) {
-    const CodeEntryInfo& entry = locator.value();
-    ASSERT(entry.entry == kSharedFunctionCodeEntry);
-    return entry.size;
+int CodeMap::IndexOf(Address addr) {
+  int index = UpperBound(addr) - 1;
+  return (index >= 0 && entries_[index].start == addr) ? index : -1;
+}
+
+
+void CodeMap::AddCode(Address addr, CodeEntry* entry, unsigned size) {
+  int index = UpperBound(addr);
+  if (index > 0 && entries_[index - 1].start == addr) {
+    entries_[index - 1] = CodeEntryInfo(addr, entry, size);
   } else {
-    tree_.Insert(addr, &locator);
-    int id = next_shared_id_++;
-    locator.set_value(CodeEntryInfo(kSharedFunctionCodeEntry, id));
-    return id;
+    entries_.InsertAt(index, CodeEntryInfo(addr, entry, size));
   }
 }
 
 
-void CodeMap::CodeTreePrinter::Call(
-    const Address& key, const CodeMap::CodeEntryInfo& value) {
-  OS::Print("%p %5d %s\n", key, value.size, value.entry->name());
+void CodeMap::MoveCode(Address from, Address to) {
+  int index = IndexOf(from);
+  if (index < 0) return;
+  CodeEntryInfo info = entries_[index];
+  info.start = to;
+  // The compactor preserves the relative order of code objects, so
+  // usually the entry can be updated in place.
+  if ((index == 0 || entries_[index - 1].start < to) &&
+      (index == entries_.length() - 1 || to < entries_[index + 1].start)) {
+    entries_[index] = info;
+    return;
+  }
+  entries_.Remove(index);
+  // If the target address is already occupied, keep the existing entry.
+  int to_index = UpperBound(to);
+  if (to_index > 0 && entries_[to_index - 1].start == to) return;
+  entries_.InsertAt(to_index, info);
+}
+
+
+void CodeMap::DeleteCode(Address addr) {
+  int index = IndexOf(addr);
+  if (index >= 0) entries_.Remove(index);
+}
+
+
+CodeEntry* CodeMap::FindEntry(Address addr) {
+  int index = UpperBound(addr) - 1;
+  if (index < 0) return NULL;
+  // entries_[index].start <= addr. Need to check that addr is within entry.
+  const CodeEntryInfo& info = entries_[index];
+  if (addr < (info.start + info.size)) return info.entry;
+  return NULL;
+}
+
+
+int CodeMap::GetSharedId(Address addr) {
+  // For shared function entries, 'size' field is used to store their IDs.
+  int index = IndexOf(addr);
+  if (index >= 0) {
+    const CodeEntryInfo& info = entries_[index];
+    ASSERT(info.entry == kSharedFunctionCodeEntry);
+    return info.size;
+  }
+  int id = next_shared_id_++;
+  AddCode(addr, kSharedFunctionCodeEntry, id);
+  return id;
 }
 
 
 void CodeMap::Print() {
-  CodeTreePrinter printer;
-  tree_.ForEach(&printer);
+  for (int i = 0; i < entries_.length(); i++) {
+    const CodeEntryInfo& info = entries_[i];
+    OS::Print("%p %5d %s\n", info.start, info.size,
+              info.entry != NULL ? info.entry->name() : "(shared)");
+  }
 }
 
 
@@ -893,6 +941,96 @@ void ProfileGenerator::RecordTickSample(const TickSample& sample) {
 }
 
 
+AllocationProfileNode::AllocationProfileNode(const char* name,
+                                             const char* resource_name,
+                                             int position,
+                                             int line_number)
+    : name_(name),
+      resource_name_(resource_name),
+      position_(position),
+      line_number_(line_number),
+      self_size_(0),
+      self_samples_(0),
+      children_(0) {
+}
+
+
+static void DeleteAllocationProfileNode(AllocationProfileNode** node_ptr) {
+  delete *node_ptr;
+}
+
+
+AllocationProfileNode::~AllocationProfileNode() {
+  children_.Iterate(DeleteAllocationProfileNode);
+}
+
+
+AllocationProfileNode* AllocationProfileNode::FindChild(
+    const char* name, const char* resource_name, int position) {
+  // Names come from the same strings storage, so pointers can be compared.
+  for (int i = 0; i < children_.length(); i++) {
+    AllocationProfileNode* child = children_[i];
+    if (child->position_ == position &&
+        child->name_ == name &&
+        child->resource_name_ == resource_name) {
+      return child;
+    }
+  }
+  return NULL;
+}
+
+
+AllocationProfileNode* AllocationProfileNode::AddChild(
+    const char* name,
+    const char* resource_name,
+    int position,
+    int line_number) {
+  AllocationProfileNode* child =
+      new AllocationProfileNode(name, resource_name, position, line_number);
+  children_.Add(child);
+  return child;
+}
+
+
+AllocationProfile::AllocationProfile(int sample_interval)
+    : sample_interval_(sample_interval),
+      root_("", "", 0, v8::AllocationProfileNode::kNoLineNumberInfo),
+      stack_(16) {
+}
+
+
+void AllocationProfile::RecordSample(Isolate* isolate, intptr_t size) {
+  HandleScope scope(isolate);
+  AssertNoAllocation no_allocation;
+  stack_.Clear();
+  for (StackTraceFrameIterator it(isolate); !it.done(); it.Advance()) {
+    stack_.Add(JSFunction::cast(it.frame()->function()));
+  }
+  AllocationProfileNode* node = &root_;
+  // Walk from the outermost frame down to the allocating function.
+  for (int i = stack_.length() - 1; i >= 0; i--) {
+    SharedFunctionInfo* shared = stack_[i]->shared();
+    Script* script = Script::cast(shared->script());
+    const char* name = names_.GetFunctionName(shared->DebugName());
+    const char* resource_name = script->name()->IsString()
+        ? names_.GetName(String::cast(script->name()))
+        : "";
+    int position = shared->start_position();
+    AllocationProfileNode* child =
+        node->FindChild(name, resource_name, position);
+    if (child == NULL) {
+      // Only look up the line number for new nodes, as it may require
+      // scanning the script source.
+      int line_number = GetScriptLineNumberSafe(Handle<Script>(script),
+                                                position) + 1;
+      child = node->AddChild(name, resource_name, position, line_number);
+    }
+    node = child;
+  }
+  node->AddSample(size);
+}
+
+
 void HeapGraphEdge::Init(
     int child_index, Type type, const char* name, HeapEntry* to) {
   ASSERT(type == kContextVariable
@@ -1529,6 +1667,22 @@ void HeapEntriesMap::AllocateEntries() {
 }
 
 
+void HeapEntriesMap::AllocateEntriesWithoutReferences(
+    List<int>* children_counts) {
+  for (HashMap::Entry* p = entries_.Start();
+       p != NULL;
+       p = entries_.Next(p)) {
+    EntryInfo* entry_info = reinterpret_cast<EntryInfo*>(p->value);
+    entry_info->entry = entry_info->allocator->AllocateEntry(p->key, 0, 0);
+    ASSERT(entry_info->entry != NULL);
+    ASSERT(entry_info->entry != kHeapEntryPlaceholder);
+    children_counts->Add(entry_info->children_count);
+    entry_info->children_count = 0;
+    entry_info->retainers_count = 0;
+  }
+}
+
+
 HeapEntry* HeapEntriesMap::Map(HeapThing thing) {
   HashMap::Entry* cache_entry = entries_.Lookup(thing, Hash(thing), false);
   if (cache_entry != NULL) {
@@ -1856,6 +2010,11 @@ void V8HeapExplorer::ExtractReferences(HeapObject* obj) {
       ConsString* cs = ConsString::cast(obj);
       SetInternalReference(obj, entry, 1, cs->first());
       SetInternalReference(obj, entry, 2, cs->second());
+    } else if (obj->IsSlicedString()) {
+      SlicedString* ss = SlicedString::cast(obj);
+      SetInternalReference(obj, entry,
+                           "parent", ss->parent(),
+                           SlicedString::kParentOffset);
     }
   } else if (obj->IsMap()) {
     Map* map = Map::cast(obj);
@@ -2549,6 +2708,260 @@ bool HeapSnapshotGenerator::GenerateSnapshot() {
 }
 
 
+// Collects the references of a window of entries [first, last) in the
+// order of the nodes array. References of other entries are dropped,
+// they are collected by the traversals for their own windows.
+class SnapshotStreamingFiller : public SnapshotFillerInterface {
+ public:
+  SnapshotStreamingFiller(HeapEntriesMap* entries,
+                          HeapSnapshotsCollection* collection,
+                          HeapSnapshotJSONSerializer* serializer,
+                          const List<int>& children_counts,
+                          const List<int>& node_indexes,
+                          int first,
+                          int last)
+      : entries_(entries),
+        collection_(collection),
+        serializer_(serializer),
+        node_indexes_(node_indexes),
+        first_(first),
+        last_(last),
+        offsets_(last - first + 1),
+        filled_(last - first),
+        overflowed_(false) {
+    offsets_.Add(0);
+    for (int i = first; i < last; ++i) {
+      offsets_.Add(offsets_.last() + children_counts[i]);
+      filled_.Add(0);
+    }
+    references_ = NewArray<int>(
+        Max(1, offsets_.last() * HeapSnapshotJSONSerializer::kEdgeFieldsCount));
+  }
+  ~SnapshotStreamingFiller() { DeleteArray(references_); }
+
+  const int* references(int position) {
+    return references_ + offsets_[position - first_] *
+        HeapSnapshotJSONSerializer::kEdgeFieldsCount;
+  }
+  int references_count(int position) { return filled_[position - first_]; }
+  bool overflowed() { return overflowed_; }
+
+  HeapEntry* AddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) {
+    UNREACHABLE();
+    return NULL;
+  }
+  HeapEntry* FindEntry(HeapThing ptr) {
+    return entries_->Map(ptr);
+  }
+  HeapEntry* FindOrAddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) {
+    HeapEntry* entry = FindEntry(ptr);
+    return entry != NULL ? entry : AddEntry(ptr, allocator);
+  }
+  void SetIndexedReference(HeapGraphEdge::Type type,
+                           HeapThing,
+                           HeapEntry* parent_entry,
+                           int index,
+                           HeapThing,
+                           HeapEntry* child_entry) {
+    int child_index;
+    int* reference = NextReference(parent_entry, &child_index);
+    if (reference != NULL) SetReference(reference, type, index, child_entry);
+  }
+  void SetIndexedAutoIndexReference(HeapGraphEdge::Type type,
+                                    HeapThing,
+                                    HeapEntry* parent_entry,
+                                    HeapThing,
+                                    HeapEntry* child_entry) {
+    int child_index;
+    int* reference = NextReference(parent_entry, &child_index);
+    if (reference != NULL) {
+      SetReference(reference, type, child_index + 1, child_entry);
+    }
+  }
+  void SetNamedReference(HeapGraphEdge::Type type,
+                         HeapThing,
+                         HeapEntry* parent_entry,
+                         const char* reference_name,
+                         HeapThing,
+                         HeapEntry* child_entry) {
+    int child_index;
+    int* reference = NextReference(parent_entry, &child_index);
+    if (reference != NULL) {
+      SetReference(reference,
+                   type,
+                   serializer_->GetStringId(reference_name),
+                   child_entry);
+    }
+  }
+  void SetNamedAutoIndexReference(HeapGraphEdge::Type type,
+                                  HeapThing,
+                                  HeapEntry* parent_entry,
+                                  HeapThing,
+                                  HeapEntry* child_entry) {
+    int child_index;
+    int* reference = NextReference(parent_entry, &child_index);
+    if (reference != NULL) {
+      const char* name = collection_->names()->GetName(child_index + 1);
+      SetReference(reference,
+                   type,
+                   serializer_->GetStringId(name),
+                   child_entry);
+    }
+  }
+
+ private:
+  // Entries' ordered indexes hold their positions in the nodes array.
+  int* NextReference(HeapEntry* parent_entry, int* child_index) {
+    int position = parent_entry->ordered_index();
+    if (position < first_ || position >= last_) return NULL;
+    int window_position = position - first_;
+    *child_index = filled_[window_position]++;
+    // The references of an entry must match the count taken by the first
+    // pass, more of them would be written past the entry's slice.
+    if (offsets_[window_position] + *child_index >=
+        offsets_[window_position + 1]) {
+      overflowed_ = true;
+      return NULL;
+    }
+    return references_ + (offsets_[window_position] + *child_index) *
+        HeapSnapshotJSONSerializer::kEdgeFieldsCount;
+  }
+  void SetReference(int* reference,
+                    HeapGraphEdge::Type type,
+                    int name_or_index,
+                    HeapEntry* child_entry) {
+    reference[0] = type;
+    reference[1] = name_or_index;
+    reference[2] = node_indexes_[child_entry->ordered_index()];
+  }
+
+  HeapEntriesMap* entries_;
+  HeapSnapshotsCollection* collection_;
+  HeapSnapshotJSONSerializer* serializer_;
+  const List<int>& node_indexes_;
+  int first_;
+  int last_;
+  List<int> offsets_;
+  List<int> filled_;
+  bool overflowed_;
+  int* references_;
+
+  DISALLOW_COPY_AND_ASSIGN(SnapshotStreamingFiller);
+};
+
+
+bool HeapSnapshotGenerator::StreamSnapshot(v8::OutputStream* stream) {
+  AssertNoAllocation no_alloc;
+
+  SetProgressTotal(1);
+
+  // Pass 1. Iterate heap contents to count entries and references.
+  if (!CountEntriesAndReferences()) return false;
+
+  // Only node attributes are kept in the snapshot, references go
+  // straight to the stream.
+  snapshot_->AllocateEntries(entries_.entries_count(), 0, 0);
+  List<int> children_counts(entries_.entries_count());
+  entries_.AllocateEntriesWithoutReferences(&children_counts);
+
+  // The root must be the first node. The ordered index of every entry is
+  // its position in the nodes array, node_indexes maps it to the index of
+  // the node's first field, which is how references address nodes.
+  List<HeapEntry*>* entries = snapshot_->entries();
+  int root_position = 0;
+  while (entries->at(root_position) != snapshot_->root()) ++root_position;
+  entries->at(root_position) = entries->at(0);
+  entries->at(0) = snapshot_->root();
+  int root_children_count = children_counts[root_position];
+  children_counts[root_position] = children_counts[0];
+  children_counts[0] = root_children_count;
+  List<int> node_indexes(entries->length());
+  int node_index = HeapSnapshotJSONSerializer::kFirstNodeIndex;
+  for (int i = 0; i < entries->length(); ++i) {
+    entries->at(i)->set_ordered_index(i);
+    node_indexes.Add(node_index);
+    node_index += HeapSnapshotJSONSerializer::kNodeFieldsCount +
+        children_counts[i] * HeapSnapshotJSONSerializer::kEdgeFieldsCount;
+  }
+
+  // Pass 2 and on. Each traversal of the heap buffers the references of
+  // as many nodes as fit in the window and writes those nodes out.
+  int windows_count = 0;
+  int window_references = 0;
+  for (int i = 0; i < entries->length(); ++i) {
+    if (i == 0 || window_references + children_counts[i] >
+        FLAG_heap_snapshot_stream_window) {
+      ++windows_count;
+      window_references = 0;
+    }
+    window_references += children_counts[i];
+  }
+  int progress_counter = progress_counter_;
+  SetProgressTotal(windows_count + 1);
+  progress_counter_ = progress_counter;
+
+  HeapSnapshotJSONSerializer serializer(snapshot_);
+  serializer.BeginStreaming(stream);
+  bool completed = true;
+  int first = 0;
+  while (first < entries->length()) {
+    int last = first;
+    window_references = 0;
+    do {
+      window_references += children_counts[last++];
+    } while (last < entries->length() &&
+             window_references + children_counts[last] <=
+                 FLAG_heap_snapshot_stream_window);
+    if (!StreamNodes(&serializer, children_counts, node_indexes, first, last)) {
+      completed = false;
+      break;
+    }
+    if (serializer.aborted()) break;
+    first = last;
+  }
+  // The stream is ended even if the generation was aborted, unless the
+  // stream itself asked to stop.
+  bool stream_aborted = serializer.aborted();
+  serializer.EndStreaming(completed);
+  if (!completed) return false;
+  if (stream_aborted) return true;
+
+  progress_counter_ = progress_total_;
+  return ProgressReport(true);
+}
+
+
+bool HeapSnapshotGenerator::StreamNodes(
+    HeapSnapshotJSONSerializer* serializer,
+    const List<int>& children_counts,
+    const List<int>& node_indexes,
+    int first,
+    int last) {
+  SnapshotStreamingFiller filler(&entries_,
+                                 snapshot_->collection(),
+                                 serializer,
+                                 children_counts,
+                                 node_indexes,
+                                 first,
+                                 last);
+  if (!v8_heap_explorer_.IterateAndExtractReferences(&filler) ||
+      !dom_explorer_.IterateAndExtractReferences(&filler) ||
+      filler.overflowed()) {
+    return false;
+  }
+  List<HeapEntry*>* entries = snapshot_->entries();
+  for (int i = first; i < last; ++i) {
+    if (filler.references_count(i) != children_counts[i]) return false;
+  }
+  for (int i = first; i < last; ++i) {
+    serializer->StreamNode(
+        entries->at(i), filler.references(i), filler.references_count(i));
+    if (serializer->aborted()) break;
+  }
+  return true;
+}
+
+
 void HeapSnapshotGenerator::ProgressStep() {
   ++progress_counter_;
 }
@@ -2794,6 +3207,11 @@ class OutputStreamWriter {
   bool aborted_;
 };
 
+HeapSnapshotJSONSerializer::~HeapSnapshotJSONSerializer() {
+  delete writer_;
+}
+
+
 void HeapSnapshotJSONSerializer::Serialize(v8::OutputStream* stream) {
   ASSERT(writer_ == NULL);
   writer_ = new OutputStreamWriter(stream);
@@ -2808,15 +3226,75 @@ void HeapSnapshotJSONSerializer::Serialize(v8::OutputStream* stream) {
 }
 
 
+void HeapSnapshotJSONSerializer::BeginStreaming(v8::OutputStream* stream) {
+  ASSERT(writer_ == NULL);
+  writer_ = new OutputStreamWriter(stream);
+  SerializeHeader();
+}
+
+
+void HeapSnapshotJSONSerializer::StreamNode(HeapEntry* entry,
+                                            const int* references,
+                                            int count) {
+  writer_->AddCharacter('\n');
+  writer_->AddCharacter(',');
+  writer_->AddNumber(entry->type());
+  writer_->AddCharacter(',');
+  writer_->AddNumber(GetStringId(entry->name()));
+  writer_->AddCharacter(',');
+  writer_->AddNumber(entry->id());
+  writer_->AddCharacter(',');
+  writer_->AddNumber(entry->self_size());
+  writer_->AddCharacter(',');
+  writer_->AddNumber(entry->self_size());
+  writer_->AddCharacter(',');
+  writer_->AddNumber(kFirstNodeIndex);
+  writer_->AddCharacter(',');
+  writer_->AddNumber(count);
+  for (int i = 0; i < count * kEdgeFieldsCount; ++i) {
+    writer_->AddCharacter(',');
+    writer_->AddNumber(references[i]);
+  }
+}
+
+
+void HeapSnapshotJSONSerializer::EndStreaming(bool completed) {
+  if (completed) {
+    if (!writer_->aborted()) SerializeFooter();
+  } else {
+    writer_->Finalize();
+  }
+  delete writer_;
+  writer_ = NULL;
+}
+
+
+bool HeapSnapshotJSONSerializer::aborted() {
+  return writer_->aborted();
+}
+
+
 void HeapSnapshotJSONSerializer::SerializeImpl() {
+  SerializeHeader();
+  if (writer_->aborted()) return;
+  SerializeNodes();
+  if (writer_->aborted()) return;
+  SerializeFooter();
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeHeader() {
   writer_->AddCharacter('{');
   writer_->AddString("\"snapshot\":{");
   SerializeSnapshot();
   if (writer_->aborted()) return;
   writer_->AddString("},\n");
   writer_->AddString("\"nodes\":[");
-  SerializeNodes();
-  if (writer_->aborted()) return;
+  SerializeNodeFields();
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeFooter() {
   writer_->AddString("],\n");
   writer_->AddString("\"strings\":[");
   SerializeStrings();
@@ -2904,7 +3382,7 @@ void HeapSnapshotJSONSerializer::SerializeNode(HeapEntry* entry) {
 }
 
 
-void HeapSnapshotJSONSerializer::SerializeNodes() {
+void HeapSnapshotJSONSerializer::SerializeNodeFields() {
   // The first (zero) item of nodes array is an object describing node
   // serialization layout.  We use a set of macros to improve
   // readability.
@@ -2956,22 +3434,24 @@ void HeapSnapshotJSONSerializer::SerializeNodes() {
 #undef JSON_S
 #undef JSON_O
 #undef JSON_A
+}
 
-  const int node_fields_count = 7;
-  // type,name,id,self_size,retained_size,dominator,children_count.
-  const int edge_fields_count = 3;  // type,name|index,to_node.
+
+void HeapSnapshotJSONSerializer::SerializeNodes() {
+  // Node fields are type, name, id, self_size, retained_size, dominator
+  // and children_count, edge fields are type, name or index and to_node.
   List<HashMap::Entry*> sorted_nodes;
   SortHashMap(&nodes_, &sorted_nodes);
   // Rewrite node ids, so they refer to actual array positions.
   if (sorted_nodes.length() > 1) {
     // Nodes start from array index 1.
-    int prev_value = 1;
+    int prev_value = kFirstNodeIndex;
     sorted_nodes[0]->value = reinterpret_cast<void*>(prev_value);
     for (int i = 1; i < sorted_nodes.length(); ++i) {
       HeapEntry* prev_heap_entry =
           reinterpret_cast<HeapEntry*>(sorted_nodes[i-1]->key);
-      prev_value += node_fields_count +
-          prev_heap_entry->children().length() * edge_fields_count;
+      prev_value += kNodeFieldsCount +
+          prev_heap_entry->children().length() * kEdgeFieldsCount;
       sorted_nodes[i]->value = reinterpret_cast<void*>(prev_value);
     }
   }
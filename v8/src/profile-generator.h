@@ -236,12 +236,17 @@ class CpuProfile {
 };
 
 
+// Maps code addresses to code entries. Entries are kept in an array
+// sorted by start address, so lookups done for every tick sample are
+// binary searches over contiguous memory. Code objects are mostly
+// created at increasing addresses and moved by the compactor without
+// changing their relative order, which keeps insertions and moves cheap.
 class CodeMap {
  public:
   CodeMap() : next_shared_id_(1) { }
-  INLINE(void AddCode(Address addr, CodeEntry* entry, unsigned size));
-  INLINE(void MoveCode(Address from, Address to));
-  INLINE(void DeleteCode(Address addr));
+  void AddCode(Address addr, CodeEntry* entry, unsigned size);
+  void MoveCode(Address from, Address to);
+  void DeleteCode(Address addr);
   CodeEntry* FindEntry(Address addr);
   int GetSharedId(Address addr);
 
@@ -249,32 +254,22 @@ class CodeMap {
 
  private:
   struct CodeEntryInfo {
-    CodeEntryInfo(CodeEntry* an_entry, unsigned a_size)
-        : entry(an_entry), size(a_size) { }
+    CodeEntryInfo(Address a_start, CodeEntry* an_entry, unsigned a_size)
+        : start(a_start), entry(an_entry), size(a_size) { }
+    Address start;
     CodeEntry* entry;
     unsigned size;
   };
 
-  struct CodeTreeConfig {
-    typedef Address Key;
-    typedef CodeEntryInfo Value;
-    static const Key kNoKey;
-    static const Value kNoValue;
-    static int Compare(const Key& a, const Key& b) {
-      return a < b ? -1 : (a > b ? 1 : 0);
-    }
-  };
-  typedef SplayTree<CodeTreeConfig> CodeTree;
-
-  class CodeTreePrinter {
-   public:
-    void Call(const Address& key, const CodeEntryInfo& value);
-  };
+  // Returns the index of the first entry starting above addr.
+  int UpperBound(Address addr);
+  // Returns the index of the entry starting at addr, or -1.
+  int IndexOf(Address addr);
 
   // Fake CodeEntry pointer to distinguish shared function entries.
   static CodeEntry* const kSharedFunctionCodeEntry;
 
-  CodeTree tree_;
+  List<CodeEntryInfo> entries_;
   int next_shared_id_;
 
   DISALLOW_COPY_AND_ASSIGN(CodeMap);
@@ -351,8 +346,8 @@ class CpuProfilesCollection {
 class SampleRateCalculator {
  public:
   SampleRateCalculator()
-      : result_(Logger::kSamplingIntervalMs * kResultScale),
-        ticks_per_ms_(Logger::kSamplingIntervalMs),
+      : result_(Logger::SamplingIntervalMs() * kResultScale),
+        ticks_per_ms_(Logger::SamplingIntervalMs()),
         measurements_count_(0),
         wall_time_query_countdown_(1) {
   }
@@ -443,6 +438,72 @@ class ProfileGenerator {
 };
 
 
+// A node of the allocation call tree. Nodes stand for JS functions, which
+// are told apart by name, script and position in the script, so functions
+// survive being moved by the GC.
+class AllocationProfileNode {
+ public:
+  AllocationProfileNode(const char* name,
+                        const char* resource_name,
+                        int position,
+                        int line_number);
+  ~AllocationProfileNode();
+
+  AllocationProfileNode* FindChild(const char* name,
+                                   const char* resource_name,
+                                   int position);
+  AllocationProfileNode* AddChild(const char* name,
+                                  const char* resource_name,
+                                  int position,
+                                  int line_number);
+  void AddSample(intptr_t size) {
+    self_size_ += size;
+    ++self_samples_;
+  }
+
+  const char* name() const { return name_; }
+  const char* resource_name() const { return resource_name_; }
+  int line_number() const { return line_number_; }
+  intptr_t self_size() const { return self_size_; }
+  int self_samples() const { return self_samples_; }
+  const List<AllocationProfileNode*>* children() const { return &children_; }
+
+ private:
+  const char* name_;
+  const char* resource_name_;
+  int position_;
+  int line_number_;
+  intptr_t self_size_;
+  int self_samples_;
+  List<AllocationProfileNode*> children_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationProfileNode);
+};
+
+
+// Collects the JS stacks of sampled allocations into a call tree.
+class AllocationProfile {
+ public:
+  explicit AllocationProfile(int sample_interval);
+
+  // Adds the current JS stack to the tree, charging it with the given
+  // number of bytes. Called from within the allocator, so it must not
+  // allocate in the JS heap.
+  void RecordSample(Isolate* isolate, intptr_t size);
+
+  int sample_interval() const { return sample_interval_; }
+  const AllocationProfileNode* root() const { return &root_; }
+
+ private:
+  int sample_interval_;
+  StringsStorage names_;
+  AllocationProfileNode root_;
+  List<JSFunction*> stack_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationProfile);
+};
+
+
 class HeapEntry;
 
 class HeapGraphEdge BASE_EMBEDDED {
@@ -807,6 +868,10 @@ class HeapEntriesMap {
   ~HeapEntriesMap();
 
   void AllocateEntries();
+  // Allocates entries that have no room for references. The number of
+  // children counted for each entry is appended to children_counts in
+  // the order the entries are allocated in the snapshot.
+  void AllocateEntriesWithoutReferences(List<int>* children_counts);
   HeapEntry* Map(HeapThing thing);
   void Pair(HeapThing thing, HeapEntriesAllocator* allocator, HeapEntry* entry);
   void CountReference(HeapThing from, HeapThing to,
@@ -1035,11 +1100,16 @@ class NativeObjectsExplorer : public HeapEntriesAllocator {
 };
 
 
+class HeapSnapshotJSONSerializer;
+
 class HeapSnapshotGenerator : public SnapshottingProgressReportingInterface {
  public:
   HeapSnapshotGenerator(HeapSnapshot* snapshot,
                         v8::ActivityControl* control);
   bool GenerateSnapshot();
+  // Writes the snapshot to the stream in JSON format while the heap is
+  // traversed, without building the graph of references in memory.
+  bool StreamSnapshot(v8::OutputStream* stream);
 
  private:
   bool ApproximateRetainedSizes();
@@ -1052,6 +1122,11 @@ class HeapSnapshotGenerator : public SnapshottingProgressReportingInterface {
   bool ProgressReport(bool force = false);
   bool SetEntriesDominators();
   void SetProgressTotal(int iterations_count);
+  bool StreamNodes(HeapSnapshotJSONSerializer* serializer,
+                   const List<int>& children_counts,
+                   const List<int>& node_indexes,
+                   int first,
+                   int last);
 
   HeapSnapshot* snapshot_;
   v8::ActivityControl* control_;
@@ -1078,8 +1153,25 @@ class HeapSnapshotJSONSerializer {
         next_string_id_(1),
         writer_(NULL) {
   }
+  ~HeapSnapshotJSONSerializer();
   void Serialize(v8::OutputStream* stream);
 
+  // Serialization of a snapshot that is not kept in memory: nodes are
+  // passed one by one in the order of the nodes array, together with
+  // their references already encoded as (type, name or index, to_node)
+  // triples. Dominators and retained sizes are not known, so every node
+  // is reported as dominated by the root and retaining only itself.
+  void BeginStreaming(v8::OutputStream* stream);
+  void StreamNode(HeapEntry* entry, const int* references, int count);
+  // Writes the footer if the generation completed, and ends the stream.
+  void EndStreaming(bool completed);
+  bool aborted();
+  int GetStringId(const char* s);
+
+  static const int kNodeFieldsCount = 7;
+  static const int kEdgeFieldsCount = 3;
+  static const int kFirstNodeIndex = 1;
+
  private:
   INLINE(static bool ObjectsMatch(void* key1, void* key2)) {
     return key1 == key2;
@@ -1092,10 +1184,12 @@ class HeapSnapshotJSONSerializer {
 
   void EnumerateNodes();
   int GetNodeId(HeapEntry* entry);
-  int GetStringId(const char* s);
   void SerializeEdge(HeapGraphEdge* edge);
+  void SerializeFooter();
+  void SerializeHeader();
   void SerializeImpl();
   void SerializeNode(HeapEntry* entry);
+  void SerializeNodeFields();
   void SerializeNodes();
   void SerializeSnapshot();
   void SerializeString(const unsigned char* s);
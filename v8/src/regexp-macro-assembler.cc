@@ -74,10 +74,16 @@ bool NativeRegExpMacroAssembler::CanReadUnaligned() {
 const byte* NativeRegExpMacroAssembler::StringCharacterPosition(
     String* subject,
     int start_index) {
-  // Not just flat, but ultra flat.
-  ASSERT(subject->IsExternalString() || subject->IsSeqString());
   ASSERT(start_index >= 0);
   ASSERT(start_index <= subject->length());
+  // A sliced string reads its characters straight out of its parent.
+  if (StringShape(subject).IsSliced()) {
+    SlicedString* slice = SlicedString::cast(subject);
+    start_index += slice->offset();
+    subject = slice->parent();
+  }
+  // Not just flat, but ultra flat.
+  ASSERT(subject->IsExternalString() || subject->IsSeqString());
   if (subject->IsAsciiRepresentation()) {
     const byte* address;
     if (StringShape(subject).IsExternal()) {
@@ -130,8 +136,11 @@ NativeRegExpMacroAssembler::Result NativeRegExpMacroAssembler::Match(
   }
   // Ensure that an underlying string has the same ascii-ness.
   bool is_ascii = subject_ptr->IsAsciiRepresentation();
-  ASSERT(subject_ptr->IsExternalString() || subject_ptr->IsSeqString());
-  // String is now either Sequential or External
+  ASSERT(subject_ptr->IsExternalString() ||
+         subject_ptr->IsSeqString() ||
+         subject_ptr->IsSlicedString());
+  // String is now either Sequential, External or Sliced.  A sliced subject
+  // is passed on as is so that captures stay relative to the slice.
   int char_size_shift = is_ascii ? 0 : 1;
   int char_length = end_offset - start_offset;
 
@@ -41,6 +41,7 @@
 #include "deoptimizer.h"
 #include "execution.h"
 #include "global-handles.h"
+#include "json-parser.h"
 #include "jsregexp.h"
 #include "liveedit.h"
 #include "liveobjectlist-inl.h"
@@ -1778,6 +1779,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SpecialArrayFunctions) {
   InstallBuiltin(isolate, holder, "slice", Builtins::kArraySlice);
   InstallBuiltin(isolate, holder, "splice", Builtins::kArraySplice);
   InstallBuiltin(isolate, holder, "concat", Builtins::kArrayConcat);
+  InstallBuiltin(isolate, holder, "sort", Builtins::kArraySort);
 
   return *holder;
 }
@@ -2040,6 +2042,34 @@ MUST_USE_RESULT static MaybeObject* CharFromCode(Isolate* isolate,
 }
 
 
+// Reads of a non-flat cons string that are answered by walking the cons
+// tree before the string is flattened anyway, and how deep that walk may go.
+static const int kMaxUnflattenedRopeReads = 16;
+static const int kMaxRopeReadDepth = 16;
+
+
+// Reads the character at |index| of a cons string by descending into its
+// parts.  Returns false if the leaf is too deep down to be worth it.
+static bool ReadRopeCharacter(ConsString* rope, int index, uint16_t* result) {
+  String* current = rope;
+  for (int depth = 0; depth < kMaxRopeReadDepth; depth++) {
+    if (!StringShape(current).IsCons()) {
+      *result = current->Get(index);
+      return true;
+    }
+    ConsString* cons = ConsString::cast(current);
+    String* first = cons->first();
+    if (index < first->length()) {
+      current = first;
+    } else {
+      index -= first->length();
+      current = cons->second();
+    }
+  }
+  return false;
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_StringCharCodeAt) {
   NoHandleAllocation ha;
   ASSERT(args.length() == 2);
@@ -2059,6 +2089,22 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringCharCodeAt) {
     i = static_cast<uint32_t>(DoubleToInteger(value));
   }
 
+  // A rope that is still being appended to would be flattened, and its
+  // characters copied, again for every new cons string on top of it.  Read
+  // single characters straight out of the cons tree until the same rope has
+  // been read repeatedly.
+  if (FLAG_lazy_rope_flattening && !subject->IsFlat()) {
+    if (i >= static_cast<uint32_t>(subject->length())) {
+      return isolate->heap()->nan_value();
+    }
+    uint16_t c;
+    if (isolate->runtime_state()->RecordRopeRead(subject) <=
+            kMaxUnflattenedRopeReads &&
+        ReadRopeCharacter(ConsString::cast(subject), i, &c)) {
+      return Smi::FromInt(c);
+    }
+  }
+
   // Flatten the string.  If someone wants to get a char at an index
   // in a cons string, it is likely that more indices will be
   // accessed.
@@ -2320,6 +2366,15 @@ class CompiledReplacement {
              int match_to,
              Handle<JSArray> last_match_info);
 
+  // Computes the length of the string that results from replacing every
+  // match of a global regexp in the subject, see RegExpImpl::GlobalExec.
+  int GlobalResultLength(int subject_length, FixedArray* matches);
+
+  // Writes that string to result, which must have room for
+  // GlobalResultLength characters.
+  template <typename Char>
+  void ApplyGlobal(String* subject, FixedArray* matches, Char* result);
+
   // Number of distinct parts of the replacement pattern.
   int parts() {
     return parts_.length();
@@ -2485,6 +2540,23 @@ class CompiledReplacement {
     }
   }
 
+  // Returns the string that the part copies from for the given match of a
+  // global regexp and sets from and to to the copied range.
+  String* PartSource(ReplacementPart part,
+                     String* subject,
+                     FixedArray* matches,
+                     int match,
+                     int* from,
+                     int* to);
+
+  static int AddResultLength(int length, int by) {
+    ASSERT(by >= 0);
+    if (length > String::kMaxLength - by) {
+      V8::FatalProcessOutOfMemory("String.replace result too large.");
+    }
+    return length + by;
+  }
+
   ZoneList<ReplacementPart> parts_;
   ZoneList<Handle<String> > replacement_substrings_;
 };
@@ -2569,6 +2641,81 @@ void CompiledReplacement::Apply(ReplacementStringBuilder* builder,
 }
 
 
+String* CompiledReplacement::PartSource(ReplacementPart part,
+                                        String* subject,
+                                        FixedArray* matches,
+                                        int match,
+                                        int* from,
+                                        int* to) {
+  int match_from = RegExpImpl::GetGlobalCapture(matches, match, 0);
+  int match_to = RegExpImpl::GetGlobalCapture(matches, match, 1);
+  switch (part.tag) {
+    case SUBJECT_PREFIX:
+      *from = 0;
+      *to = match_from;
+      return subject;
+    case SUBJECT_SUFFIX:
+      *from = match_to;
+      *to = Max(match_to, part.data);
+      return subject;
+    case SUBJECT_CAPTURE:
+      *from = RegExpImpl::GetGlobalCapture(matches, match, part.data * 2);
+      *to = RegExpImpl::GetGlobalCapture(matches, match, part.data * 2 + 1);
+      if (*from < 0 || *to < *from) *to = *from = 0;
+      return subject;
+    case REPLACEMENT_SUBSTRING:
+    case REPLACEMENT_STRING: {
+      String* string = *replacement_substrings_[part.data];
+      *from = 0;
+      *to = string->length();
+      return string;
+    }
+    default:
+      UNREACHABLE();
+      return NULL;
+  }
+}
+
+
+int CompiledReplacement::GlobalResultLength(int subject_length,
+                                            FixedArray* matches) {
+  int length = 0;
+  int prev = 0;  // Index of end of last match.
+  for (int i = 0, n = RegExpImpl::GlobalMatchCount(matches); i < n; i++) {
+    int match_from = RegExpImpl::GetGlobalCapture(matches, i, 0);
+    length = AddResultLength(length, match_from - prev);
+    for (int j = 0, m = parts_.length(); j < m; j++) {
+      int from, to;
+      PartSource(parts_[j], NULL, matches, i, &from, &to);
+      length = AddResultLength(length, to - from);
+    }
+    prev = RegExpImpl::GetGlobalCapture(matches, i, 1);
+  }
+  return AddResultLength(length, subject_length - prev);
+}
+
+
+template <typename Char>
+void CompiledReplacement::ApplyGlobal(String* subject,
+                                      FixedArray* matches,
+                                      Char* result) {
+  int prev = 0;  // Index of end of last match.
+  for (int i = 0, n = RegExpImpl::GlobalMatchCount(matches); i < n; i++) {
+    int match_from = RegExpImpl::GetGlobalCapture(matches, i, 0);
+    String::WriteToFlat(subject, result, prev, match_from);
+    result += match_from - prev;
+    for (int j = 0, m = parts_.length(); j < m; j++) {
+      int from, to;
+      String* source = PartSource(parts_[j], subject, matches, i, &from, &to);
+      String::WriteToFlat(source, result, from, to);
+      result += to - from;
+    }
+    prev = RegExpImpl::GetGlobalCapture(matches, i, 1);
+  }
+  String::WriteToFlat(subject, result, prev, subject->length());
+}
+
+
 
 MUST_USE_RESULT static MaybeObject* StringReplaceRegExpWithString(
     Isolate* isolate,
@@ -2578,6 +2725,7 @@ MUST_USE_RESULT static MaybeObject* StringReplaceRegExpWithString(
     JSArray* last_match_info) {
   ASSERT(subject->IsFlat());
   ASSERT(replacement->IsFlat());
+  ASSERT(!regexp->GetFlags().is_global());
 
   HandleScope handles(isolate);
 
@@ -2606,75 +2754,35 @@ MUST_USE_RESULT static MaybeObject* StringReplaceRegExpWithString(
                                capture_count,
                                length);
 
-  bool is_global = regexp_handle->GetFlags().is_global();
-
-  // Guessing the number of parts that the final result string is built
-  // from. Global regexps can match any number of times, so we guess
-  // conservatively.
-  int expected_parts =
-      (compiled_replacement.parts() + 1) * (is_global ? 4 : 1) + 1;
+  // The prefix, the parts of the compiled replacement and the suffix.  It
+  // is possible for all components to use two elements when encoded as two
+  // smis.
+  int expected_parts = 2 * (compiled_replacement.parts() + 2);
   ReplacementStringBuilder builder(isolate->heap(),
                                    subject_handle,
                                    expected_parts);
 
-  // Index of end of last match.
-  int prev = 0;
-
-  // Number of parts added by compiled replacement plus preceeding
-  // string and possibly suffix after last match.  It is possible for
-  // all components to use two elements when encoded as two smis.
-  const int parts_added_per_loop = 2 * (compiled_replacement.parts() + 2);
-  bool matched = true;
-  do {
-    ASSERT(last_match_info_handle->HasFastElements());
-    // Increase the capacity of the builder before entering local handle-scope,
-    // so its internal buffer can safely allocate a new handle if it grows.
-    builder.EnsureCapacity(parts_added_per_loop);
-
-    HandleScope loop_scope(isolate);
-    int start, end;
-    {
-      AssertNoAllocation match_info_array_is_not_in_a_handle;
-      FixedArray* match_info_array =
-          FixedArray::cast(last_match_info_handle->elements());
-
-      ASSERT_EQ(capture_count * 2 + 2,
-                RegExpImpl::GetLastCaptureCount(match_info_array));
-      start = RegExpImpl::GetCapture(match_info_array, 0);
-      end = RegExpImpl::GetCapture(match_info_array, 1);
-    }
-
-    if (prev < start) {
-      builder.AddSubjectSlice(prev, start);
-    }
-    compiled_replacement.Apply(&builder,
-                               start,
-                               end,
-                               last_match_info_handle);
-    prev = end;
-
-    // Only continue checking for global regexps.
-    if (!is_global) break;
-
-    // Continue from where the match ended, unless it was an empty match.
-    int next = end;
-    if (start == end) {
-      next = end + 1;
-      if (next > length) break;
-    }
-
-    match = RegExpImpl::Exec(regexp_handle,
-                             subject_handle,
-                             next,
-                             last_match_info_handle);
-    if (match.is_null()) {
-      return Failure::Exception();
-    }
-    matched = !match->IsNull();
-  } while (matched);
+  int start, end;
+  {
+    AssertNoAllocation match_info_array_is_not_in_a_handle;
+    FixedArray* match_info_array =
+        FixedArray::cast(last_match_info_handle->elements());
 
-  if (prev < length) {
-    builder.AddSubjectSlice(prev, length);
+    ASSERT_EQ(capture_count * 2 + 2,
+              RegExpImpl::GetLastCaptureCount(match_info_array));
+    start = RegExpImpl::GetCapture(match_info_array, 0);
+    end = RegExpImpl::GetCapture(match_info_array, 1);
+  }
+
+  if (start > 0) {
+    builder.AddSubjectSlice(0, start);
+  }
+  compiled_replacement.Apply(&builder,
+                             start,
+                             end,
+                             last_match_info_handle);
+  if (end < length) {
+    builder.AddSubjectSlice(end, length);
   }
 
   return *(builder.ToString());
@@ -2688,6 +2796,7 @@ MUST_USE_RESULT static MaybeObject* StringReplaceRegExpWithEmptyString(
     JSRegExp* regexp,
     JSArray* last_match_info) {
   ASSERT(subject->IsFlat());
+  ASSERT(!regexp->GetFlags().is_global());
 
   HandleScope handles(isolate);
 
@@ -2727,85 +2836,75 @@ MUST_USE_RESULT static MaybeObject* StringReplaceRegExpWithEmptyString(
         isolate->factory()->NewRawTwoByteString(new_length));
   }
 
-  // If the regexp isn't global, only match once.
-  if (!regexp_handle->GetFlags().is_global()) {
-    if (start > 0) {
-      String::WriteToFlat(*subject_handle,
-                          answer->GetChars(),
-                          0,
-                          start);
-    }
-    if (end < length) {
-      String::WriteToFlat(*subject_handle,
-                          answer->GetChars() + start,
-                          end,
-                          length);
-    }
-    return *answer;
+  if (start > 0) {
+    String::WriteToFlat(*subject_handle,
+                        answer->GetChars(),
+                        0,
+                        start);
   }
-
-  int prev = 0;  // Index of end of last match.
-  int next = 0;  // Start of next search (prev unless last match was empty).
-  int position = 0;
-
-  do {
-    if (prev < start) {
-      // Add substring subject[prev;start] to answer string.
-      String::WriteToFlat(*subject_handle,
-                          answer->GetChars() + position,
-                          prev,
-                          start);
-      position += start - prev;
-    }
-    prev = end;
-    next = end;
-    // Continue from where the match ended, unless it was an empty match.
-    if (start == end) {
-      next++;
-      if (next > length) break;
-    }
-    match = RegExpImpl::Exec(regexp_handle,
-                             subject_handle,
-                             next,
-                             last_match_info_handle);
-    if (match.is_null()) return Failure::Exception();
-    if (match->IsNull()) break;
-
-    ASSERT(last_match_info_handle->HasFastElements());
-    HandleScope loop_scope(isolate);
-    {
-      AssertNoAllocation match_info_array_is_not_in_a_handle;
-      FixedArray* match_info_array =
-          FixedArray::cast(last_match_info_handle->elements());
-      start = RegExpImpl::GetCapture(match_info_array, 0);
-      end = RegExpImpl::GetCapture(match_info_array, 1);
-    }
-  } while (true);
-
-  if (prev < length) {
-    // Add substring subject[prev;length] to answer string.
+  if (end < length) {
     String::WriteToFlat(*subject_handle,
-                        answer->GetChars() + position,
-                        prev,
+                        answer->GetChars() + start,
+                        end,
                         length);
-    position += length - prev;
   }
+  return *answer;
+}
 
-  if (position == 0) {
-    return isolate->heap()->empty_string();
-  }
 
-  // Shorten string and fill
-  int string_size = ResultSeqString::SizeFor(position);
-  int allocated_string_size = ResultSeqString::SizeFor(new_length);
-  int delta = allocated_string_size - string_size;
+// Replaces all matches of a global regexp.  The matches are found up front,
+// so the length of the result is known and it is written in a single pass
+// without collecting the parts first.
+template <typename ResultSeqString>
+MUST_USE_RESULT static MaybeObject* StringReplaceGlobalRegExpWithString(
+    Isolate* isolate,
+    String* subject,
+    JSRegExp* regexp,
+    String* replacement,
+    JSArray* last_match_info) {
+  ASSERT(subject->IsFlat());
+  ASSERT(replacement->IsFlat());
+  ASSERT(regexp->GetFlags().is_global());
 
-  answer->set_length(position);
-  if (delta == 0) return *answer;
+  HandleScope handles(isolate);
 
-  Address end_of_string = answer->address() + string_size;
-  isolate->heap()->CreateFillerObjectAt(end_of_string, delta);
+  Handle<String> subject_handle(subject);
+  Handle<JSRegExp> regexp_handle(regexp);
+  Handle<String> replacement_handle(replacement);
+  Handle<JSArray> last_match_info_handle(last_match_info);
+  Handle<Object> match = RegExpImpl::GlobalExec(regexp_handle,
+                                                subject_handle,
+                                                last_match_info_handle);
+  if (match.is_null()) return Failure::Exception();
+  if (match->IsNull()) return *subject_handle;
+  Handle<FixedArray> matches = Handle<FixedArray>::cast(match);
+
+  // CompiledReplacement uses zone allocation.
+  CompilationZoneScope zone(DELETE_ON_EXIT);
+  CompiledReplacement compiled_replacement;
+  compiled_replacement.Compile(replacement_handle,
+                               regexp_handle->CaptureCount(),
+                               subject_handle->length());
+
+  int result_length =
+      compiled_replacement.GlobalResultLength(subject_handle->length(),
+                                              *matches);
+  if (result_length == 0) {
+    return isolate->heap()->empty_string();
+  }
+  Handle<ResultSeqString> answer;
+  if (ResultSeqString::kHasAsciiEncoding) {
+    answer = Handle<ResultSeqString>::cast(
+        isolate->factory()->NewRawAsciiString(result_length));
+  } else {
+    answer = Handle<ResultSeqString>::cast(
+        isolate->factory()->NewRawTwoByteString(result_length));
+  }
 
+  AssertNoAllocation no_gc;
+  compiled_replacement.ApplyGlobal(*subject_handle,
+                                   *matches,
+                                   answer->GetChars());
   return *answer;
 }
 
@@ -2840,6 +2939,16 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringReplaceRegExpWithString) {
 
   ASSERT(last_match_info->HasFastElements());
 
+  if (regexp->GetFlags().is_global()) {
+    if (subject->HasOnlyAsciiChars() && replacement->HasOnlyAsciiChars()) {
+      return StringReplaceGlobalRegExpWithString<SeqAsciiString>(
+          isolate, subject, regexp, replacement, last_match_info);
+    } else {
+      return StringReplaceGlobalRegExpWithString<SeqTwoByteString>(
+          isolate, subject, regexp, replacement, last_match_info);
+    }
+  }
+
   if (replacement->length() == 0) {
     if (subject->HasOnlyAsciiChars()) {
       return StringReplaceRegExpWithEmptyString<SeqAsciiString>(
@@ -3104,7 +3213,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringMatch) {
   CONVERT_ARG_CHECKED(JSArray, regexp_info, 2);
   HandleScope handles;
 
-  Handle<Object> match = RegExpImpl::Exec(regexp, subject, 0, regexp_info);
+  Handle<Object> match = RegExpImpl::GlobalExec(regexp, subject, regexp_info);
 
   if (match.is_null()) {
     return Failure::Exception();
@@ -3112,33 +3221,12 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringMatch) {
   if (match->IsNull()) {
     return isolate->heap()->null_value();
   }
-  int length = subject->length();
-
-  CompilationZoneScope zone_space(DELETE_ON_EXIT);
-  ZoneList<int> offsets(8);
-  do {
-    int start;
-    int end;
-    {
-      AssertNoAllocation no_alloc;
-      FixedArray* elements = FixedArray::cast(regexp_info->elements());
-      start = Smi::cast(elements->get(RegExpImpl::kFirstCapture))->value();
-      end = Smi::cast(elements->get(RegExpImpl::kFirstCapture + 1))->value();
-    }
-    offsets.Add(start);
-    offsets.Add(end);
-    int index = start < end ? end : end + 1;
-    if (index > length) break;
-    match = RegExpImpl::Exec(regexp, subject, index, regexp_info);
-    if (match.is_null()) {
-      return Failure::Exception();
-    }
-  } while (!match->IsNull());
-  int matches = offsets.length() / 2;
+  Handle<FixedArray> offsets = Handle<FixedArray>::cast(match);
+  int matches = RegExpImpl::GlobalMatchCount(*offsets);
   Handle<FixedArray> elements = isolate->factory()->NewFixedArray(matches);
   for (int i = 0; i < matches ; i++) {
-    int from = offsets.at(i * 2);
-    int to = offsets.at(i * 2 + 1);
+    int from = RegExpImpl::GetGlobalCapture(*offsets, i, 0);
+    int to = RegExpImpl::GetGlobalCapture(*offsets, i, 1);
     Handle<String> match = isolate->factory()->NewSubString(subject, from, to);
     elements->set(i, *match);
   }
@@ -3152,313 +3240,67 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringMatch) {
 const int kMaxBuilderEntriesPerRegExpMatch = 5;
 
 
-static void SetLastMatchInfoNoCaptures(Handle<String> subject,
-                                       Handle<JSArray> last_match_info,
-                                       int match_start,
-                                       int match_end) {
-  // Fill last_match_info with a single capture.
-  last_match_info->EnsureSize(2 + RegExpImpl::kLastMatchOverhead);
-  AssertNoAllocation no_gc;
-  FixedArray* elements = FixedArray::cast(last_match_info->elements());
-  RegExpImpl::SetLastCaptureCount(elements, 2);
-  RegExpImpl::SetLastInput(elements, *subject);
-  RegExpImpl::SetLastSubject(elements, *subject);
-  RegExpImpl::SetCapture(elements, 0, match_start);
-  RegExpImpl::SetCapture(elements, 1, match_end);
-}
-
-
-template <typename SubjectChar, typename PatternChar>
-static bool SearchStringMultiple(Isolate* isolate,
-                                 Vector<const SubjectChar> subject,
-                                 Vector<const PatternChar> pattern,
-                                 String* pattern_string,
-                                 FixedArrayBuilder* builder,
-                                 int* match_pos) {
-  int pos = *match_pos;
-  int subject_length = subject.length();
-  int pattern_length = pattern.length();
-  int max_search_start = subject_length - pattern_length;
-  StringSearch<PatternChar, SubjectChar> search(isolate, pattern);
-  while (pos <= max_search_start) {
-    if (!builder->HasCapacity(kMaxBuilderEntriesPerRegExpMatch)) {
-      *match_pos = pos;
-      return false;
-    }
-    // Position of end of previous match.
-    int match_end = pos + pattern_length;
-    int new_pos = search.Search(subject, match_end);
-    if (new_pos >= 0) {
-      // A match.
-      if (new_pos > match_end) {
-        ReplacementStringBuilder::AddSubjectSlice(builder,
-            match_end,
-            new_pos);
-      }
-      pos = new_pos;
-      builder->Add(pattern_string);
-    } else {
-      break;
-    }
-  }
-
-  if (pos < max_search_start) {
-    ReplacementStringBuilder::AddSubjectSlice(builder,
-                                              pos + pattern_length,
-                                              subject_length);
-  }
-  *match_pos = pos;
-  return true;
-}
-
-
-static bool SearchStringMultiple(Isolate* isolate,
-                                 Handle<String> subject,
-                                 Handle<String> pattern,
-                                 Handle<JSArray> last_match_info,
-                                 FixedArrayBuilder* builder) {
-  ASSERT(subject->IsFlat());
-  ASSERT(pattern->IsFlat());
-
-  // Treating as if a previous match was before first character.
-  int match_pos = -pattern->length();
-
-  for (;;) {  // Break when search complete.
-    builder->EnsureCapacity(kMaxBuilderEntriesPerRegExpMatch);
-    AssertNoAllocation no_gc;
-    if (subject->IsAsciiRepresentation()) {
-      Vector<const char> subject_vector = subject->ToAsciiVector();
-      if (pattern->IsAsciiRepresentation()) {
-        if (SearchStringMultiple(isolate,
-                                 subject_vector,
-                                 pattern->ToAsciiVector(),
-                                 *pattern,
-                                 builder,
-                                 &match_pos)) break;
-      } else {
-        if (SearchStringMultiple(isolate,
-                                 subject_vector,
-                                 pattern->ToUC16Vector(),
-                                 *pattern,
-                                 builder,
-                                 &match_pos)) break;
-      }
-    } else {
-      Vector<const uc16> subject_vector = subject->ToUC16Vector();
-      if (pattern->IsAsciiRepresentation()) {
-        if (SearchStringMultiple(isolate,
-                                 subject_vector,
-                                 pattern->ToAsciiVector(),
-                                 *pattern,
-                                 builder,
-                                 &match_pos)) break;
-      } else {
-        if (SearchStringMultiple(isolate,
-                                 subject_vector,
-                                 pattern->ToUC16Vector(),
-                                 *pattern,
-                                 builder,
-                                 &match_pos)) break;
-      }
-    }
-  }
-
-  if (match_pos >= 0) {
-    SetLastMatchInfoNoCaptures(subject,
-                               last_match_info,
-                               match_pos,
-                               match_pos + pattern->length());
-    return true;
-  }
-  return false;  // No matches at all.
-}
-
-
-static RegExpImpl::IrregexpResult SearchRegExpNoCaptureMultiple(
-    Isolate* isolate,
-    Handle<String> subject,
-    Handle<JSRegExp> regexp,
-    Handle<JSArray> last_match_array,
-    FixedArrayBuilder* builder) {
-  ASSERT(subject->IsFlat());
-  int match_start = -1;
-  int match_end = 0;
-  int pos = 0;
-  int required_registers = RegExpImpl::IrregexpPrepare(regexp, subject);
-  if (required_registers < 0) return RegExpImpl::RE_EXCEPTION;
-
-  OffsetsVector registers(required_registers);
-  Vector<int32_t> register_vector(registers.vector(), registers.length());
+// Adds the parts of the subject between the matches of a global regexp to
+// the builder, together with either the matched substring or, if the regexp
+// has captures, the arguments for a replace function: the match, the
+// captures, the index of the match and the subject.
+static void BuildRegExpMultipleResult(Isolate* isolate,
+                                      Handle<String> subject,
+                                      Handle<FixedArray> matches,
+                                      int capture_count,
+                                      FixedArrayBuilder* builder) {
   int subject_length = subject->length();
-
-  for (;;) {  // Break on failure, return on exception.
-    RegExpImpl::IrregexpResult result =
-        RegExpImpl::IrregexpExecOnce(regexp,
-                                     subject,
-                                     pos,
-                                     register_vector);
-    if (result == RegExpImpl::RE_SUCCESS) {
-      match_start = register_vector[0];
-      builder->EnsureCapacity(kMaxBuilderEntriesPerRegExpMatch);
-      if (match_end < match_start) {
-        ReplacementStringBuilder::AddSubjectSlice(builder,
-                                                  match_end,
-                                                  match_start);
-      }
-      match_end = register_vector[1];
-      HandleScope loop_scope(isolate);
-      builder->Add(*isolate->factory()->NewSubString(subject,
-                                                     match_start,
-                                                     match_end));
-      if (match_start != match_end) {
-        pos = match_end;
-      } else {
-        pos = match_end + 1;
-        if (pos > subject_length) break;
-      }
-    } else if (result == RegExpImpl::RE_FAILURE) {
-      break;
-    } else {
-      ASSERT_EQ(result, RegExpImpl::RE_EXCEPTION);
-      return result;
-    }
-  }
-
-  if (match_start >= 0) {
-    if (match_end < subject_length) {
+  int match_count = RegExpImpl::GlobalMatchCount(*matches);
+  // End of previous match.
+  int match_end = 0;
+  for (int i = 0; i < match_count; i++) {
+    builder->EnsureCapacity(kMaxBuilderEntriesPerRegExpMatch);
+    int match_start = RegExpImpl::GetGlobalCapture(*matches, i, 0);
+    if (match_end < match_start) {
       ReplacementStringBuilder::AddSubjectSlice(builder,
                                                 match_end,
-                                                subject_length);
+                                                match_start);
     }
-    SetLastMatchInfoNoCaptures(subject,
-                               last_match_array,
-                               match_start,
-                               match_end);
-    return RegExpImpl::RE_SUCCESS;
-  } else {
-    return RegExpImpl::RE_FAILURE;  // No matches at all.
-  }
-}
-
+    match_end = RegExpImpl::GetGlobalCapture(*matches, i, 1);
 
-static RegExpImpl::IrregexpResult SearchRegExpMultiple(
-    Isolate* isolate,
-    Handle<String> subject,
-    Handle<JSRegExp> regexp,
-    Handle<JSArray> last_match_array,
-    FixedArrayBuilder* builder) {
-
-  ASSERT(subject->IsFlat());
-  int required_registers = RegExpImpl::IrregexpPrepare(regexp, subject);
-  if (required_registers < 0) return RegExpImpl::RE_EXCEPTION;
-
-  OffsetsVector registers(required_registers);
-  Vector<int32_t> register_vector(registers.vector(), registers.length());
-
-  RegExpImpl::IrregexpResult result =
-      RegExpImpl::IrregexpExecOnce(regexp,
-                                   subject,
-                                   0,
-                                   register_vector);
-
-  int capture_count = regexp->CaptureCount();
-  int subject_length = subject->length();
-
-  // Position to search from.
-  int pos = 0;
-  // End of previous match. Differs from pos if match was empty.
-  int match_end = 0;
-  if (result == RegExpImpl::RE_SUCCESS) {
-    // Need to keep a copy of the previous match for creating last_match_info
-    // at the end, so we have two vectors that we swap between.
-    OffsetsVector registers2(required_registers);
-    Vector<int> prev_register_vector(registers2.vector(), registers2.length());
-
-    do {
-      int match_start = register_vector[0];
-      builder->EnsureCapacity(kMaxBuilderEntriesPerRegExpMatch);
-      if (match_end < match_start) {
-        ReplacementStringBuilder::AddSubjectSlice(builder,
-                                                  match_end,
-                                                  match_start);
-      }
-      match_end = register_vector[1];
-
-      {
-        // Avoid accumulating new handles inside loop.
-        HandleScope temp_scope(isolate);
-        // Arguments array to replace function is match, captures, index and
-        // subject, i.e., 3 + capture count in total.
-        Handle<FixedArray> elements =
-            isolate->factory()->NewFixedArray(3 + capture_count);
-        Handle<String> match = isolate->factory()->NewSubString(subject,
-                                                                match_start,
-                                                                match_end);
-        elements->set(0, *match);
-        for (int i = 1; i <= capture_count; i++) {
-          int start = register_vector[i * 2];
-          if (start >= 0) {
-            int end = register_vector[i * 2 + 1];
-            ASSERT(start <= end);
-            Handle<String> substring = isolate->factory()->NewSubString(subject,
-                                                                        start,
-                                                                        end);
-            elements->set(i, *substring);
-          } else {
-            ASSERT(register_vector[i * 2 + 1] < 0);
-            elements->set(i, isolate->heap()->undefined_value());
-          }
-        }
-        elements->set(capture_count + 1, Smi::FromInt(match_start));
-        elements->set(capture_count + 2, *subject);
-        builder->Add(*isolate->factory()->NewJSArrayWithElements(elements));
-      }
-      // Swap register vectors, so the last successful match is in
-      // prev_register_vector.
-      Vector<int32_t> tmp = prev_register_vector;
-      prev_register_vector = register_vector;
-      register_vector = tmp;
-
-      if (match_end > match_start) {
-        pos = match_end;
+    // Avoid accumulating new handles inside loop.
+    HandleScope temp_scope(isolate);
+    Handle<String> match = isolate->factory()->NewSubString(subject,
+                                                            match_start,
+                                                            match_end);
+    if (capture_count == 0) {
+      builder->Add(*match);
+      continue;
+    }
+    // Arguments array to replace function is match, captures, index and
+    // subject, i.e., 3 + capture count in total.
+    Handle<FixedArray> elements =
+        isolate->factory()->NewFixedArray(3 + capture_count);
+    elements->set(0, *match);
+    for (int j = 1; j <= capture_count; j++) {
+      int start = RegExpImpl::GetGlobalCapture(*matches, i, j * 2);
+      if (start >= 0) {
+        int end = RegExpImpl::GetGlobalCapture(*matches, i, j * 2 + 1);
+        ASSERT(start <= end);
+        Handle<String> substring = isolate->factory()->NewSubString(subject,
+                                                                    start,
+                                                                    end);
+        elements->set(j, *substring);
       } else {
-        pos = match_end + 1;
-        if (pos > subject_length) {
-          break;
-        }
-      }
-
-      result = RegExpImpl::IrregexpExecOnce(regexp,
-                                            subject,
-                                            pos,
-                                            register_vector);
-    } while (result == RegExpImpl::RE_SUCCESS);
-
-    if (result != RegExpImpl::RE_EXCEPTION) {
-      // Finished matching, with at least one match.
-      if (match_end < subject_length) {
-        ReplacementStringBuilder::AddSubjectSlice(builder,
-                                                  match_end,
-                                                  subject_length);
+        ASSERT(RegExpImpl::GetGlobalCapture(*matches, i, j * 2 + 1) < 0);
+        elements->set(j, isolate->heap()->undefined_value());
       }
-
-      int last_match_capture_count = (capture_count + 1) * 2;
-      int last_match_array_size =
-          last_match_capture_count + RegExpImpl::kLastMatchOverhead;
-      last_match_array->EnsureSize(last_match_array_size);
-      AssertNoAllocation no_gc;
-      FixedArray* elements = FixedArray::cast(last_match_array->elements());
-      RegExpImpl::SetLastCaptureCount(elements, last_match_capture_count);
-      RegExpImpl::SetLastSubject(elements, *subject);
-      RegExpImpl::SetLastInput(elements, *subject);
-      for (int i = 0; i < last_match_capture_count; i++) {
-        RegExpImpl::SetCapture(elements, i, prev_register_vector[i]);
-      }
-      return RegExpImpl::RE_SUCCESS;
     }
+    elements->set(capture_count + 1, Smi::FromInt(match_start));
+    elements->set(capture_count + 2, *subject);
+    builder->Add(*isolate->factory()->NewJSArrayWithElements(elements));
+  }
+
+  if (match_end < subject_length) {
+    ReplacementStringBuilder::AddSubjectSlice(builder,
+                                              match_end,
+                                              subject_length);
   }
-  // No matches at all, return failure or exception result directly.
-  return result;
 }
 
 
@@ -3474,6 +3316,12 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_RegExpExecMultiple) {
 
   ASSERT(last_match_info->HasFastElements());
   ASSERT(regexp->GetFlags().is_global());
+
+  Handle<Object> match =
+      RegExpImpl::GlobalExec(regexp, subject, last_match_info);
+  if (match.is_null()) return Failure::Exception();
+  if (match->IsNull()) return isolate->heap()->null_value();
+
   Handle<FixedArray> result_elements;
   if (result_array->HasFastElements()) {
     result_elements =
@@ -3482,38 +3330,12 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_RegExpExecMultiple) {
     result_elements = isolate->factory()->NewFixedArrayWithHoles(16);
   }
   FixedArrayBuilder builder(result_elements);
-
-  if (regexp->TypeTag() == JSRegExp::ATOM) {
-    Handle<String> pattern(
-        String::cast(regexp->DataAt(JSRegExp::kAtomPatternIndex)));
-    ASSERT(pattern->IsFlat());
-    if (SearchStringMultiple(isolate, subject, pattern,
-                             last_match_info, &builder)) {
-      return *builder.ToJSArray(result_array);
-    }
-    return isolate->heap()->null_value();
-  }
-
-  ASSERT_EQ(regexp->TypeTag(), JSRegExp::IRREGEXP);
-
-  RegExpImpl::IrregexpResult result;
-  if (regexp->CaptureCount() == 0) {
-    result = SearchRegExpNoCaptureMultiple(isolate,
-                                           subject,
-                                           regexp,
-                                           last_match_info,
-                                           &builder);
-  } else {
-    result = SearchRegExpMultiple(isolate,
-                                  subject,
-                                  regexp,
-                                  last_match_info,
-                                  &builder);
-  }
-  if (result == RegExpImpl::RE_SUCCESS) return *builder.ToJSArray(result_array);
-  if (result == RegExpImpl::RE_FAILURE) return isolate->heap()->null_value();
-  ASSERT_EQ(result, RegExpImpl::RE_EXCEPTION);
-  return Failure::Exception();
+  BuildRegExpMultipleResult(isolate,
+                            subject,
+                            Handle<FixedArray>::cast(match),
+                            regexp->CaptureCount(),
+                            &builder);
+  return *builder.ToJSArray(result_array);
 }
 
 
@@ -8140,7 +7962,15 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_ParseJson) {
   ASSERT_EQ(1, args.length());
   CONVERT_ARG_CHECKED(String, source, 0);
 
-  Handle<Object> result = JsonParser::Parse(source);
+  source = FlattenGetString(source);
+  Handle<Object> result;
+  if (source->IsSeqAsciiString()) {
+    result = JsonParser<SeqAsciiString>::Parse(source);
+  } else if (source->IsSeqTwoByteString()) {
+    result = JsonParser<SeqTwoByteString>::Parse(source);
+  } else {
+    result = JsonParser<String>::Parse(source);
+  }
   if (result.is_null()) {
     // Syntax error or stack overflow in scanner.
     ASSERT(isolate->has_pending_exception());
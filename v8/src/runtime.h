@@ -515,8 +515,39 @@ class RuntimeState {
     return smi_lexicographic_compare_y_elms_;
   }
 
+  // Records a character read from an unflattened cons string and returns
+  // how many reads of that string have been recorded.  Reads are counted
+  // per string in a small table indexed by address, so that code reading
+  // a few ropes in turn still gets each of them flattened.  Strings are
+  // only compared by address and never dereferenced, so they need not be
+  // visited by the GC; a string that moves starts counting again, and one
+  // that takes the place of a dead string may be flattened early.
+  int RecordRopeRead(String* rope) {
+    RopeReadCount* entry = &rope_read_counts_[
+        (reinterpret_cast<uintptr_t>(rope) >> kObjectAlignmentBits) &
+        (kRopeReadCounts - 1)];
+    if (entry->rope != rope) {
+      entry->rope = rope;
+      entry->count = 0;
+    }
+    return ++entry->count;
+  }
+
  private:
-  RuntimeState() {}
+  RuntimeState() {
+    for (int i = 0; i < kRopeReadCounts; i++) {
+      rope_read_counts_[i].rope = NULL;
+      rope_read_counts_[i].count = 0;
+    }
+  }
+
+  static const int kRopeReadCounts = 16;
+
+  struct RopeReadCount {
+    String* rope;
+    int count;
+  };
+
   // Non-reentrant string buffer for efficient general use in the runtime.
   StaticResource<StringInputBuffer> string_input_buffer_;
   unibrow::Mapping<unibrow::ToUppercase, 128> to_upper_mapping_;
@@ -525,6 +556,7 @@ class RuntimeState {
   StringInputBuffer string_input_buffer_compare_bufy_;
   StringInputBuffer string_locale_compare_buf1_;
   StringInputBuffer string_locale_compare_buf2_;
+  RopeReadCount rope_read_counts_[kRopeReadCounts];
   int smi_lexicographic_compare_x_elms_[10];
   int smi_lexicographic_compare_y_elms_[10];
 
@@ -307,22 +307,49 @@ void ExternalReferenceTable::PopulateTable(Isolate* isolate) {
   StubCache* stub_cache = isolate->stub_cache();
 
   // Stub cache tables
-  Add(stub_cache->key_reference(StubCache::kPrimary).address(),
-      STUB_CACHE_TABLE,
-      1,
-      "StubCache::primary_->key");
-  Add(stub_cache->value_reference(StubCache::kPrimary).address(),
-      STUB_CACHE_TABLE,
-      2,
-      "StubCache::primary_->value");
-  Add(stub_cache->key_reference(StubCache::kSecondary).address(),
+  const char* stub_cache_table_names[] = {
+    "StubCache::primary_[kLoadCache]->key",
+    "StubCache::primary_[kLoadCache]->value",
+    "StubCache::secondary_[kLoadCache]->key",
+    "StubCache::secondary_[kLoadCache]->value",
+    "StubCache::primary_[kStoreCache]->key",
+    "StubCache::primary_[kStoreCache]->value",
+    "StubCache::secondary_[kStoreCache]->key",
+    "StubCache::secondary_[kStoreCache]->value",
+    "StubCache::primary_[kCallCache]->key",
+    "StubCache::primary_[kCallCache]->value",
+    "StubCache::secondary_[kCallCache]->key",
+    "StubCache::secondary_[kCallCache]->value"
+  };
+  STATIC_ASSERT(ARRAY_SIZE(stub_cache_table_names) ==
+                StubCache::kCacheKindCount * 4);
+  uint16_t stub_cache_id = 1;
+  for (int kind = 0; kind < StubCache::kCacheKindCount; kind++) {
+    for (int table = StubCache::kPrimary;
+         table <= StubCache::kSecondary;
+         table++) {
+      StubCache::CacheKind cache_kind = static_cast<StubCache::CacheKind>(kind);
+      StubCache::Table cache_table = static_cast<StubCache::Table>(table);
+      Add(stub_cache->key_reference(cache_kind, cache_table).address(),
+          STUB_CACHE_TABLE,
+          stub_cache_id,
+          stub_cache_table_names[stub_cache_id - 1]);
+      stub_cache_id++;
+      Add(stub_cache->value_reference(cache_kind, cache_table).address(),
+          STUB_CACHE_TABLE,
+          stub_cache_id,
+          stub_cache_table_names[stub_cache_id - 1]);
+      stub_cache_id++;
+    }
+  }
+  Add(stub_cache->mask_reference(StubCache::kPrimary).address(),
       STUB_CACHE_TABLE,
-      3,
-      "StubCache::secondary_->key");
-  Add(stub_cache->value_reference(StubCache::kSecondary).address(),
+      stub_cache_id++,
+      "StubCache::primary_mask_");
+  Add(stub_cache->mask_reference(StubCache::kSecondary).address(),
       STUB_CACHE_TABLE,
-      4,
-      "StubCache::secondary_->value");
+      stub_cache_id++,
+      "StubCache::secondary_mask_");
 
   // Runtime entries
   Add(ExternalReference::perform_gc_function(isolate).address(),
@@ -679,8 +706,9 @@ void Deserializer::Deserialize() {
   ASSERT_EQ(NULL, isolate_->thread_manager()->FirstThreadStateInUse());
   // No active handles.
   ASSERT(isolate_->handle_scope_implementer()->blocks()->is_empty());
-  // Make sure the entire partial snapshot cache is traversed, filling it with
-  // valid object pointers.
+  // Let the partial snapshot cache be traversed up to its undefined
+  // terminator, filling it with valid object pointers.  Iterate() sets the
+  // real length when it reaches the terminator.
   isolate_->set_serialize_partial_snapshot_cache_length(
       Isolate::kPartialSnapshotCacheCapacity);
   ASSERT_EQ(NULL, external_reference_decoder_);
@@ -1117,23 +1145,11 @@ void StartupSerializer::SerializeStrongReferences() {
 
 
 void PartialSerializer::Serialize(Object** object) {
-  this->VisitPointer(object);
-  Isolate* isolate = Isolate::Current();
-
   // After we have done the partial serialization the partial snapshot cache
-  // will contain some references needed to decode the partial snapshot.  We
-  // fill it up with undefineds so it has a predictable length so the
-  // deserialization code doesn't need to know the length.
-  for (int index = isolate->serialize_partial_snapshot_cache_length();
-       index < Isolate::kPartialSnapshotCacheCapacity;
-       index++) {
-    isolate->serialize_partial_snapshot_cache()[index] =
-        isolate->heap()->undefined_value();
-    startup_serializer_->VisitPointer(
-        &isolate->serialize_partial_snapshot_cache()[index]);
-  }
-  isolate->set_serialize_partial_snapshot_cache_length(
-      Isolate::kPartialSnapshotCacheCapacity);
+  // will contain some references needed to decode the partial snapshot.  The
+  // startup serializer terminates the cache when it serializes the weak
+  // references, so only the entries in use end up in the startup snapshot.
+  this->VisitPointer(object);
 }
 
 
@@ -1160,12 +1176,20 @@ void Serializer::VisitPointers(Object** start, Object** end) {
 // the startup snapshot that correspond to the elements of this cache array.  On
 // deserialization we therefore need to visit the cache array.  This fills it up
 // with pointers to deserialized objects.
+// The serialized cache is terminated by undefined, which is a root and so is
+// never entered in the cache itself.  When the terminator is deserialized
+// the cache gets its real length.
 void SerializerDeserializer::Iterate(ObjectVisitor* visitor) {
   Isolate* isolate = Isolate::Current();
-  visitor->VisitPointers(
-      isolate->serialize_partial_snapshot_cache(),
-      &isolate->serialize_partial_snapshot_cache()[
-          isolate->serialize_partial_snapshot_cache_length()]);
+  Object** cache = isolate->serialize_partial_snapshot_cache();
+  int length = isolate->serialize_partial_snapshot_cache_length();
+  for (int i = 0; i < length; i++) {
+    visitor->VisitPointer(&cache[i]);
+    if (cache[i] == isolate->heap()->undefined_value()) {
+      isolate->set_serialize_partial_snapshot_cache_length(i);
+      break;
+    }
+  }
 }
 
 
@@ -1288,12 +1312,14 @@ void StartupSerializer::SerializeObject(
 
 
 void StartupSerializer::SerializeWeakReferences() {
-  for (int i = Isolate::Current()->serialize_partial_snapshot_cache_length();
-       i < Isolate::kPartialSnapshotCacheCapacity;
-       i++) {
-    sink_->Put(kRootArray + kPlain + kStartOfObject, "RootSerialization");
-    sink_->PutInt(Heap::kUndefinedValueRootIndex, "root_index");
-  }
+  // This comes right after the partial serialization (if any), which has
+  // added the objects the partial snapshot refers to to the partial snapshot
+  // cache.  Terminate the cache with undefined so the deserializer knows
+  // where it ends.
+  CHECK(Isolate::Current()->serialize_partial_snapshot_cache_length() <
+        Isolate::kPartialSnapshotCacheCapacity);
+  sink_->Put(kRootArray + kPlain + kStartOfObject, "RootSerialization");
+  sink_->PutInt(Heap::kUndefinedValueRootIndex, "root_index");
   HEAP->IterateWeakRoots(this, VISIT_ALL);
 }
 
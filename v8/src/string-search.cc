@@ -28,9 +28,146 @@
 #include "v8.h"
 #include "string-search.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define V8_STRING_SEARCH_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__)
+#define V8_STRING_SEARCH_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace v8 {
 namespace internal {
 
+// The vector loops below only locate the block of characters containing
+// the first match; the scalar loop that follows finds its exact position
+// (and handles the characters left over at the end of the subject).
+
+int FindFirstCharacter(Vector<const char> subject,
+                       int index,
+                       int limit,
+                       char c) {
+  ASSERT(0 <= index && limit <= subject.length());
+  if (index >= limit) return -1;
+  const char* chars = subject.start();
+  const void* pos = memchr(chars + index, c, limit - index);
+  if (pos == NULL) return -1;
+  return static_cast<int>(static_cast<const char*>(pos) - chars);
+}
+
+
+int FindFirstCharacter(Vector<const uc16> subject,
+                       int index,
+                       int limit,
+                       uc16 c) {
+  ASSERT(0 <= index && limit <= subject.length());
+  const uc16* chars = subject.start();
+  int i = index;
+#if defined(V8_STRING_SEARCH_SSE2)
+  static const int kLanes = sizeof(__m128i) / sizeof(uc16);
+  __m128i needle = _mm_set1_epi16(static_cast<int16_t>(c));
+  for (; i + kLanes <= limit; i += kLanes) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(block, needle)) != 0) break;
+  }
+#elif defined(V8_STRING_SEARCH_NEON)
+  static const int kLanes = sizeof(uint16x8_t) / sizeof(uc16);
+  uint16x8_t needle = vdupq_n_u16(c);
+  for (; i + kLanes <= limit; i += kLanes) {
+    uint64x2_t matches = vreinterpretq_u64_u16(
+        vceqq_u16(vld1q_u16(chars + i), needle));
+    if ((vgetq_lane_u64(matches, 0) | vgetq_lane_u64(matches, 1)) != 0) break;
+  }
+#endif
+  for (; i < limit; i++) {
+    if (chars[i] == c) return i;
+  }
+  return -1;
+}
+
+
+int FindCharacterPair(Vector<const char> subject,
+                      int index,
+                      int limit,
+                      char c0,
+                      char c1) {
+  ASSERT(0 <= index && limit < subject.length());
+  const char* chars = subject.start();
+  int i = index;
+#if defined(V8_STRING_SEARCH_SSE2)
+  static const int kLanes = sizeof(__m128i);
+  __m128i needle0 = _mm_set1_epi8(c0);
+  __m128i needle1 = _mm_set1_epi8(c1);
+  for (; i + kLanes <= limit; i += kLanes) {
+    __m128i block0 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i));
+    __m128i block1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i + 1));
+    __m128i matches = _mm_and_si128(_mm_cmpeq_epi8(block0, needle0),
+                                    _mm_cmpeq_epi8(block1, needle1));
+    if (_mm_movemask_epi8(matches) != 0) break;
+  }
+#elif defined(V8_STRING_SEARCH_NEON)
+  static const int kLanes = sizeof(uint8x16_t);
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(chars);
+  uint8x16_t needle0 = vdupq_n_u8(static_cast<uint8_t>(c0));
+  uint8x16_t needle1 = vdupq_n_u8(static_cast<uint8_t>(c1));
+  for (; i + kLanes <= limit; i += kLanes) {
+    uint8x16_t matches = vandq_u8(vceqq_u8(vld1q_u8(bytes + i), needle0),
+                                  vceqq_u8(vld1q_u8(bytes + i + 1), needle1));
+    uint64x2_t bits = vreinterpretq_u64_u8(matches);
+    if ((vgetq_lane_u64(bits, 0) | vgetq_lane_u64(bits, 1)) != 0) break;
+  }
+#endif
+  for (; i < limit; i++) {
+    if (chars[i] == c0 && chars[i + 1] == c1) return i;
+  }
+  return -1;
+}
+
+
+int FindCharacterPair(Vector<const uc16> subject,
+                      int index,
+                      int limit,
+                      uc16 c0,
+                      uc16 c1) {
+  ASSERT(0 <= index && limit < subject.length());
+  const uc16* chars = subject.start();
+  int i = index;
+#if defined(V8_STRING_SEARCH_SSE2)
+  static const int kLanes = sizeof(__m128i) / sizeof(uc16);
+  __m128i needle0 = _mm_set1_epi16(static_cast<int16_t>(c0));
+  __m128i needle1 = _mm_set1_epi16(static_cast<int16_t>(c1));
+  for (; i + kLanes <= limit; i += kLanes) {
+    __m128i block0 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i));
+    __m128i block1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i + 1));
+    __m128i matches = _mm_and_si128(_mm_cmpeq_epi16(block0, needle0),
+                                    _mm_cmpeq_epi16(block1, needle1));
+    if (_mm_movemask_epi8(matches) != 0) break;
+  }
+#elif defined(V8_STRING_SEARCH_NEON)
+  static const int kLanes = sizeof(uint16x8_t) / sizeof(uc16);
+  uint16x8_t needle0 = vdupq_n_u16(c0);
+  uint16x8_t needle1 = vdupq_n_u16(c1);
+  for (; i + kLanes <= limit; i += kLanes) {
+    uint16x8_t matches =
+        vandq_u16(vceqq_u16(vld1q_u16(chars + i), needle0),
+                  vceqq_u16(vld1q_u16(chars + i + 1), needle1));
+    uint64x2_t bits = vreinterpretq_u64_u16(matches);
+    if ((vgetq_lane_u64(bits, 0) | vgetq_lane_u64(bits, 1)) != 0) break;
+  }
+#endif
+  for (; i < limit; i++) {
+    if (chars[i] == c0 && chars[i + 1] == c1) return i;
+  }
+  return -1;
+}
+
+
 // Storage for constants used by string-search.
 
 // Now in Isolate:
@@ -32,6 +32,35 @@ namespace v8 {
 namespace internal {
 
 
+//---------------------------------------------------------------------
+// Character scanning primitives.
+//---------------------------------------------------------------------
+
+// Returns the smallest i in [index, limit) with subject[i] == c, or -1.
+// Uses SSE2 or NEON where available.
+int FindFirstCharacter(Vector<const char> subject,
+                       int index,
+                       int limit,
+                       char c);
+int FindFirstCharacter(Vector<const uc16> subject,
+                       int index,
+                       int limit,
+                       uc16 c);
+
+// Returns the smallest i in [index, limit) with subject[i] == c0 and
+// subject[i + 1] == c1, or -1.  Requires limit < subject.length().
+int FindCharacterPair(Vector<const char> subject,
+                      int index,
+                      int limit,
+                      char c0,
+                      char c1);
+int FindCharacterPair(Vector<const uc16> subject,
+                      int index,
+                      int limit,
+                      uc16 c0,
+                      uc16 c1);
+
+
 //---------------------------------------------------------------------
 // String Search object.
 //---------------------------------------------------------------------
@@ -213,27 +242,15 @@ int StringSearch<PatternChar, SubjectChar>::SingleCharSearch(
     int index) {
   ASSERT_EQ(1, search->pattern_.length());
   PatternChar pattern_first_char = search->pattern_[0];
-  int i = index;
-  if (sizeof(SubjectChar) == 1 && sizeof(PatternChar) == 1) {
-    const SubjectChar* pos = reinterpret_cast<const SubjectChar*>(
-        memchr(subject.start() + i,
-               pattern_first_char,
-               subject.length() - i));
-    if (pos == NULL) return -1;
-    return static_cast<int>(pos - subject.start());
-  } else {
-    if (sizeof(PatternChar) > sizeof(SubjectChar)) {
-      if (static_cast<uc16>(pattern_first_char) > String::kMaxAsciiCharCodeU) {
-        return -1;
-      }
-    }
-    SubjectChar search_char = static_cast<SubjectChar>(pattern_first_char);
-    int n = subject.length();
-    while (i < n) {
-      if (subject[i++] == search_char) return i - 1;
+  if (sizeof(PatternChar) > sizeof(SubjectChar)) {
+    if (static_cast<uc16>(pattern_first_char) > String::kMaxAsciiCharCodeU) {
+      return -1;
     }
-    return -1;
   }
+  return FindFirstCharacter(subject,
+                            index,
+                            subject.length(),
+                            static_cast<SubjectChar>(pattern_first_char));
 }
 
 //---------------------------------------------------------------------
@@ -266,27 +283,28 @@ int StringSearch<PatternChar, SubjectChar>::LinearSearch(
   Vector<const PatternChar> pattern = search->pattern_;
   ASSERT(pattern.length() > 1);
   int pattern_length = pattern.length();
-  PatternChar pattern_first_char = pattern[0];
+  // The constructor has checked that the pattern characters fit in the
+  // subject character type.
+  SubjectChar pattern_first_char = static_cast<SubjectChar>(pattern[0]);
+  SubjectChar pattern_second_char = static_cast<SubjectChar>(pattern[1]);
   int i = index;
   int n = subject.length() - pattern_length;
   while (i <= n) {
-    if (sizeof(SubjectChar) == 1 && sizeof(PatternChar) == 1) {
-      const SubjectChar* pos = reinterpret_cast<const SubjectChar*>(
-          memchr(subject.start() + i,
-                 pattern_first_char,
-                 n - i + 1));
-      if (pos == NULL) return -1;
-      i = static_cast<int>(pos - subject.start()) + 1;
-    } else {
-      if (subject[i++] != pattern_first_char) continue;
-    }
-    // Loop extracted to separate function to allow using return to do
-    // a deeper break.
-    if (CharCompare(pattern.start() + 1,
-                    subject.start() + i,
-                    pattern_length - 1)) {
-      return i - 1;
+    // Matching the first two characters at once rejects most candidate
+    // positions before CharCompare is reached.
+    i = FindCharacterPair(subject,
+                          i,
+                          n + 1,
+                          pattern_first_char,
+                          pattern_second_char);
+    if (i < 0) return -1;
+    if (pattern_length == 2 ||
+        CharCompare(pattern.start() + 2,
+                    subject.start() + i + 2,
+                    pattern_length - 2)) {
+      return i;
     }
+    i++;
   }
   return -1;
 }
@@ -517,18 +535,11 @@ int StringSearch<PatternChar, SubjectChar>::InitialSearch(
   for (int i = index, n = subject.length() - pattern_length; i <= n; i++) {
     badness++;
     if (badness <= 0) {
-      if (sizeof(SubjectChar) == 1 && sizeof(PatternChar) == 1) {
-        const SubjectChar* pos = reinterpret_cast<const SubjectChar*>(
-            memchr(subject.start() + i,
-                   pattern_first_char,
-                   n - i + 1));
-        if (pos == NULL) {
-          return -1;
-        }
-        i = static_cast<int>(pos - subject.start());
-      } else {
-        if (subject[i] != pattern_first_char) continue;
-      }
+      i = FindFirstCharacter(subject,
+                             i,
+                             n + 1,
+                             static_cast<SubjectChar>(pattern_first_char));
+      if (i < 0) return -1;
       int j = 1;
       do {
         if (pattern[j] != subject[i + j]) {
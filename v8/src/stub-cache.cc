@@ -41,16 +41,43 @@ namespace internal {
 // StubCache implementation.
 
 
-StubCache::StubCache(Isolate* isolate) : isolate_(isolate) {
+// Table sizes are bounded so that hashed offsets stay positive ints.
+static const int kMaxStubCacheTableSize = 1 << 20;
+
+
+static int StubCacheTableSize(int requested_size) {
+  return RoundUpToPowerOf2(Max(1, Min(requested_size,
+                                      kMaxStubCacheTableSize)));
+}
+
+
+StubCache::StubCache(Isolate* isolate)
+    : isolate_(isolate) {
   ASSERT(isolate == Isolate::Current());
-  memset(primary_, 0, sizeof(primary_[0]) * StubCache::kPrimaryTableSize);
-  memset(secondary_, 0, sizeof(secondary_[0]) * StubCache::kSecondaryTableSize);
+  primary_size_ = StubCacheTableSize(FLAG_stub_cache_primary_size);
+  secondary_size_ = StubCacheTableSize(FLAG_stub_cache_secondary_size);
+  primary_mask_ = (primary_size_ - 1) << kHeapObjectTagSize;
+  secondary_mask_ = (secondary_size_ - 1) << kHeapObjectTagSize;
+  for (int kind = 0; kind < kCacheKindCount; kind++) {
+    primary_[kind] = NewArray<Entry>(primary_size_);
+    secondary_[kind] = NewArray<Entry>(secondary_size_);
+    memset(primary_[kind], 0, sizeof(Entry) * primary_size_);
+    memset(secondary_[kind], 0, sizeof(Entry) * secondary_size_);
+  }
+}
+
+
+StubCache::~StubCache() {
+  for (int kind = 0; kind < kCacheKindCount; kind++) {
+    DeleteArray(primary_[kind]);
+    DeleteArray(secondary_[kind]);
+  }
 }
 
 
 void StubCache::Initialize(bool create_heap_objects) {
-  ASSERT(IsPowerOf2(kPrimaryTableSize));
-  ASSERT(IsPowerOf2(kSecondaryTableSize));
+  ASSERT(IsPowerOf2(primary_size_));
+  ASSERT(IsPowerOf2(secondary_size_));
   if (create_heap_objects) {
     HandleScope scope;
     Clear();
@@ -77,9 +104,11 @@ Code* StubCache::Set(String* name, Map* map, Code* code) {
   // Make sure that the code type is not included in the hash.
   ASSERT(Code::ExtractTypeFromFlags(flags) == 0);
 
+  CacheKind kind = CacheKindForFlags(flags);
+
   // Compute the primary entry.
   int primary_offset = PrimaryOffset(name, flags, map);
-  Entry* primary = entry(primary_, primary_offset);
+  Entry* primary = entry(primary_[kind], primary_offset);
   Code* hit = primary->value;
 
   // If the primary entry has useful data in it, we retire it to the
@@ -88,7 +117,7 @@ Code* StubCache::Set(String* name, Map* map, Code* code) {
     Code::Flags primary_flags = Code::RemoveTypeFromFlags(hit->flags());
     int secondary_offset =
         SecondaryOffset(primary->key, primary_flags, primary_offset);
-    Entry* secondary = entry(secondary_, secondary_offset);
+    Entry* secondary = entry(secondary_[kind], secondary_offset);
     *secondary = *primary;
   }
 
@@ -1219,15 +1248,96 @@ MaybeObject* StubCache::ComputeCallDebugPrepareStepIn(int argc,
 
 
 void StubCache::Clear() {
-  for (int i = 0; i < kPrimaryTableSize; i++) {
-    primary_[i].key = heap()->empty_string();
-    primary_[i].value = isolate_->builtins()->builtin(
-        Builtins::kIllegal);
+  Code* empty = isolate_->builtins()->builtin(Builtins::kIllegal);
+  for (int kind = 0; kind < kCacheKindCount; kind++) {
+    for (int i = 0; i < primary_size_; i++) {
+      primary_[kind][i].key = heap()->empty_string();
+      primary_[kind][i].value = empty;
+    }
+    for (int j = 0; j < secondary_size_; j++) {
+      secondary_[kind][j].key = heap()->empty_string();
+      secondary_[kind][j].value = empty;
+    }
   }
-  for (int j = 0; j < kSecondaryTableSize; j++) {
-    secondary_[j].key = heap()->empty_string();
-    secondary_[j].value = isolate_->builtins()->builtin(
-        Builtins::kIllegal);
+}
+
+
+StatsCounter* StubCache::hit_counter(CacheKind kind, Table table) {
+  Counters* counters = isolate_->counters();
+  bool primary = table == kPrimary;
+  switch (kind) {
+    case kLoadCache:
+      return primary ? counters->load_stub_cache_primary_hits()
+                     : counters->load_stub_cache_secondary_hits();
+    case kStoreCache:
+      return primary ? counters->store_stub_cache_primary_hits()
+                     : counters->store_stub_cache_secondary_hits();
+    case kCallCache:
+      return primary ? counters->call_stub_cache_primary_hits()
+                     : counters->call_stub_cache_secondary_hits();
+    default:
+      break;
+  }
+  UNREACHABLE();
+  return NULL;
+}
+
+
+StatsCounter* StubCache::miss_counter(CacheKind kind) {
+  Counters* counters = isolate_->counters();
+  switch (kind) {
+    case kLoadCache: return counters->load_stub_cache_misses();
+    case kStoreCache: return counters->store_stub_cache_misses();
+    case kCallCache: return counters->call_stub_cache_misses();
+    default: break;
+  }
+  UNREACHABLE();
+  return NULL;
+}
+
+
+// The flags the generated probe compares against.
+static Code::Flags LookupFlags(Code* code) {
+  return static_cast<Code::Flags>(code->flags() &
+                                  ~Code::kFlagsNotUsedInLookup);
+}
+
+
+void StubCache::CountMegamorphicMiss(String* name,
+                                     Object* receiver,
+                                     Code::Flags flags) {
+  if (!FLAG_native_code_counters || !name->IsSymbol()) return;
+  CacheKind kind = CacheKindForFlags(flags);
+  // Call ICs probe again with the prototype map of value receivers,
+  // see GenerateMonomorphicCacheProbe.
+  Map* maps[2];
+  int map_count = 0;
+  if (receiver->IsHeapObject()) {
+    maps[map_count++] = HeapObject::cast(receiver)->map();
+  }
+  if (kind == kCallCache &&
+      (receiver->IsNumber() || receiver->IsString() ||
+       receiver->IsBoolean())) {
+    maps[map_count++] =
+        HeapObject::cast(receiver->GetPrototype())->map();
+  }
+  for (int i = 0; i < map_count; i++) {
+    int primary_offset = PrimaryOffset(name, flags, maps[i]);
+    Entry* primary = entry(primary_[kind], primary_offset);
+    Table table;
+    if (primary->key == name && LookupFlags(primary->value) == flags) {
+      table = kPrimary;
+    } else {
+      int secondary_offset = SecondaryOffset(name, flags, primary_offset);
+      Entry* secondary = entry(secondary_[kind], secondary_offset);
+      if (secondary->key != name || LookupFlags(secondary->value) != flags) {
+        continue;
+      }
+      table = kSecondary;
+    }
+    hit_counter(kind, table)->Decrement();
+    miss_counter(kind)->Increment();
+    return;
   }
 }
 
@@ -1235,30 +1345,33 @@ void StubCache::Clear() {
 void StubCache::CollectMatchingMaps(ZoneMapList* types,
                                     String* name,
                                     Code::Flags flags) {
-  for (int i = 0; i < kPrimaryTableSize; i++) {
-    if (primary_[i].key == name) {
-      Map* map = primary_[i].value->FindFirstMap();
+  CacheKind kind = CacheKindForFlags(flags);
+  Entry* primary = primary_[kind];
+  Entry* secondary = secondary_[kind];
+  for (int i = 0; i < primary_size_; i++) {
+    if (primary[i].key == name) {
+      Map* map = primary[i].value->FindFirstMap();
       // Map can be NULL, if the stub is constant function call
       // with a primitive receiver.
       if (map == NULL) continue;
 
       int offset = PrimaryOffset(name, flags, map);
-      if (entry(primary_, offset) == &primary_[i]) {
+      if (entry(primary, offset) == &primary[i]) {
         types->Add(Handle<Map>(map));
       }
     }
   }
 
-  for (int i = 0; i < kSecondaryTableSize; i++) {
-    if (secondary_[i].key == name) {
-      Map* map = secondary_[i].value->FindFirstMap();
+  for (int i = 0; i < secondary_size_; i++) {
+    if (secondary[i].key == name) {
+      Map* map = secondary[i].value->FindFirstMap();
       // Map can be NULL, if the stub is constant function call
       // with a primitive receiver.
       if (map == NULL) continue;
 
       // Lookup in primary table and skip duplicates.
       int primary_offset = PrimaryOffset(name, flags, map);
-      Entry* primary_entry = entry(primary_, primary_offset);
+      Entry* primary_entry = entry(primary, primary_offset);
       if (primary_entry->key == name) {
         Map* primary_map = primary_entry->value->FindFirstMap();
         if (map == primary_map) continue;
@@ -1266,7 +1379,7 @@ void StubCache::CollectMatchingMaps(ZoneMapList* types,
 
       // Lookup in secondary table and add matches.
       int offset = SecondaryOffset(name, flags, primary_offset);
-      if (entry(secondary_, offset) == &secondary_[i]) {
+      if (entry(secondary, offset) == &secondary[i]) {
         types->Add(Handle<Map>(map));
       }
     }
@@ -284,6 +284,12 @@ class StubCache {
                            String* name,
                            Code::Flags flags);
 
+  // Called by the IC miss handlers when a megamorphic IC missed.  The
+  // probe counts a hit as soon as name and flags match, so if the stub it
+  // found rejected the receiver the hit is turned into a miss here.  Only
+  // does work with --native-code-counters.
+  void CountMegamorphicMiss(String* name, Object* receiver, Code::Flags flags);
+
   // Generate code for probing the stub cache table.
   // Arguments extra and extra2 may be used to pass additional scratch
   // registers. Set to no_reg if not needed.
@@ -295,48 +301,89 @@ class StubCache {
                      Register extra,
                      Register extra2 = no_reg);
 
+  // Load, store and call ICs each have their own pair of tables, so that
+  // a workload that is megamorphic in one kind of IC does not evict the
+  // stubs of the others.
+  enum CacheKind {
+    kLoadCache,
+    kStoreCache,
+    kCallCache,
+    kCacheKindCount
+  };
+
   enum Table {
     kPrimary,
     kSecondary
   };
 
+  static CacheKind CacheKindForFlags(Code::Flags flags) {
+    switch (Code::ExtractKindFromFlags(flags)) {
+      case Code::LOAD_IC: return kLoadCache;
+      case Code::STORE_IC: return kStoreCache;
+      case Code::CALL_IC:
+      case Code::KEYED_CALL_IC: return kCallCache;
+      default: break;
+    }
+    UNREACHABLE();
+    return kLoadCache;
+  }
+
 
-  SCTableReference key_reference(StubCache::Table table) {
+  SCTableReference key_reference(CacheKind kind, StubCache::Table table) {
     return SCTableReference(
-        reinterpret_cast<Address>(&first_entry(table)->key));
+        reinterpret_cast<Address>(&first_entry(kind, table)->key));
   }
 
 
-  SCTableReference value_reference(StubCache::Table table) {
+  SCTableReference value_reference(CacheKind kind, StubCache::Table table) {
     return SCTableReference(
-        reinterpret_cast<Address>(&first_entry(table)->value));
+        reinterpret_cast<Address>(&first_entry(kind, table)->value));
+  }
+
+
+  // The table sizes are only known at isolate creation, so generated code
+  // loads the masks that turn a hash into a table offset from here.
+  SCTableReference mask_reference(StubCache::Table table) {
+    return SCTableReference(reinterpret_cast<Address>(
+        table == kPrimary ? &primary_mask_ : &secondary_mask_));
   }
 
 
-  StubCache::Entry* first_entry(StubCache::Table table) {
+  StubCache::Entry* first_entry(CacheKind kind, StubCache::Table table) {
     switch (table) {
-      case StubCache::kPrimary: return StubCache::primary_;
-      case StubCache::kSecondary: return StubCache::secondary_;
+      case StubCache::kPrimary: return StubCache::primary_[kind];
+      case StubCache::kSecondary: return StubCache::secondary_[kind];
     }
     UNREACHABLE();
     return NULL;
   }
 
+  // Counters updated by the generated probe code.
+  StatsCounter* hit_counter(CacheKind kind, StubCache::Table table);
+  StatsCounter* miss_counter(CacheKind kind);
+
+  int primary_table_size() const { return primary_size_; }
+  int secondary_table_size() const { return secondary_size_; }
+
   Isolate* isolate() { return isolate_; }
   Heap* heap() { return isolate()->heap(); }
 
  private:
   explicit StubCache(Isolate* isolate);
+  ~StubCache();
 
   friend class Isolate;
   friend class SCTableReference;
-  static const int kPrimaryTableSize = 2048;
-  static const int kSecondaryTableSize = 512;
-  Entry primary_[kPrimaryTableSize];
-  Entry secondary_[kSecondaryTableSize];
+  int primary_size_;
+  int secondary_size_;
+  // Hash masks, already shifted by kHeapObjectTagSize.
+  int32_t primary_mask_;
+  int32_t secondary_mask_;
+  Entry* primary_[kCacheKindCount];
+  Entry* secondary_[kCacheKindCount];
 
   // Computes the hashed offsets for primary and secondary caches.
-  RLYSTC int PrimaryOffset(String* name, Code::Flags flags, Map* map) {
+  int PrimaryOffset(String* name, Code::Flags flags, Map* map) {
     // This works well because the heap object tag size and the hash
     // shift are equal.  Shifting down the length field to get the
     // hash code would effectively throw away two bits of the hash
@@ -356,10 +403,10 @@ class StubCache {
         (static_cast<uint32_t>(flags) & ~Code::kFlagsNotUsedInLookup);
     // Base the offset on a simple combination of name, flags, and map.
     uint32_t key = (map_low32bits + field) ^ iflags;
-    return key & ((kPrimaryTableSize - 1) << kHeapObjectTagSize);
+    return key & primary_mask_;
   }
 
-  RLYSTC int SecondaryOffset(String* name, Code::Flags flags, int seed) {
+  int SecondaryOffset(String* name, Code::Flags flags, int seed) {
     // Use the seed from the primary cache in the secondary cache.
     uint32_t string_low32bits =
         static_cast<uint32_t>(reinterpret_cast<uintptr_t>(name));
@@ -368,7 +415,7 @@ class StubCache {
     uint32_t iflags =
         (static_cast<uint32_t>(flags) & ~Code::kFlagsICInLoopMask);
     uint32_t key = seed - string_low32bits + iflags;
-    return key & ((kSecondaryTableSize - 1) << kHeapObjectTagSize);
+    return key & secondary_mask_;
   }
 
   // Compute the entry for a given offset in exactly the same way as
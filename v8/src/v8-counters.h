@@ -80,6 +80,8 @@ namespace internal {
   SC(compilation_cache_misses, V8.CompilationCacheMisses)             \
   SC(regexp_cache_hits, V8.RegExpCacheHits)                           \
   SC(regexp_cache_misses, V8.RegExpCacheMisses)                       \
+  SC(regexp_results_cache_hits, V8.RegExpResultsCacheHits)            \
+  SC(regexp_results_cache_misses, V8.RegExpResultsCacheMisses)        \
   SC(string_ctor_calls, V8.StringConstructorCalls)                    \
   SC(string_ctor_conversions, V8.StringConstructorConversions)        \
   SC(string_ctor_cached_number, V8.StringConstructorCachedNumber)     \
@@ -199,6 +201,15 @@ namespace internal {
   SC(constructed_objects_stub, V8.ConstructedObjectsStub)             \
   SC(negative_lookups, V8.NegativeLookups)                            \
   SC(negative_lookups_miss, V8.NegativeLookupsMiss)                   \
+  SC(load_stub_cache_primary_hits, V8.LoadStubCachePrimaryHits)       \
+  SC(load_stub_cache_secondary_hits, V8.LoadStubCacheSecondaryHits)   \
+  SC(load_stub_cache_misses, V8.LoadStubCacheMisses)                  \
+  SC(store_stub_cache_primary_hits, V8.StoreStubCachePrimaryHits)     \
+  SC(store_stub_cache_secondary_hits, V8.StoreStubCacheSecondaryHits) \
+  SC(store_stub_cache_misses, V8.StoreStubCacheMisses)                \
+  SC(call_stub_cache_primary_hits, V8.CallStubCachePrimaryHits)       \
+  SC(call_stub_cache_secondary_hits, V8.CallStubCacheSecondaryHits)   \
+  SC(call_stub_cache_misses, V8.CallStubCacheMisses)                  \
   SC(array_function_runtime, V8.ArrayFunctionRuntime)                 \
   SC(array_function_native, V8.ArrayFunctionNative)                   \
   SC(for_in, V8.ForIn)                                                \
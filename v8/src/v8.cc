@@ -155,6 +155,9 @@ bool V8::IdleNotification() {
   // IdleNotification again.
   if (!FLAG_use_idle_notification) return true;
 
+  // Give zone segments that are no longer needed back to the system.
+  ZONE->TrimSegmentPool();
+
   // Tell the heap that it may want to adjust.
   return HEAP->IdleNotification();
 }
@@ -43,30 +43,39 @@ bool Locker::active_ = false;
 
 
 // Constructor for the Locker object.  Once the Locker is constructed the
-// current thread will be guaranteed to have the big V8 lock.
-Locker::Locker() : has_lock_(false), top_level_(true) {
-  // TODO(isolates): When Locker has Isolate parameter and it is provided, grab
-  // that one instead of using the current one.
-  // We pull default isolate for Locker constructor w/o p[arameter.
-  // A thread should not enter an isolate before acquiring a lock,
-  // in cases which mandate using Lockers.
-  // So getting a lock is the first thing threads do in a scenario where
-  // multple threads share an isolate. Hence, we need to access
-  // 'locking isolate' before we can actually enter into default isolate.
-  internal::Isolate* isolate = internal::Isolate::GetDefaultIsolateForLocking();
-  ASSERT(isolate != NULL);
+// current thread will be guaranteed to have the big lock of the isolate.
+Locker::Locker(v8::Isolate* isolate)
+    : has_lock_(false),
+      top_level_(true),
+      entered_(false),
+      isolate_(reinterpret_cast<internal::Isolate*>(isolate)) {
+  // Without an isolate parameter we lock the default isolate.  A thread
+  // should not enter an isolate before acquiring a lock, in cases which
+  // mandate using Lockers.  So getting a lock is the first thing threads do
+  // in a scenario where multiple threads share an isolate.  Hence, we need
+  // to access 'locking isolate' before we can actually enter into it.
+  if (isolate_ == NULL) {
+    isolate_ = internal::Isolate::GetDefaultIsolateForLocking();
+  }
+  ASSERT(isolate_ != NULL);
 
   // Record that the Locker has been used at least once.
   active_ = true;
   // Get the big lock if necessary.
-  if (!isolate->thread_manager()->IsLockedByCurrentThread()) {
-    isolate->thread_manager()->Lock();
+  if (!isolate_->thread_manager()->IsLockedByCurrentThread()) {
+    isolate_->thread_manager()->Lock();
     has_lock_ = true;
 
-    if (isolate->IsDefaultIsolate()) {
+    if (isolate_->IsDefaultIsolate()) {
       // This only enters if not yet entered.
       internal::Isolate::EnterDefaultIsolate();
+    } else {
+      // The thread state below is per isolate and thread, so the isolate
+      // has to be entered while it is restored and archived.
+      isolate_->Enter();
+      entered_ = true;
     }
+    isolate_->thread_manager()->set_locker_entered_isolate(entered_);
 
     ASSERT(internal::Thread::HasThreadLocal(
         internal::Isolate::thread_id_key()));
@@ -74,59 +83,72 @@ Locker::Locker() : has_lock_(false), top_level_(true) {
     // Make sure that V8 is initialized.  Archiving of threads interferes
     // with deserialization by adding additional root pointers, so we must
     // initialize here, before anyone can call ~Locker() or Unlocker().
-    if (!isolate->IsInitialized()) {
+    if (!isolate_->IsInitialized()) {
       V8::Initialize();
     }
     // This may be a locker within an unlocker in which case we have to
     // get the saved state for this thread and restore it.
-    if (isolate->thread_manager()->RestoreThread()) {
+    if (isolate_->thread_manager()->RestoreThread()) {
       top_level_ = false;
     } else {
-      internal::ExecutionAccess access(isolate);
-      isolate->stack_guard()->ClearThread(access);
-      isolate->stack_guard()->InitThread(access);
+      internal::ExecutionAccess access(isolate_);
+      isolate_->stack_guard()->ClearThread(access);
+      isolate_->stack_guard()->InitThread(access);
     }
   }
-  ASSERT(isolate->thread_manager()->IsLockedByCurrentThread());
+  ASSERT(isolate_->thread_manager()->IsLockedByCurrentThread());
 }
 
 
-bool Locker::IsLocked() {
-  return internal::Isolate::Current()->thread_manager()->
-      IsLockedByCurrentThread();
+bool Locker::IsLocked(v8::Isolate* isolate) {
+  internal::Isolate* internal_isolate =
+      reinterpret_cast<internal::Isolate*>(isolate);
+  if (internal_isolate == NULL) internal_isolate = internal::Isolate::Current();
+  return internal_isolate->thread_manager()->IsLockedByCurrentThread();
 }
 
 
 Locker::~Locker() {
-  // TODO(isolate): this should use a field storing the isolate it
-  // locked instead.
-  internal::Isolate* isolate = internal::Isolate::Current();
-  ASSERT(isolate->thread_manager()->IsLockedByCurrentThread());
+  ASSERT(isolate_->thread_manager()->IsLockedByCurrentThread());
   if (has_lock_) {
     if (top_level_) {
-      isolate->thread_manager()->FreeThreadResources();
+      isolate_->thread_manager()->FreeThreadResources();
     } else {
-      isolate->thread_manager()->ArchiveThread();
+      isolate_->thread_manager()->ArchiveThread();
     }
-    isolate->thread_manager()->Unlock();
+    // The entry stack is shared by all threads using the isolate, so leave
+    // it while still holding the lock. Otherwise another thread could enter
+    // in between, and this thread would pop that thread's entry.
+    if (entered_) isolate_->Exit();
+    isolate_->thread_manager()->set_locker_entered_isolate(false);
+    isolate_->thread_manager()->Unlock();
   }
 }
 
 
-Unlocker::Unlocker() {
-  internal::Isolate* isolate = internal::Isolate::Current();
-  ASSERT(isolate->thread_manager()->IsLockedByCurrentThread());
-  isolate->thread_manager()->ArchiveThread();
-  isolate->thread_manager()->Unlock();
+Unlocker::Unlocker(v8::Isolate* isolate)
+    : isolate_(reinterpret_cast<internal::Isolate*>(isolate)),
+      exited_(false) {
+  if (isolate_ == NULL) isolate_ = internal::Isolate::Current();
+  ASSERT(isolate_->thread_manager()->IsLockedByCurrentThread());
+  isolate_->thread_manager()->ArchiveThread();
+  // Leave the isolate if the Locker entered it, so that other threads can
+  // enter it and leave it again while this one is unlocked.
+  if (isolate_->thread_manager()->locker_entered_isolate()) {
+    isolate_->Exit();
+    exited_ = true;
+  }
+  isolate_->thread_manager()->set_locker_entered_isolate(false);
+  isolate_->thread_manager()->Unlock();
 }
 
 
 Unlocker::~Unlocker() {
-  // TODO(isolates): check it's the isolate we unlocked.
-  internal::Isolate* isolate = internal::Isolate::Current();
-  ASSERT(!isolate->thread_manager()->IsLockedByCurrentThread());
-  isolate->thread_manager()->Lock();
-  isolate->thread_manager()->RestoreThread();
+  ASSERT(!isolate_->thread_manager()->IsLockedByCurrentThread());
+  isolate_->thread_manager()->Lock();
+  if (exited_) isolate_->Enter();
+  isolate_->thread_manager()->set_locker_entered_isolate(exited_);
+  isolate_->thread_manager()->RestoreThread();
 }
 
 
@@ -285,6 +307,7 @@ ThreadManager::ThreadManager()
       mutex_owner_(ThreadId::Invalid()),
       lazily_archived_thread_(ThreadId::Invalid()),
       lazily_archived_thread_state_(NULL),
+      locker_entered_isolate_(false),
       free_anchor_(NULL),
       in_use_anchor_(NULL) {
   free_anchor_ = new ThreadState(this);
@@ -101,6 +101,13 @@ class ThreadManager {
     return mutex_owner_.Equals(ThreadId::Current());
   }
 
+  // Whether the Locker that took the lock for the thread holding it also
+  // entered the isolate, which an Unlocker then has to leave and re-enter.
+  bool locker_entered_isolate() { return locker_entered_isolate_; }
+  void set_locker_entered_isolate(bool entered) {
+    locker_entered_isolate_ = entered;
+  }
+
   ThreadId CurrentId();
 
   void TerminateExecution(ThreadId thread_id);
@@ -119,6 +126,7 @@ class ThreadManager {
   ThreadId mutex_owner_;
   ThreadId lazily_archived_thread_;
   ThreadState* lazily_archived_thread_state_;
+  bool locker_entered_isolate_;
 
   // In the following two lists there is always at least one object on the list.
   // The first object is a flying anchor that is only there to simplify linking
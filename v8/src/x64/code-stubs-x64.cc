@@ -3401,7 +3401,25 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   __ testb(result_, Immediate(kIsConsStringMask));
   __ j(zero, &call_runtime_);
 
+  // SlicedString.
+  // Read the character straight out of the parent when the parent is
+  // sequential.  The index is shifted by the slice offset.
+  Label cons_string;
+  __ testb(result_, Immediate(kSlicedNotConsMask));
+  __ j(zero, &cons_string);
+  __ movq(result_, FieldOperand(object_, SlicedString::kParentOffset));
+  __ movq(result_, FieldOperand(result_, HeapObject::kMapOffset));
+  __ movzxbl(result_, FieldOperand(result_, Map::kInstanceTypeOffset));
+  STATIC_ASSERT(kSeqStringTag == 0);
+  __ testb(result_, Immediate(kStringRepresentationMask));
+  __ j(not_zero, &call_runtime_);
+  // Both the index and the offset are smis.
+  __ addq(scratch_, FieldOperand(object_, SlicedString::kOffsetOffset));
+  __ movq(object_, FieldOperand(object_, SlicedString::kParentOffset));
+  __ jmp(&flat_string);
+
   // ConsString.
+  __ bind(&cons_string);
   // Check whether the right hand side is the empty string (i.e. if
   // this is really a flat string in a cons string). If that is not
   // the case we would rather go to the runtime system now to flatten
@@ -4185,6 +4203,62 @@ void SubStringStub::Generate(MacroAssembler* masm) {
 
   __ bind(&result_longer_than_two);
 
+  if (FLAG_string_slices) {
+    // rax: string
+    // rbx: instance type
+    // rcx: result string length
+    // Long enough substrings of flat strings share the characters of the
+    // underlying sequential or external string instead of copying them.
+    Label copy_routine, sliced_string, seq_or_external_string;
+    Label underlying_found, two_byte_slice, set_slice_header;
+    __ cmpl(rcx, Immediate(SlicedString::kMinLength));
+    __ j(less, &copy_routine);
+    __ movq(rdx, Operand(rsp, kFromOffset));
+    __ testb(rbx, Immediate(kIsConsStringMask));
+    __ j(zero, &seq_or_external_string);
+    __ testb(rbx, Immediate(kSlicedNotConsMask));
+    __ j(not_zero, &sliced_string);
+    // Cons string.  Only a flattened one has its characters in one place.
+    __ CompareRoot(FieldOperand(rax, ConsString::kSecondOffset),
+                   Heap::kEmptyStringRootIndex);
+    __ j(not_equal, &runtime);
+    __ movq(rdi, FieldOperand(rax, ConsString::kFirstOffset));
+    __ jmp(&underlying_found);
+    __ bind(&sliced_string);
+    // A slice of a slice points at the original parent.  Both offsets are
+    // smis.
+    __ addq(rdx, FieldOperand(rax, SlicedString::kOffsetOffset));
+    __ movq(rdi, FieldOperand(rax, SlicedString::kParentOffset));
+    __ jmp(&underlying_found);
+    __ bind(&seq_or_external_string);
+    __ movq(rdi, rax);
+    __ bind(&underlying_found);
+    // rdi: underlying string
+    // rdx: offset of the substring in the underlying string (smi)
+    // rcx: result string length
+    __ movq(rbx, FieldOperand(rdi, HeapObject::kMapOffset));
+    __ movzxbl(rbx, FieldOperand(rbx, Map::kInstanceTypeOffset));
+    __ testb(rbx, Immediate(kIsConsStringMask));
+    __ j(not_zero, &runtime);
+    __ Integer32ToSmi(rcx, rcx);
+    __ testb(rbx, Immediate(kStringEncodingMask));
+    __ j(zero, &two_byte_slice);
+    __ AllocateAsciiSlicedString(rax, rbx, r14, &runtime);
+    __ jmp(&set_slice_header);
+    __ bind(&two_byte_slice);
+    __ AllocateSlicedString(rax, rbx, r14, &runtime);
+    __ bind(&set_slice_header);
+    __ movq(FieldOperand(rax, String::kLengthOffset), rcx);
+    __ movl(FieldOperand(rax, String::kHashFieldOffset),
+            Immediate(String::kEmptyHashField));
+    __ movq(FieldOperand(rax, SlicedString::kParentOffset), rdi);
+    __ movq(FieldOperand(rax, SlicedString::kOffsetOffset), rdx);
+    __ IncrementCounter(masm->isolate()->counters()->sub_string_native(), 1);
+    __ ret(kArgumentsSize);
+
+    __ bind(&copy_routine);
+  }
+
   // rax: string
   // rbx: instance type
   // rcx: result string length
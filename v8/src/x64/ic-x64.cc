@@ -919,10 +919,13 @@ static void GenerateMonomorphicCacheProbe(MacroAssembler* masm,
   StubCompiler::GenerateLoadGlobalFunctionPrototype(
       masm, Context::BOOLEAN_FUNCTION_INDEX, rdx);
 
-  // Probe the stub cache for the value object.
+  // Probe the stub cache for the value object. The probe with the
+  // receiver's own map has already counted a miss, so take it back to
+  // count the call once.
   __ bind(&probe);
-  Isolate::Current()->stub_cache()->GenerateProbe(masm, flags, rdx, rcx, rbx,
-                                                  no_reg);
+  StubCache* stub_cache = Isolate::Current()->stub_cache();
+  __ DecrementCounter(stub_cache->miss_counter(StubCache::kCallCache), 1);
+  stub_cache->GenerateProbe(masm, flags, rdx, rcx, rbx, no_reg);
 
   __ bind(&miss);
 }
@@ -3126,7 +3126,8 @@ void LCodeGen::DoStringCharCodeAt(LStringCharCodeAt* instr) {
   DeferredStringCharCodeAt* deferred =
       new DeferredStringCharCodeAt(this, instr);
 
-  NearLabel flat_string, ascii_string, done;
+  NearLabel flat_string, ascii_string;
+  Label cons_string, sliced_ascii_string, done;
 
   // Fetch the instance type of the receiver into result register.
   __ movq(result, FieldOperand(string, HeapObject::kMapOffset));
@@ -3137,11 +3138,49 @@ void LCodeGen::DoStringCharCodeAt(LStringCharCodeAt* instr) {
   __ testb(result, Immediate(kStringRepresentationMask));
   __ j(zero, &flat_string);
 
-  // Handle cons strings and go to deferred code for the rest.
+  // Handle cons and sliced strings and go to deferred code for the rest.
   __ testb(result, Immediate(kIsConsStringMask));
   __ j(zero, deferred->entry());
+  __ testb(result, Immediate(kSlicedNotConsMask));
+  __ j(zero, &cons_string);
+
+  // SlicedString.
+  // Read the character out of a sequential parent without touching the
+  // string and index registers.  The parent goes in kScratchRegister and
+  // the index shifted by the slice offset in the result register.
+  __ movq(kScratchRegister, FieldOperand(string, SlicedString::kParentOffset));
+  __ movq(result, FieldOperand(kScratchRegister, HeapObject::kMapOffset));
+  __ movzxbl(result, FieldOperand(result, Map::kInstanceTypeOffset));
+  __ testb(result, Immediate(kStringRepresentationMask));
+  __ j(not_zero, deferred->entry());
+  __ testb(result, Immediate(kStringEncodingMask));
+  __ j(not_zero, &sliced_ascii_string);
+  __ SmiToInteger32(result, FieldOperand(string, SlicedString::kOffsetOffset));
+  if (instr->index()->IsConstantOperand()) {
+    __ addl(result, Immediate(const_index));
+  } else {
+    __ addl(result, index);
+  }
+  __ movzxwl(result, FieldOperand(kScratchRegister,
+                                  result,
+                                  times_2,
+                                  SeqTwoByteString::kHeaderSize));
+  __ jmp(&done);
+  __ bind(&sliced_ascii_string);
+  __ SmiToInteger32(result, FieldOperand(string, SlicedString::kOffsetOffset));
+  if (instr->index()->IsConstantOperand()) {
+    __ addl(result, Immediate(const_index));
+  } else {
+    __ addl(result, index);
+  }
+  __ movzxbl(result, FieldOperand(kScratchRegister,
+                                  result,
+                                  times_1,
+                                  SeqAsciiString::kHeaderSize));
+  __ jmp(&done);
 
   // ConsString.
+  __ bind(&cons_string);
   // Check whether the right hand side is the empty string (i.e. if
   // this is really a flat string in a cons string). If that is not
   // the case we would rather go to the runtime system now to flatten
@@ -47,9 +47,11 @@ static void ProbeTable(Isolate* isolate,
                        Register offset) {
   ASSERT_EQ(8, kPointerSize);
   ASSERT_EQ(16, sizeof(StubCache::Entry));
+  StubCache* stub_cache = isolate->stub_cache();
+  StubCache::CacheKind kind = StubCache::CacheKindForFlags(flags);
   // The offset register holds the entry offset times four (due to masking
   // and shifting optimizations).
-  ExternalReference key_offset(isolate->stub_cache()->key_reference(table));
+  ExternalReference key_offset(stub_cache->key_reference(kind, table));
   Label miss;
 
   __ LoadAddress(kScratchRegister, key_offset);
@@ -69,9 +71,14 @@ static void ProbeTable(Isolate* isolate,
   __ cmpl(offset, Immediate(flags));
   __ j(not_equal, &miss);
 
+  // The offset is no longer needed, so it can hold the code entry while
+  // the counter update clobbers the scratch register.
+  __ movq(offset, kScratchRegister);
+  __ IncrementCounter(stub_cache->hit_counter(kind, table), 1);
+
   // Jump to the first instruction in the code stub.
-  __ addq(kScratchRegister, Immediate(Code::kHeaderSize - kHeapObjectTag));
-  __ jmp(kScratchRegister);
+  __ addq(offset, Immediate(Code::kHeaderSize - kHeapObjectTag));
+  __ jmp(offset);
 
   __ bind(&miss);
 }
@@ -207,12 +214,17 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Check that the receiver isn't a smi.
   __ JumpIfSmi(receiver, &miss);
 
+  // The table sizes are chosen at isolate creation, so the masks are
+  // loaded from the stub cache rather than embedded in the code.
+  ExternalReference primary_mask(mask_reference(kPrimary));
+  ExternalReference secondary_mask(mask_reference(kSecondary));
+
   // Get the map of the receiver and compute the hash.
   __ movl(scratch, FieldOperand(name, String::kHashFieldOffset));
   // Use only the low 32 bits of the map pointer.
   __ addl(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
   __ xor_(scratch, Immediate(flags));
-  __ and_(scratch, Immediate((kPrimaryTableSize - 1) << kHeapObjectTagSize));
+  __ andl(scratch, masm->ExternalOperand(primary_mask));
 
   // Probe the primary table.
   ProbeTable(isolate, masm, flags, kPrimary, name, scratch);
@@ -221,10 +233,10 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   __ movl(scratch, FieldOperand(name, String::kHashFieldOffset));
   __ addl(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
   __ xor_(scratch, Immediate(flags));
-  __ and_(scratch, Immediate((kPrimaryTableSize - 1) << kHeapObjectTagSize));
+  __ andl(scratch, masm->ExternalOperand(primary_mask));
   __ subl(scratch, name);
   __ addl(scratch, Immediate(flags));
-  __ and_(scratch, Immediate((kSecondaryTableSize - 1) << kHeapObjectTagSize));
+  __ andl(scratch, masm->ExternalOperand(secondary_mask));
 
   // Probe the secondary table.
   ProbeTable(isolate, masm, flags, kSecondary, name, scratch);
@@ -232,6 +244,7 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Cache miss: Fall-through and let caller handle the miss by
   // entering the runtime system.
   __ bind(&miss);
+  __ IncrementCounter(miss_counter(CacheKindForFlags(flags)), 1);
 }
 
 
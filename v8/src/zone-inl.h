@@ -60,6 +60,7 @@ inline void* Zone::New(int size) {
   // Check that the result has the proper alignment and return it.
   ASSERT(IsAddressAligned(result, kAlignment, 0));
   allocation_size_ += size;
+  bytes_allocated_ += size;
   return reinterpret_cast<void*>(result);
 }
 
@@ -77,6 +78,12 @@ bool Zone::excess_allocation() {
 
 void Zone::adjust_segment_bytes_allocated(int delta) {
   segment_bytes_allocated_ += delta;
+  if (segment_bytes_allocated_ > high_water_mark_) {
+    high_water_mark_ = segment_bytes_allocated_;
+    if (high_water_mark_ > peak_segment_bytes_allocated_) {
+      peak_segment_bytes_allocated_ = high_water_mark_;
+    }
+  }
   isolate_->counters()->zone_segment_bytes()->Set(segment_bytes_allocated_);
 }
 
@@ -40,7 +40,14 @@ Zone::Zone()
       position_(0),
       limit_(0),
       scope_nesting_(0),
-      segment_head_(NULL) {
+      segment_head_(NULL),
+      pooled_bytes_(0),
+      high_water_mark_(0),
+      bytes_allocated_(0),
+      segments_allocated_(0),
+      segments_reused_(0),
+      peak_segment_bytes_allocated_(0) {
+  for (int i = 0; i < kSegmentSizeClasses; i++) pooled_segments_[i] = NULL;
 }
 unsigned Zone::allocation_size_ = 0;
 
@@ -56,7 +63,7 @@ ZoneScope::~ZoneScope() {
 // (encoded in the this pointer) and a size in bytes. Segments are
 // chained together forming a LIFO structure with the newest segment
 // available as segment_head_. Segments are allocated using malloc()
-// and de-allocated using free().
+// and de-allocated using free(), or recycled through the segment pool.
 
 class Segment {
  public:
@@ -85,21 +92,107 @@ class Segment {
 // Creates a new segment, sets it size, and pushes it to the front
 // of the segment chain. Returns the new segment.
 Segment* Zone::NewSegment(int size) {
-  Segment* result = reinterpret_cast<Segment*>(Malloced::New(size));
-  adjust_segment_bytes_allocated(size);
+  Segment* result = TakePooledSegment(size);
   if (result != NULL) {
-    result->next_ = segment_head_;
+    segments_reused_++;
+  } else {
+    result = reinterpret_cast<Segment*>(Malloced::New(size));
+    if (result == NULL) return NULL;
     result->size_ = size;
-    segment_head_ = result;
+    segments_allocated_++;
   }
+  adjust_segment_bytes_allocated(result->size_);
+  result->next_ = segment_head_;
+  segment_head_ = result;
   return result;
 }
 
 
-// Deletes the given segment. Does not touch the segment chain.
+// Deletes the given segment, or returns it to the segment pool. Does
+// not touch the segment chain.
 void Zone::DeleteSegment(Segment* segment, int size) {
   adjust_segment_bytes_allocated(-size);
-  Malloced::Delete(segment);
+  int size_class = SegmentSizeClass(size);
+  if (FLAG_zone_segment_pool &&
+      size_class >= 0 &&
+      pooled_bytes_ + size <= kMaximumPooledBytes) {
+    // The header may have been zapped in debug mode.
+    segment->size_ = size;
+    segment->next_ = pooled_segments_[size_class];
+    pooled_segments_[size_class] = segment;
+    pooled_bytes_ += size;
+  } else {
+    Malloced::Delete(segment);
+  }
+}
+
+
+int Zone::SegmentSizeClass(int size) {
+  STATIC_ASSERT((kMinimumSegmentSize << (kSegmentSizeClasses - 1)) ==
+                kMaximumSegmentSize);
+  int class_size = kMinimumSegmentSize;
+  for (int i = 0; i < kSegmentSizeClasses; i++) {
+    if (size == class_size) return i;
+    class_size <<= 1;
+  }
+  return -1;
+}
+
+
+Segment* Zone::TakePooledSegment(int size) {
+  if (pooled_bytes_ == 0) return NULL;
+  int size_class = SegmentSizeClass(size);
+  if (size_class < 0) return NULL;
+  // A larger segment than requested is fine; the zone grows from the
+  // size of its newest segment.
+  for (int i = size_class; i < kSegmentSizeClasses; i++) {
+    Segment* segment = pooled_segments_[i];
+    if (segment != NULL) {
+      pooled_segments_[i] = segment->next();
+      pooled_bytes_ -= segment->size();
+      return segment;
+    }
+  }
+  return NULL;
+}
+
+
+void Zone::FreePooledSegments(int limit) {
+  for (int i = kSegmentSizeClasses - 1; i >= 0; i--) {
+    while (pooled_bytes_ > limit && pooled_segments_[i] != NULL) {
+      Segment* segment = pooled_segments_[i];
+      pooled_segments_[i] = segment->next();
+      pooled_bytes_ -= segment->size();
+      Malloced::Delete(segment);
+    }
+  }
+}
+
+
+void Zone::TrimSegmentPool() {
+  // Keep what the busiest period since the last trim needed, and start
+  // measuring again from what is in use now.  A zone that stays unused
+  // between two trims gives all its pooled segments back.
+  FreePooledSegments(Max(0, high_water_mark_ - segment_bytes_allocated_));
+  high_water_mark_ = segment_bytes_allocated_;
+}
+
+
+void Zone::TearDown() {
+  if (scope_nesting_ == 0) DeleteAll();
+  FreePooledSegments(0);
+}
+
+
+void Zone::PrintStatistics() {
+  PrintF("Zone statistics:\n");
+  PrintF("%30s - %.0f bytes\n", "Allocated in zone",
+         static_cast<double>(bytes_allocated_));
+  PrintF("%30s - %d\n", "Segments from malloc", segments_allocated_);
+  PrintF("%30s - %d\n", "Segments from pool", segments_reused_);
+  PrintF("%30s - %d bytes\n", "Peak segment bytes",
+         peak_segment_bytes_allocated_);
+  PrintF("%30s - %d bytes\n", "Pooled segment bytes", pooled_bytes_);
 }
 
 
@@ -109,14 +202,21 @@ void Zone::DeleteAll() {
   static const unsigned char kZapDeadByte = 0xcd;
 #endif
 
-  // Find a segment with a suitable size to keep around.
-  Segment* keep = segment_head_;
-  while (keep != NULL && keep->size() > kMaximumKeptSegmentSize) {
-    keep = keep->next();
+  // The segment bytes this use of the zone needed.
+  int bytes_in_use = segment_bytes_allocated_;
+
+  // Without the segment pool, find a segment with a suitable size to
+  // keep around.  With it, every segment goes back to the pool.
+  Segment* keep = NULL;
+  if (!FLAG_zone_segment_pool) {
+    keep = segment_head_;
+    while (keep != NULL && keep->size() > kMaximumKeptSegmentSize) {
+      keep = keep->next();
+    }
   }
 
   // Traverse the chained list of segments, zapping (in debug mode)
-  // and freeing every segment except the one we wish to keep.
+  // and releasing every segment except the one we wish to keep.
   Segment* current = segment_head_;
   while (current != NULL) {
     Segment* next = current->next();
@@ -152,6 +252,11 @@ void Zone::DeleteAll() {
 
   // Update the head segment to be the kept segment (if any).
   segment_head_ = keep;
+
+  // Keep no more pooled segments than this use of the zone needed, so
+  // that an embedder that never reports idle time does not hold on to
+  // the segments of an earlier, larger compilation.
+  FreePooledSegments(bytes_in_use);
 }
 
 
@@ -169,6 +274,11 @@ Address Zone::NewExpand(int size) {
   int old_size = (head == NULL) ? 0 : head->size();
   static const int kSegmentOverhead = sizeof(Segment) + kAlignment;
   int new_size = kSegmentOverhead + size + (old_size << 1);
+  if (FLAG_zone_segment_pool) {
+    // Pooled segments come in power-of-two size classes.  Doubling the
+    // newest segment keeps about the same growth rate.
+    new_size = RoundUpToPowerOf2(Max(old_size << 1, kSegmentOverhead + size));
+  }
   if (new_size < kMinimumSegmentSize) {
     new_size = kMinimumSegmentSize;
   } else if (new_size > kMaximumSegmentSize) {
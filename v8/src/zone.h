@@ -51,6 +51,13 @@ class Segment;
 // allocation is attempted, a segment of memory will be requested
 // through a call to malloc().
 
+// Segments released by DeleteAll() go to a pool owned by the zone, with
+// one free list per power-of-two size class, so that the next parse or
+// compilation in the same isolate does not go back to malloc().  DeleteAll()
+// keeps no more pooled bytes than the zone just had in use, and the pool is
+// trimmed to the recent high-water mark of zone usage when the embedder
+// reports that it is idle.
+
 // Note: The implementation is inherently not thread safe. Do not use
 // from multi-threaded code.
 
@@ -66,6 +73,21 @@ class Zone {
   // Delete all objects and free all memory allocated in the Zone.
   void DeleteAll();
 
+  // Free the pooled segments that exceed the largest number of segment
+  // bytes in use since the last trim.  Called when the embedder is idle.
+  void TrimSegmentPool();
+
+  // Delete all objects and free all memory, including the segment pool.
+  void TearDown();
+
+  // Print the allocation statistics of this zone (--trace-zone-stats).
+  void PrintStatistics();
+
+  int segment_bytes_allocated() const { return segment_bytes_allocated_; }
+  int pooled_segment_bytes() const { return pooled_bytes_; }
+  int segments_allocated() const { return segments_allocated_; }
+  int segments_reused() const { return segments_reused_; }
+
   // Returns true if more memory has been allocated in zones than
   // the limit allows.
   inline bool excess_allocation();
@@ -87,9 +109,17 @@ class Zone {
   // Never allocate segments larger than this size in bytes.
   static const int kMaximumSegmentSize = 1 * MB;
 
-  // Never keep segments larger than this size in bytes around.
+  // Without the segment pool, never keep segments larger than this size
+  // in bytes around.
   static const int kMaximumKeptSegmentSize = 64 * KB;
 
+  // Pooled segments have one of the power-of-two sizes from
+  // kMinimumSegmentSize to kMaximumSegmentSize.
+  static const int kSegmentSizeClasses = 8;
+
+  // Never keep more than this many bytes of free segments in the pool.
+  static const int kMaximumPooledBytes = 8 * MB;
+
   // Report zone excess when allocation exceeds this limit.
   int zone_excess_limit_;
 
@@ -111,9 +141,22 @@ class Zone {
   // of the segment chain. Returns the new segment.
   Segment* NewSegment(int size);
 
-  // Deletes the given segment. Does not touch the segment chain.
+  // Deletes the given segment, or returns it to the segment pool. Does
+  // not touch the segment chain.
   void DeleteSegment(Segment* segment, int size);
 
+  // Returns the size class of a segment of the given size, or -1 if
+  // segments of that size are not pooled.
+  static int SegmentSizeClass(int size);
+
+  // Removes a free segment of at least the given size from the pool.
+  // Returns NULL if the pool has none.
+  Segment* TakePooledSegment(int size);
+
+  // Frees pooled segments, largest first, until at most 'limit' bytes
+  // are left in the pool.
+  void FreePooledSegments(int limit);
+
   // The free region in the current (front) segment is represented as
   // the half-open interval [position, limit). The 'position' variable
   // is guaranteed to be aligned as dictated by kAlignment.
@@ -124,6 +167,20 @@ class Zone {
 
   Segment* segment_head_;
   Isolate* isolate_;
+
+  // Free segments by size class, chained through their next pointers.
+  Segment* pooled_segments_[kSegmentSizeClasses];
+  int pooled_bytes_;
+
+  // The largest value of segment_bytes_allocated_ since the segment pool
+  // was last trimmed.
+  int high_water_mark_;
+
+  // Allocation statistics.
+  int64_t bytes_allocated_;
+  int segments_allocated_;
+  int segments_reused_;
+  int peak_segment_bytes_allocated_;
 };
 
 
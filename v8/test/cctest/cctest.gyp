@@ -105,12 +105,14 @@
         'test-spaces.cc',
         'test-strings.cc',
         'test-strtod.cc',
+        'test-stub-cache.cc',
         'test-thread-termination.cc',
         'test-threads.cc',
         'test-type-info.cc',
         'test-unbound-queue.cc',
         'test-utils.cc',
-        'test-version.cc'
+        'test-version.cc',
+        'test-zone.cc'
       ],
       'conditions': [
         ['v8_target_arch=="ia32"', {
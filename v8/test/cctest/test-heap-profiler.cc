@@ -1046,6 +1046,112 @@ TEST(HeapSnapshotJSONSerializationAborting) {
 }
 
 
+static v8::Local<v8::Value> ParseStreamedSnapshot(LocalContext* env,
+                                                  TestJSONStream* stream,
+                                                  const char* name) {
+  CHECK_GT(stream->size(), 0);
+  CHECK_EQ(1, stream->eos_signaled());
+  i::Vector<char> json = i::Vector<char>::New(stream->size());
+  stream->WriteTo(json);
+  // The resource is leaked together with the external string it backs.
+  AsciiResource* json_res = new AsciiResource(json);
+  (*env)->Global()->Set(v8::String::New("json_snapshot"),
+                        v8::String::NewExternal(json_res));
+  i::EmbeddedVector<char, 64> source;
+  i::OS::SNPrintF(source, "var %s = JSON.parse(json_snapshot); true;", name);
+  return CompileRun(source.start());
+}
+
+
+TEST(HeapSnapshotStreaming) {
+  v8::HandleScope scope;
+  LocalContext env;
+
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "function B(x) { this.x = x; }\n"
+      "var a = new A('streamed string');\n"
+      "var b = new B(a);");
+  int saved_window = i::FLAG_heap_snapshot_stream_window;
+  TestJSONStream whole_stream;
+  CHECK(v8::HeapProfiler::StreamSnapshot(v8::String::New("whole"),
+                                         &whole_stream));
+  // Force a heap traversal for every few references.
+  i::FLAG_heap_snapshot_stream_window = 16;
+  TestJSONStream windowed_stream;
+  CHECK(v8::HeapProfiler::StreamSnapshot(v8::String::New("windowed"),
+                                         &windowed_stream));
+  i::FLAG_heap_snapshot_stream_window = saved_window;
+  // Streamed snapshots are not retained.
+  CHECK_EQ(0, v8::HeapProfiler::GetSnapshotsCount());
+
+  CHECK(!ParseStreamedSnapshot(&env, &whole_stream, "whole").IsEmpty());
+  CHECK(!ParseStreamedSnapshot(&env, &windowed_stream, "windowed").IsEmpty());
+
+  // Walk all nodes, check that every reference points at the beginning of
+  // a node, and find the string using the path: <root> -> <global>.b.x.s
+  CompileRun(
+      "function Check(parsed) {\n"
+      "  var meta = parsed.nodes[0];\n"
+      "  var count_offset = meta.fields.indexOf('children_count');\n"
+      "  var children_offset = meta.fields.indexOf('children');\n"
+      "  var children_meta = meta.types[children_offset];\n"
+      "  var edge_size = children_meta.fields.length;\n"
+      "  var type_offset = children_meta.fields.indexOf('type');\n"
+      "  var name_offset = children_meta.fields.indexOf('name_or_index');\n"
+      "  var to_offset = children_meta.fields.indexOf('to_node');\n"
+      "  var types = children_meta.types[type_offset];\n"
+      "  var nodes = parsed.nodes;\n"
+      "  var starts = {};\n"
+      "  var node_count = 0;\n"
+      "  var pos = 1;\n"
+      "  while (pos < nodes.length) {\n"
+      "    starts[pos] = true;\n"
+      "    node_count++;\n"
+      "    pos += children_offset + nodes[pos + count_offset] * edge_size;\n"
+      "  }\n"
+      "  if (pos != nodes.length) return null;\n"
+      "  for (pos in starts) {\n"
+      "    pos = +pos;\n"
+      "    for (var i = 0; i < nodes[pos + count_offset]; i++) {\n"
+      "      var edge = pos + children_offset + i * edge_size;\n"
+      "      if (!starts[nodes[edge + to_offset]]) return null;\n"
+      "    }\n"
+      "  }\n"
+      "  function Child(pos, name, type) {\n"
+      "    for (var i = 0; i < nodes[pos + count_offset]; i++) {\n"
+      "      var edge = pos + children_offset + i * edge_size;\n"
+      "      if (nodes[edge + type_offset] === types.indexOf(type) &&\n"
+      "          parsed.strings[nodes[edge + name_offset]] === name)\n"
+      "        return nodes[edge + to_offset];\n"
+      "    }\n"
+      "    return null;\n"
+      "  }\n"
+      "  var global = nodes[1 + children_offset + to_offset];\n"
+      "  var s = Child(Child(Child(global, 'b', 'shortcut'),\n"
+      "                      'x', 'property'),\n"
+      "                's', 'property');\n"
+      "  if (parsed.strings[nodes[s + 1]] !== 'streamed string') return null;\n"
+      "  return node_count;\n"
+      "}\n"
+      "var whole_count = Check(whole);\n"
+      "var windowed_count = Check(windowed);");
+  CHECK(CompileRun("whole_count !== null")->BooleanValue());
+  CHECK(CompileRun("windowed_count !== null")->BooleanValue());
+  CHECK(CompileRun("whole_count === windowed_count")->BooleanValue());
+}
+
+
+TEST(HeapSnapshotStreamingAborting) {
+  v8::HandleScope scope;
+  LocalContext env;
+  TestJSONStream stream(5);
+  CHECK(v8::HeapProfiler::StreamSnapshot(v8::String::New("abort"), &stream));
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(0, stream.eos_signaled());
+}
+
+
 // Must not crash in debug mode.
 TEST(AggregatedHeapSnapshotJSONSerialization) {
   v8::HandleScope scope;
@@ -1126,6 +1232,30 @@ TEST(TakeHeapSnapshotAborting) {
 }
 
 
+TEST(StreamHeapSnapshotAborting) {
+  v8::HandleScope scope;
+  LocalContext env;
+
+  // Abort at every progress report in turn, until the generation gets far
+  // enough to write to the stream. The stream must be ended then.
+  const int saved_window = i::FLAG_heap_snapshot_stream_window;
+  i::FLAG_heap_snapshot_stream_window = 16;
+  for (int abort_count = 1; ; ++abort_count) {
+    TestJSONStream stream;
+    TestActivityControl aborting_control(abort_count);
+    CHECK(!v8::HeapProfiler::StreamSnapshot(
+        v8::String::New("abort"), &stream, &aborting_control));
+    CHECK_GT(aborting_control.total(), aborting_control.done());
+    if (stream.size() > 0) {
+      CHECK_EQ(1, stream.eos_signaled());
+      break;
+    }
+    CHECK_EQ(0, stream.eos_signaled());
+  }
+  i::FLAG_heap_snapshot_stream_window = saved_window;
+}
+
+
 namespace {
 
 class TestRetainedObjectInfo : public v8::RetainedObjectInfo {
@@ -1320,4 +1450,57 @@ TEST(DeleteHeapSnapshot) {
   CHECK_EQ(NULL, v8::HeapProfiler::FindSnapshot(uid3));
 }
 
+
+static const v8::AllocationProfileNode* GetAllocationChild(
+    const v8::AllocationProfileNode* node, const char* name) {
+  for (int i = 0, count = node->GetChildrenCount(); i < count; ++i) {
+    const v8::AllocationProfileNode* child = node->GetChild(i);
+    v8::String::AsciiValue child_name(child->GetFunctionName());
+    if (strcmp(name, *child_name) == 0) return child;
+  }
+  return NULL;
+}
+
+
+TEST(AllocationSampling) {
+  v8::HandleScope scope;
+  LocalContext env;
+
+  CHECK_EQ(NULL, v8::HeapProfiler::StopAllocationSampling());
+  v8::HeapProfiler::StartAllocationSampling(1024);
+  v8::Script::Compile(v8::String::New(
+      "function allocate(n) {\n"
+      "  var result = [];\n"
+      "  for (var i = 0; i < n; i++) result.push(String(i) + '-' + i);\n"
+      "  return result;\n"
+      "}\n"
+      "function caller() { return allocate(5000); }\n"
+      "caller();\n"),
+      v8::String::New("allocation.js"))->Run();
+  const v8::AllocationProfile* profile =
+      v8::HeapProfiler::StopAllocationSampling();
+  CHECK_NE(NULL, profile);
+  CHECK_EQ(1024, profile->GetSampleInterval());
+  // Sampling is off once the profile has been taken.
+  CHECK_EQ(NULL, v8::HeapProfiler::StopAllocationSampling());
+
+  // The top level script is the only JS function on the outermost frame.
+  const v8::AllocationProfileNode* root = profile->GetRoot();
+  CHECK_EQ(1, root->GetChildrenCount());
+  const v8::AllocationProfileNode* script = root->GetChild(0);
+  const v8::AllocationProfileNode* caller =
+      GetAllocationChild(script, "caller");
+  CHECK_NE(NULL, caller);
+  const v8::AllocationProfileNode* allocate =
+      GetAllocationChild(caller, "allocate");
+  CHECK_NE(NULL, allocate);
+  CHECK_EQ(1, allocate->GetLineNumber());
+  v8::String::AsciiValue resource_name(allocate->GetScriptResourceName());
+  CHECK_EQ("allocation.js", *resource_name);
+  CHECK_GT(allocate->GetSelfSamplesCount(), 0);
+  CHECK_GE(allocate->GetSelfSize(),
+           static_cast<intptr_t>(allocate->GetSelfSamplesCount()) * 1024);
+  const_cast<v8::AllocationProfile*>(profile)->Delete();
+}
+
 #endif  // ENABLE_LOGGING_AND_PROFILING
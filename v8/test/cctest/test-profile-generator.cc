@@ -563,6 +563,42 @@ TEST(CodeMapMoveAndDeleteCode) {
 }
 
 
+TEST(CodeMapReorderAndSharedIds) {
+  CodeMap code_map;
+  CodeEntry entry1(i::Logger::FUNCTION_TAG, "", "aaa", "", 0,
+                   TokenEnumerator::kNoSecurityToken);
+  CodeEntry entry2(i::Logger::FUNCTION_TAG, "", "bbb", "", 0,
+                   TokenEnumerator::kNoSecurityToken);
+  CodeEntry entry3(i::Logger::FUNCTION_TAG, "", "ccc", "", 0,
+                   TokenEnumerator::kNoSecurityToken);
+  code_map.AddCode(ToAddress(0x1900), &entry3, 0x100);
+  code_map.AddCode(ToAddress(0x1500), &entry1, 0x100);
+  code_map.AddCode(ToAddress(0x1700), &entry2, 0x100);
+  CHECK_EQ(&entry1, code_map.FindEntry(ToAddress(0x1550)));
+  CHECK_EQ(&entry2, code_map.FindEntry(ToAddress(0x1750)));
+  CHECK_EQ(&entry3, code_map.FindEntry(ToAddress(0x1950)));
+  // Adding code at an existing address replaces the entry.
+  code_map.AddCode(ToAddress(0x1700), &entry3, 0x50);
+  CHECK_EQ(&entry3, code_map.FindEntry(ToAddress(0x1700)));
+  CHECK_EQ(NULL, code_map.FindEntry(ToAddress(0x1750)));
+  // Moving past other entries keeps the map sorted.
+  code_map.MoveCode(ToAddress(0x1500), ToAddress(0x2000));
+  CHECK_EQ(NULL, code_map.FindEntry(ToAddress(0x1500)));
+  CHECK_EQ(&entry3, code_map.FindEntry(ToAddress(0x1900)));
+  CHECK_EQ(&entry1, code_map.FindEntry(ToAddress(0x2000)));
+  // Moving onto an occupied address keeps the existing entry.
+  code_map.MoveCode(ToAddress(0x2000), ToAddress(0x1900));
+  CHECK_EQ(NULL, code_map.FindEntry(ToAddress(0x2000)));
+  CHECK_EQ(&entry3, code_map.FindEntry(ToAddress(0x1900)));
+  // Shared function ids are stable per address.
+  int id1 = code_map.GetSharedId(ToAddress(0x3000));
+  int id2 = code_map.GetSharedId(ToAddress(0x2800));
+  CHECK_NE(id1, id2);
+  CHECK_EQ(id1, code_map.GetSharedId(ToAddress(0x3000)));
+  CHECK_EQ(id2, code_map.GetSharedId(ToAddress(0x2800)));
+}
+
+
 namespace {
 
 class TestSetup {
@@ -642,7 +678,7 @@ TEST(RecordTickSample) {
 
 
 TEST(SampleRateCalculator) {
-  const double kSamplingIntervalMs = i::Logger::kSamplingIntervalMs;
+  const double kSamplingIntervalMs = i::Logger::SamplingIntervalMs();
 
   // Verify that ticking exactly in query intervals results in the
   // initial sampling interval.
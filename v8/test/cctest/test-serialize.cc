@@ -473,7 +473,9 @@ DEPENDENT_TEST(PartialDeserialization, PartialSerialization) {
 }
 
 
-TEST(ContextSerialization) {
+// Serializes a new context, after running |script| in it if it is not NULL,
+// as mksnapshot does for --extra-code.
+static void SerializeContext(const char* script) {
   Serializer::Enable();
   v8::V8::Initialize();
 
@@ -486,6 +488,10 @@ TEST(ContextSerialization) {
       Isolate::Current()->bootstrapper()->NativesSourceLookup(i);
     }
   }
+  if (script != NULL) {
+    v8::HandleScope scope;
+    v8::Script::Compile(v8::String::New(script))->Run();
+  }
   // If we don't do this then we end up with a stray root pointing at the
   // context even after we have disposed of env.
   HEAP->CollectAllGarbage(true);
@@ -519,39 +525,75 @@ TEST(ContextSerialization) {
 }
 
 
-DEPENDENT_TEST(ContextDeserialization, ContextSerialization) {
-  if (!Snapshot::IsEnabled()) {
-    int file_name_length = StrLength(FLAG_testing_serialization_file) + 10;
-    Vector<char> startup_name = Vector<char>::New(file_name_length + 1);
-    OS::SNPrintF(startup_name, "%s.startup", FLAG_testing_serialization_file);
+// Sets up the startup snapshot written by SerializeContext() and returns the
+// context snapshot, ready to be deserialized.
+static byte* ReadContextSnapshot(int* snapshot_size) {
+  int file_name_length = StrLength(FLAG_testing_serialization_file) + 10;
+  Vector<char> startup_name = Vector<char>::New(file_name_length + 1);
+  OS::SNPrintF(startup_name, "%s.startup", FLAG_testing_serialization_file);
 
-    CHECK(Snapshot::Initialize(startup_name.start()));
-    startup_name.Dispose();
+  CHECK(Snapshot::Initialize(startup_name.start()));
+  startup_name.Dispose();
+
+  const char* file_name = FLAG_testing_serialization_file;
+  ReserveSpaceForPartialSnapshot(file_name);
+
+  return ReadBytes(file_name, snapshot_size);
+}
+
+
+static Object* DeserializeContext(byte* snapshot, int snapshot_size) {
+  Object* root;
+  SnapshotByteSource source(snapshot, snapshot_size);
+  Deserializer deserializer(&source);
+  deserializer.DeserializePartial(&root);
+  CHECK(root->IsContext());
+  return root;
+}
+
+
+TEST(ContextSerialization) {
+  SerializeContext(NULL);
+}
 
-    const char* file_name = FLAG_testing_serialization_file;
-    ReserveSpaceForPartialSnapshot(file_name);
 
+DEPENDENT_TEST(ContextDeserialization, ContextSerialization) {
+  if (!Snapshot::IsEnabled()) {
     int snapshot_size = 0;
-    byte* snapshot = ReadBytes(file_name, &snapshot_size);
+    byte* snapshot = ReadContextSnapshot(&snapshot_size);
 
-    Object* root;
-    {
-      SnapshotByteSource source(snapshot, snapshot_size);
-      Deserializer deserializer(&source);
-      deserializer.DeserializePartial(&root);
-      CHECK(root->IsContext());
-    }
+    Object* root = DeserializeContext(snapshot, snapshot_size);
     v8::HandleScope handle_scope;
     Handle<Object>root_handle(root);
 
-    Object* root2;
-    {
-      SnapshotByteSource source(snapshot, snapshot_size);
-      Deserializer deserializer(&source);
-      deserializer.DeserializePartial(&root2);
-      CHECK(root2->IsContext());
-      CHECK(*root_handle != root2);
-    }
+    Object* root2 = DeserializeContext(snapshot, snapshot_size);
+    CHECK(*root_handle != root2);
+  }
+}
+
+
+TEST(ContextSerializationWithScript) {
+  SerializeContext("function Answer() { return 42; }"
+                   "var answer = Answer();"
+                   "var names = [];"
+                   "for (var i = 0; i < 10; i++) names.push('name' + i);");
+}
+
+
+DEPENDENT_TEST(ContextDeserializationWithScript,
+               ContextSerializationWithScript) {
+  if (!Snapshot::IsEnabled()) {
+    int snapshot_size = 0;
+    byte* snapshot = ReadContextSnapshot(&snapshot_size);
+
+    Object* root = DeserializeContext(snapshot, snapshot_size);
+    v8::HandleScope handle_scope;
+    Handle<JSObject> global(Context::cast(root)->global());
+    CHECK(GetProperty(global, "Answer")->IsJSFunction());
+    CHECK_EQ(42, Smi::cast(*GetProperty(global, "answer"))->value());
+    Handle<Object> names = GetProperty(global, "names");
+    CHECK(names->IsJSArray());
+    CHECK_EQ(10, Smi::cast(JSArray::cast(*names)->length())->value());
   }
 }
 
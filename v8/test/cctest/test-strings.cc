@@ -481,3 +481,47 @@ TEST(CachedHashOverflow) {
     }
   }
 }
+
+
+TEST(SliceFromCons) {
+  FLAG_string_slices = true;
+  InitializeVM();
+  v8::HandleScope scope;
+  Handle<String> string =
+      FACTORY->NewStringFromAscii(CStrVector("parentparentparent"));
+  Handle<String> parent = FACTORY->NewConsString(string, string);
+  CHECK(parent->IsConsString());
+  CHECK(!parent->IsFlat());
+  Handle<String> slice = FACTORY->NewSubString(parent, 1, 25);
+  // After slicing, the original string becomes a flat cons.
+  CHECK(parent->IsFlat());
+  CHECK(slice->IsSlicedString());
+  CHECK_EQ(SlicedString::cast(*slice)->parent(),
+           ConsString::cast(*parent)->first());
+  CHECK(SlicedString::cast(*slice)->parent()->IsSeqString());
+  CHECK(slice->IsFlat());
+  CHECK_EQ(0, strncmp("arentparentparentparentp",
+                      *slice->ToCString(), slice->length()));
+}
+
+
+TEST(SliceOfSliceAndShortSubstrings) {
+  FLAG_string_slices = true;
+  InitializeVM();
+  v8::HandleScope scope;
+  Handle<String> parent = FACTORY->NewStringFromAscii(
+      CStrVector("0123456789abcdefghijklmnopqrstuvwxyz"));
+  Handle<String> slice = FACTORY->NewSubString(parent, 2, 30);
+  CHECK(slice->IsSlicedString());
+  CHECK_EQ(2, SlicedString::cast(*slice)->offset());
+  // A slice of a slice points at the original parent.
+  Handle<String> slice_of_slice = FACTORY->NewSubString(slice, 3, 20);
+  CHECK(slice_of_slice->IsSlicedString());
+  CHECK_EQ(*parent, SlicedString::cast(*slice_of_slice)->parent());
+  CHECK_EQ(5, SlicedString::cast(*slice_of_slice)->offset());
+  CHECK_EQ('5', slice_of_slice->Get(0));
+  // Short substrings are still copied.
+  Handle<String> short_string =
+      FACTORY->NewSubString(parent, 0, SlicedString::kMinLength - 1);
+  CHECK(short_string->IsSeqString());
+}
@@ -0,0 +1,159 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Tests of the megamorphic stub cache: its table sizes and the hit and
+// miss counters the generated probes update.
+
+#include <stdlib.h>
+
+#include "v8.h"
+
+#include "cctest.h"
+#include "stub-cache.h"
+
+using namespace v8::internal;
+
+
+static void CheckTableSizes(int requested_primary_size,
+                            int requested_secondary_size,
+                            int expected_primary_size,
+                            int expected_secondary_size) {
+  FLAG_stub_cache_primary_size = requested_primary_size;
+  FLAG_stub_cache_secondary_size = requested_secondary_size;
+  v8::Isolate* isolate = v8::Isolate::New();
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::V8::Initialize();
+    StubCache* stub_cache = Isolate::Current()->stub_cache();
+    CHECK_EQ(expected_primary_size, stub_cache->primary_table_size());
+    CHECK_EQ(expected_secondary_size, stub_cache->secondary_table_size());
+  }
+  isolate->Dispose();
+}
+
+
+TEST(StubCacheTableSizes) {
+  // Powers of two are taken as they are.
+  CheckTableSizes(2048, 512, 2048, 512);
+  CheckTableSizes(1, 1, 1, 1);
+  // Other sizes are rounded up to a power of two.
+  CheckTableSizes(1000, 3, 1024, 4);
+  // Sizes are capped so that hashed offsets stay positive ints, and
+  // sizes below one leave a single entry.
+  CheckTableSizes(1 << 30, 0, 1 << 20, 1);
+  CheckTableSizes(kMaxInt, -5, 1 << 20, 1);
+}
+
+
+static const int kMaxCounters = 256;
+static const char* counter_names[kMaxCounters];
+static int counter_values[kMaxCounters];
+
+
+static int* LookupCounter(const char* name) {
+  for (int i = 0; i < kMaxCounters; i++) {
+    if (counter_names[i] == NULL) {
+      counter_names[i] = name;
+      return &counter_values[i];
+    }
+    if (strcmp(counter_names[i], name) == 0) return &counter_values[i];
+  }
+  return NULL;
+}
+
+
+static int CallHits() {
+  Counters* counters = Isolate::Current()->counters();
+  return *counters->call_stub_cache_primary_hits()->GetInternalPointer() +
+      *counters->call_stub_cache_secondary_hits()->GetInternalPointer();
+}
+
+
+static int CallMisses() {
+  Counters* counters = Isolate::Current()->counters();
+  return *counters->call_stub_cache_misses()->GetInternalPointer();
+}
+
+
+// Calls |receiver|.f at a call site that is already megamorphic, and checks
+// how the calls are counted.
+static void CheckCallCounts(const char* receiver,
+                            int expected_hits,
+                            int expected_misses) {
+  int hits = CallHits();
+  int misses = CallMisses();
+  i::ScopedVector<char> source(256);
+  i::OS::SNPrintF(source, "call(%s);", receiver);
+  CompileRun(source.start());
+  CHECK_EQ(expected_hits, CallHits() - hits);
+  CHECK_EQ(expected_misses, CallMisses() - misses);
+}
+
+
+TEST(StubCacheCallCounters) {
+  FLAG_native_code_counters = true;
+  // Optimized code would not go through the call site's IC.
+  FLAG_crankshaft = false;
+  // A primary probe that matches the name commits to the stub it finds, so
+  // a stub cached for another map in the same entry would turn the hits
+  // below into misses. Maps are close together, and with a table this
+  // large they do not share entries.
+  FLAG_stub_cache_primary_size = 1 << 16;
+  Isolate::Current()->stats_table()->SetCounterFunction(LookupCounter);
+  v8::HandleScope scope;
+  LocalContext env;
+  // The unusual argument count keeps the megamorphic call stub from being
+  // one that was compiled without counters, e.g. for the snapshot. The
+  // functions are called once elsewhere first, because calls to functions
+  // that are not compiled yet are not cached.
+  CompileRun(
+      "function call(o) { return o.valueOf(1, 2, 3, 4, 5, 6, 7); }"
+      "function F() {}"
+      "F.prototype.valueOf = function() { return 1; };"
+      "for (var i = 0; i < 10; i++) {"
+      "  var o = new F();"
+      "  o['p' + i] = i;"
+      "  call(o);"
+      "}"
+      "var object = { valueOf: function() { return 2; } };"
+      "object.valueOf();"
+      "'a string'.valueOf();"
+      "(0.5).valueOf();");
+
+  // The first call with a receiver map the cache has no stub for misses
+  // once and puts the stub into the cache. Later calls hit once each.
+  CheckCallCounts("object", 0, 1);
+  CheckCallCounts("object", 1, 0);
+
+  // Strings and numbers are probed again with the map of their prototype,
+  // which is where their stubs are cached. That is still one call.
+  CheckCallCounts("'a string'", 0, 1);
+  CheckCallCounts("'another string'", 1, 0);
+  CheckCallCounts("42.5", 0, 1);
+  CheckCallCounts("0.5", 1, 0);
+  CheckCallCounts("7", 1, 0);
+}
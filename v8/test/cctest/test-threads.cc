@@ -189,3 +189,161 @@ TEST(ThreadIdValidation) {
     delete threads[i];
   }
 }
+
+
+// Each thread locks its own isolate and does not release the lock until all
+// threads have locked theirs, so this deadlocks if lockers on different
+// isolates exclude each other.
+class IsolateLockerThread : public v8::internal::Thread {
+ public:
+  IsolateLockerThread(i::Semaphore* ready, i::Semaphore* go, int n)
+    : Thread(NULL, "IsolateLockerThread"),
+      ready_(ready), go_(go), n_(n), result_(0) {
+  }
+
+  void Run() {
+    v8::Isolate* isolate = v8::Isolate::New();
+    {
+      v8::Locker locker(isolate);
+      CHECK(v8::Locker::IsLocked(isolate));
+      ready_->Signal();
+      go_->Wait();
+      v8::HandleScope scope;
+      v8::Persistent<v8::Context> context = v8::Context::New();
+      {
+        v8::Context::Scope context_scope(context);
+        i::EmbeddedVector<char, 128> source;
+        i::OS::SNPrintF(source,
+            "function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }"
+            "fib(%d)", n_);
+        v8::Handle<v8::Script> script =
+            v8::Script::Compile(v8::String::New(source.start()));
+        result_ = script->Run()->Int32Value();
+      }
+      context.Dispose();
+    }
+    CHECK(!v8::Locker::IsLocked(isolate));
+    isolate->Dispose();
+  }
+
+  int result() { return result_; }
+
+ private:
+  i::Semaphore* ready_;
+  i::Semaphore* go_;
+  int n_;
+  int result_;
+};
+
+
+TEST(IsolateLockersInParallel) {
+  const int kNThreads = 4;
+  v8::Locker locker;
+  v8::V8::Initialize();
+  i::Semaphore* ready = i::OS::CreateSemaphore(0);
+  i::Semaphore* go = i::OS::CreateSemaphore(0);
+  i::List<IsolateLockerThread*> threads(kNThreads);
+  for (int i = 0; i < kNThreads; i++) {
+    IsolateLockerThread* thread = new IsolateLockerThread(ready, go, 10 + i);
+    threads.Add(thread);
+    thread->Start();
+  }
+  for (int i = 0; i < kNThreads; i++) ready->Wait();
+  for (int i = 0; i < kNThreads; i++) go->Signal();
+  static const int kFib[] = { 55, 89, 144, 233 };
+  for (int i = 0; i < kNThreads; i++) {
+    threads[i]->Join();
+    CHECK_EQ(kFib[i], threads[i]->result());
+    delete threads[i];
+  }
+  CHECK(v8::Locker::IsLocked());
+  delete ready;
+  delete go;
+}
+
+
+// Threads taking turns on one isolate. Each Locker enters the isolate, whose
+// entry stack all the threads share, so every thread has to leave it again
+// before another one gets the lock. Each thread runs in an isolate of its
+// own in between, which it gets back only if it popped its own entry.
+class SharedIsolateLockerThread : public v8::internal::Thread {
+ public:
+  SharedIsolateLockerThread(v8::Isolate* isolate, int iterations)
+    : Thread(NULL, "SharedIsolateLockerThread"),
+      isolate_(isolate), iterations_(iterations), result_(0) {
+  }
+
+  void Run() {
+    v8::Isolate* own_isolate = v8::Isolate::New();
+    {
+      v8::Isolate::Scope own_isolate_scope(own_isolate);
+      for (int i = 0; i < iterations_; i++) {
+        RunLocked();
+        CHECK_EQ(own_isolate, v8::Isolate::GetCurrent());
+      }
+    }
+    own_isolate->Dispose();
+  }
+
+  void RunLocked() {
+    v8::Locker locker(isolate_);
+    CHECK_EQ(isolate_, v8::Isolate::GetCurrent());
+    v8::HandleScope scope;
+    v8::Persistent<v8::Context> context = v8::Context::New();
+    {
+      v8::Context::Scope context_scope(context);
+      v8::Handle<v8::Script> script =
+          v8::Script::Compile(v8::String::New("var x = 20; x + 1"));
+      result_ = script->Run()->Int32Value();
+      {
+        v8::Unlocker unlocker(isolate_);
+        i::OS::Sleep(1);
+      }
+      CHECK_EQ(isolate_, v8::Isolate::GetCurrent());
+      {
+        // A nested Locker neither takes the lock nor enters the isolate, so
+        // the Unlocker leaves only the entry of the outer one.
+        v8::Locker nested_locker(isolate_);
+        {
+          v8::Unlocker unlocker(isolate_);
+          i::OS::Sleep(1);
+          {
+            v8::Locker relocker(isolate_);
+            CHECK_EQ(isolate_, v8::Isolate::GetCurrent());
+          }
+        }
+        CHECK_EQ(isolate_, v8::Isolate::GetCurrent());
+      }
+      CHECK_EQ(isolate_, v8::Isolate::GetCurrent());
+      result_ += script->Run()->Int32Value();
+    }
+    context.Dispose();
+  }
+
+  int result() { return result_; }
+
+ private:
+  v8::Isolate* isolate_;
+  int iterations_;
+  int result_;
+};
+
+
+TEST(IsolateSharedByLockers) {
+  const int kNThreads = 4;
+  v8::Isolate* isolate = v8::Isolate::New();
+  i::List<SharedIsolateLockerThread*> threads(kNThreads);
+  for (int i = 0; i < kNThreads; i++) {
+    SharedIsolateLockerThread* thread =
+        new SharedIsolateLockerThread(isolate, 100);
+    threads.Add(thread);
+    thread->Start();
+  }
+  for (int i = 0; i < kNThreads; i++) {
+    threads[i]->Join();
+    CHECK_EQ(42, threads[i]->result());
+    delete threads[i];
+  }
+  CHECK(!reinterpret_cast<i::Isolate*>(isolate)->IsInUse());
+  isolate->Dispose();
+}
@@ -0,0 +1,106 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Tests of the pool that recycles zone segments between uses of the zone.
+
+#include <stdlib.h>
+
+#include "v8.h"
+
+#include "cctest.h"
+#include "zone-inl.h"
+
+using namespace v8::internal;
+
+
+// Initializes V8 and empties the segment pool of its zone.
+static Zone* InitializeEmptyPool() {
+  FLAG_zone_segment_pool = true;
+  v8::V8::Initialize();
+  Zone* zone = Isolate::Current()->zone();
+  zone->TrimSegmentPool();
+  zone->TrimSegmentPool();
+  CHECK_EQ(0, zone->pooled_segment_bytes());
+  return zone;
+}
+
+
+// Allocates 'bytes' in the zone, in chunks like those of an AST, and
+// returns the number of segment bytes the zone then holds.
+static int UseZone(int bytes) {
+  ZoneScope zone_scope(DELETE_ON_EXIT);
+  Zone* zone = Isolate::Current()->zone();
+  for (int allocated = 0; allocated < bytes; allocated += 64) {
+    zone->New(64);
+  }
+  return zone->segment_bytes_allocated();
+}
+
+
+TEST(ZoneSegmentPoolReuse) {
+  Zone* zone = InitializeEmptyPool();
+
+  int bytes_in_use = UseZone(200 * KB);
+  CHECK_EQ(0, zone->segment_bytes_allocated());
+  CHECK_EQ(bytes_in_use, zone->pooled_segment_bytes());
+
+  // The same use of the zone again takes all its segments from the pool.
+  int segments_allocated = zone->segments_allocated();
+  int segments_reused = zone->segments_reused();
+  CHECK_EQ(bytes_in_use, UseZone(200 * KB));
+  CHECK_EQ(segments_allocated, zone->segments_allocated());
+  CHECK_GT(zone->segments_reused(), segments_reused);
+  CHECK_EQ(bytes_in_use, zone->pooled_segment_bytes());
+}
+
+
+TEST(ZoneSegmentPoolTrimming) {
+  Zone* zone = InitializeEmptyPool();
+
+  int large_bytes_in_use = UseZone(4 * MB);
+  CHECK_EQ(large_bytes_in_use, zone->pooled_segment_bytes());
+
+  // A smaller use of the zone afterwards leaves only as much as it needed
+  // in the pool, without waiting for the embedder to be idle.
+  int small_bytes_in_use = UseZone(16 * KB);
+  CHECK_LT(small_bytes_in_use, large_bytes_in_use);
+  CHECK_LE(zone->pooled_segment_bytes(), small_bytes_in_use);
+  CHECK_GT(zone->pooled_segment_bytes(), 0);
+
+  // Being idle keeps what was needed since the last trim; being idle again
+  // without using the zone in between gives everything back.
+  zone->TrimSegmentPool();
+  CHECK_GT(zone->pooled_segment_bytes(), 0);
+  zone->TrimSegmentPool();
+  CHECK_EQ(0, zone->pooled_segment_bytes());
+
+  // Without the pool, a single small segment is kept as before.
+  FLAG_zone_segment_pool = false;
+  UseZone(16 * KB);
+  CHECK_EQ(0, zone->pooled_segment_bytes());
+  FLAG_zone_segment_pool = true;
+}
@@ -0,0 +1,126 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Test the native default-order fast paths of Array.prototype.sort against
+// an explicit string comparison.
+
+function StringOrder(x, y) {
+  x = String(x);
+  y = String(y);
+  if (x == y) return 0;
+  return x < y ? -1 : 1;
+}
+
+function CheckDefaultSort(a) {
+  var expected = a.slice().sort(StringOrder);
+  var actual = a.slice();
+  assertSame(actual, actual.sort());
+  assertEquals(expected.length, actual.length);
+  for (var i = 0; i < expected.length; i++) {
+    assertEquals(String(expected[i]), String(actual[i]), "index " + i);
+  }
+}
+
+function Random(seed) {
+  return function(n) {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return seed % n;
+  };
+}
+
+var random = Random(17);
+
+// Smis only.
+var smis = [];
+for (var i = 0; i < 500; i++) smis.push(random(2000) - 1000);
+CheckDefaultSort(smis);
+CheckDefaultSort([0, -1, 1, -10, 10, 100, -100, 9, 90, 1073741823,
+                  -1073741824, 1073741822, 99999999, 999999999]);
+// On 64-bit platforms the smi range is the whole int32 range, whose
+// minimum has no positive counterpart.
+CheckDefaultSort([-2147483648, -1, 5, -10, 2147483647, -214748364,
+                  -2147483647, 2147483640]);
+
+// Heap numbers mixed with smis.
+var numbers = [];
+for (var i = 0; i < 500; i++) {
+  numbers.push((random(2000) - 1000) / (random(3) + 1));
+}
+numbers.push(-0, 1e21, 1e-7, Infinity, -Infinity, NaN, 4294967296);
+CheckDefaultSort(numbers);
+
+// Strings, including two-byte and cons strings, mixed with numbers.
+var strings = [];
+for (var i = 0; i < 300; i++) {
+  var s = "s" + random(1000);
+  if (i % 3 == 0) s += "ሴ" + random(10);
+  if (i % 5 == 0) s = s + s;
+  strings.push(s);
+  if (i % 7 == 0) strings.push(random(100));
+}
+strings.push("", "ÿ", "Ā", "a\u0000");
+CheckDefaultSort(strings);
+
+// Copy-on-write literal arrays.
+function Literal() { return [3, 20, 100, 1]; }
+var literal = Literal();
+literal.sort();
+assertArrayEquals([1, 100, 20, 3], literal);
+assertArrayEquals([3, 20, 100, 1], Literal());
+
+// Arrays the native path does not handle fall back to array.js.
+var with_hole = [3, , 1, 2];
+with_hole.sort();
+assertArrayEquals([1, 2, 3], with_hole.slice(0, 3));
+assertEquals(4, with_hole.length);
+assertFalse(3 in with_hole);
+
+var with_undefined = [3, undefined, 1];
+with_undefined.sort();
+assertArrayEquals([1, 3, undefined], with_undefined);
+
+var with_objects = [{ toString: function() { return "b"; } }, "a", "c"];
+with_objects.sort();
+assertEquals("a", with_objects[0]);
+assertEquals("b", String(with_objects[1]));
+assertEquals("c", with_objects[2]);
+
+var array_like = { 0: 2, 1: 10, 2: 1, length: 3 };
+Array.prototype.sort.call(array_like);
+assertEquals(1, array_like[0]);
+assertEquals(10, array_like[1]);
+assertEquals(2, array_like[2]);
+
+// A comparison function still goes through array.js.
+var calls = 0;
+var a = [5, 3, 9, 1];
+a.sort(function(x, y) { calls++; return x - y; });
+assertArrayEquals([1, 3, 5, 9], a);
+assertTrue(calls > 0);
+
+assertEquals(1, Array.prototype.sort.length);
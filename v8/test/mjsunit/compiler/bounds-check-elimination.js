@@ -0,0 +1,141 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Test that bounds checks proven redundant by dominating comparisons and
+// loop induction variables are removed without changing results, and
+// that accesses that may be out of bounds keep their checks.
+
+function Sum(a) {
+  var sum = 0;
+  for (var i = 0; i < a.length; i++) sum += a[i];
+  return sum;
+}
+
+function ReverseSum(a) {
+  var sum = 0;
+  for (var i = a.length - 1; i >= 0; i--) sum += a[i];
+  return sum;
+}
+
+function Differences(a) {
+  var sum = 0;
+  for (var i = 1; i < a.length; i++) sum += a[i] - a[i - 1];
+  return sum;
+}
+
+function Guarded(a) {
+  if (a.length > 3) return a[0] + a[3];
+  return -1;
+}
+
+var a = [1, 2, 3, 4, 5];
+var short = [1, 2, 3];
+
+function Test() {
+  assertEquals(15, Sum(a));
+  assertEquals(15, ReverseSum(a));
+  assertEquals(4, Differences(a));
+  assertEquals(5, Guarded(a));
+  assertEquals(-1, Guarded(short));
+}
+
+for (var i = 0; i < 5; i++) Test();
+%OptimizeFunctionOnNextCall(Sum);
+%OptimizeFunctionOnNextCall(ReverseSum);
+%OptimizeFunctionOnNextCall(Differences);
+%OptimizeFunctionOnNextCall(Guarded);
+Test();
+for (var i = 0; i < 5; i++) Test();
+
+// These are optimized while all accesses are in bounds and then access
+// elements outside of the array, so they must keep their checks.
+function SumTo(a, n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) sum += a[i];
+  return sum;
+}
+
+function SumFrom(a, start) {
+  var sum = 0;
+  for (var i = start; i < a.length; i++) sum += a[i];
+  return sum;
+}
+
+function ReverseSumFrom(a, start) {
+  var sum = 0;
+  for (var i = start; i >= 0; i--) sum += a[i];
+  return sum;
+}
+
+function SumWithOffset(a, offset) {
+  var sum = 0;
+  for (var i = 0; i < a.length; i++) sum += a[i + offset];
+  return sum;
+}
+
+function SumOther(a, b) {
+  var sum = 0;
+  for (var i = 0; i < a.length; i++) sum += b[i];
+  return sum;
+}
+
+function TestInBounds() {
+  assertEquals(15, SumTo(a, 5));
+  assertEquals(15, SumFrom(a, 0));
+  assertEquals(15, ReverseSumFrom(a, 4));
+  assertEquals(15, SumWithOffset(a, 0));
+  assertEquals(15, SumOther(a, a));
+}
+
+for (var i = 0; i < 5; i++) TestInBounds();
+%OptimizeFunctionOnNextCall(SumTo);
+%OptimizeFunctionOnNextCall(SumFrom);
+%OptimizeFunctionOnNextCall(ReverseSumFrom);
+%OptimizeFunctionOnNextCall(SumWithOffset);
+%OptimizeFunctionOnNextCall(SumOther);
+TestInBounds();
+assertTrue(isNaN(SumTo(a, 6)));
+assertTrue(isNaN(SumFrom(a, -1)));
+assertTrue(isNaN(ReverseSumFrom(a, 5)));
+assertTrue(isNaN(SumWithOffset(a, 1)));
+assertTrue(isNaN(SumOther(a, short)));
+
+// Arrays that shrink inside the loop.
+function SumShrinking(a) {
+  var sum = 0;
+  for (var i = 0; i < a.length; i++) {
+    sum += a[i];
+    a.length = a.length - 1;
+  }
+  return sum;
+}
+
+for (var i = 0; i < 5; i++) assertEquals(6, SumShrinking([1, 2, 3, 4, 5]));
+%OptimizeFunctionOnNextCall(SumShrinking);
+assertEquals(6, SumShrinking([1, 2, 3, 4, 5]));
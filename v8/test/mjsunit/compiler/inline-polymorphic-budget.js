@@ -0,0 +1,72 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --max-call-polymorphism=2 --max-inlined-nodes-cumulative=40
+
+// Test polymorphic calls with more receiver maps than are dispatched on
+// inline, and calls that exceed the cumulative inlining budget.
+
+function A(x) { this.x = x; }
+A.prototype.get = function() { return this.x; };
+
+function B(x) { this.y = x; }
+B.prototype.get = function() { return this.y + 1; };
+
+function C(x) { this.z = x; }
+C.prototype.get = function() { return this.z + 2; };
+
+function D(x) { this.w = x; }
+D.prototype.get = function() { return this.w * 2; };
+
+function Get(o) { return o.get(); }
+
+var objects = [new A(1), new B(1), new C(1)];
+
+function Test() {
+  assertEquals(1, Get(objects[0]));
+  assertEquals(2, Get(objects[1]));
+  assertEquals(3, Get(objects[2]));
+}
+
+for (var i = 0; i < 5; i++) Test();
+%OptimizeFunctionOnNextCall(Get);
+Test();
+assertEquals(4, Get(new D(2)));
+Test();
+
+function Small(x) { return x + 1; }
+function Medium(x) { var y = x * 2; return y + Small(y); }
+
+function Many(x) {
+  return Medium(x) + Medium(x + 1) + Medium(x + 2) + Medium(x + 3) +
+      Small(x) + Small(x + 1) + Small(x + 2) + Small(x + 3);
+}
+
+for (var i = 0; i < 5; i++) assertEquals(58, Many(1));
+%OptimizeFunctionOnNextCall(Many);
+assertEquals(58, Many(1));
+assertEquals(78, Many(2));
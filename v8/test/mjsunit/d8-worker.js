@@ -0,0 +1,85 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Test the worker pool of the d8 shell.  Each worker runs in its own
+// isolate on its own thread; messages are passed as strings.
+
+if (this.Worker) {
+  var source =
+      "function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }" +
+      "function onmessage(message) {" +
+      "  var job = JSON.parse(message);" +
+      "  postMessage(JSON.stringify({ id: job.id, value: fib(job.n) }));" +
+      "}";
+
+  // Workers do not share any state with the shell or with each other.
+  var kWorkers = 4;
+  var workers = [];
+  for (var i = 0; i < kWorkers; i++) workers.push(new Worker(source));
+
+  for (var i = 0; i < kWorkers; i++) {
+    workers[i].postMessage(JSON.stringify({ id: i, n: 10 + i }));
+    workers[i].postMessage(JSON.stringify({ id: i, n: 20 }));
+  }
+  for (var i = 0; i < kWorkers; i++) {
+    var first = JSON.parse(workers[i].getMessage());
+    assertEquals(i, first.id);
+    assertEquals([55, 89, 144, 233][i], first.value);
+    var second = JSON.parse(workers[i].getMessage());
+    assertEquals(6765, second.value);
+  }
+
+  // Once terminated a worker finishes the messages it has been posted and
+  // then getMessage returns undefined.
+  workers[0].postMessage(JSON.stringify({ id: 0, n: 1 }));
+  workers[0].terminate();
+  assertEquals(1, JSON.parse(workers[0].getMessage()).value);
+  assertEquals(undefined, workers[0].getMessage());
+  assertEquals(undefined, workers[0].getMessage());
+  // Messages posted to a terminated worker are dropped.
+  workers[0].postMessage("dropped");
+  assertEquals(undefined, workers[0].getMessage());
+
+  // Messages are converted to strings, including unicode characters.
+  var echo = new Worker("function onmessage(m) { postMessage(m + m); }");
+  echo.postMessage(12);
+  assertEquals("1212", echo.getMessage());
+  echo.postMessage("æ☺");
+  assertEquals("æ☺æ☺", echo.getMessage());
+
+  // Workers do not see the globals of the shell.
+  var probe = new Worker(
+      "postMessage(typeof Worker); postMessage(typeof workers);");
+  assertEquals("undefined", probe.getMessage());
+  assertEquals("undefined", probe.getMessage());
+  assertEquals(undefined, probe.getMessage());
+
+  assertThrows("Worker('')");
+  assertThrows("Worker.prototype.postMessage.call({}, '')");
+  assertThrows("Worker.prototype.getMessage.call({})");
+}
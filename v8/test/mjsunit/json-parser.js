@@ -0,0 +1,125 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Test JSON.parse on sequential one- and two-byte and on cons sources.
+
+function Check(expected, text) {
+  assertEquals(expected, JSON.parse(text));
+  // A cons string source.
+  var half = text.length >> 1;
+  assertEquals(expected, JSON.parse(text.substring(0, half) +
+                                    text.substring(half)));
+  // A two-byte source.
+  assertEquals(expected, JSON.parse("\u1234".substring(1) + text));
+  assertEquals(expected, JSON.parse(text + " ".substring(1)));
+}
+
+Check(1, "1");
+Check(-0, "-0");
+Check(123456789, "123456789");
+Check(1234567890, "1234567890");
+Check(-1.5e-7, "-1.5e-7");
+Check(1e300, "1E+300");
+Check("", '""');
+Check("a", '"a"');
+Check("\u1234", '"\u1234"');
+Check("\u1234", '"\\u1234"');
+Check("a\"b\\c/d\be\ff\ng\rh\ti", '"a\\"b\\\\c\\/d\\be\\ff\\ng\\rh\\ti"');
+Check("\u00e9\u20ac", '"\\u00E9\\u20ac"');
+Check([], "[]");
+Check([1, [2, [3]], {}], " [ 1 , [2,[ 3 ]] , { } ] ");
+Check({ a: 1, b: [true, false, null] },
+      '{"a":1,"b":[true,false,null]}');
+Check({ "\u1234key": "v", "k\u1234": 2 },
+      '{"\\u1234key":"v","k\u1234":2}');
+Check({ "": 1 }, '{"":1}');
+Check({ "0": "a", "1": "b", x: "c" }, '{"0":"a","1":"b","x":"c"}');
+Check({ "not-an-identifier": 1 }, '{"not-an-identifier":1}');
+
+// Objects of the same shape, names colliding in the name cache, and a
+// first property that is also used in other positions.
+var records = [];
+for (var i = 0; i < 200; i++) {
+  var record = {};
+  record["k" + (i % 70)] = i;
+  record.a = i;
+  record["a" + (i % 3)] = String(i);
+  records.push(record);
+}
+Check(records, JSON.stringify(records));
+var parsed = JSON.parse(JSON.stringify(records));
+parsed[0].extra = 1;
+assertEquals(undefined, parsed[70].extra);
+delete parsed[1].a;
+assertEquals(71, parsed[71].a);
+assertEquals(["k1", "a1"], Object.keys(parsed[1]));
+
+// Duplicate names keep the last value.
+assertEquals({ a: 2 }, JSON.parse('{"a":1,"a":2}'));
+var duplicate = JSON.parse('[{"a":1,"a":2},{"a":3}]');
+assertEquals(2, duplicate[0].a);
+assertEquals(3, duplicate[1].a);
+
+// __proto__ sets the prototype.
+var with_proto = JSON.parse('{"__proto__":{"p":1},"q":2}');
+assertEquals(1, with_proto.p);
+assertFalse(with_proto.hasOwnProperty("p"));
+
+function CheckSyntaxError(text) {
+  assertThrows(function() { JSON.parse(text); }, SyntaxError);
+  assertThrows(function() { JSON.parse("\u1234".substring(1) + text); },
+               SyntaxError);
+}
+
+CheckSyntaxError("");
+CheckSyntaxError(" ");
+CheckSyntaxError("{");
+CheckSyntaxError("[1,]");
+CheckSyntaxError("[,1]");
+CheckSyntaxError('{"a":1,}');
+CheckSyntaxError('{"a" 1}');
+CheckSyntaxError("{a:1}");
+CheckSyntaxError("{'a':1}");
+CheckSyntaxError("01");
+CheckSyntaxError("-");
+CheckSyntaxError("1.");
+CheckSyntaxError(".5");
+CheckSyntaxError("1e");
+CheckSyntaxError("+1");
+CheckSyntaxError("0x10");
+CheckSyntaxError("tru");
+CheckSyntaxError("truex");
+CheckSyntaxError("nul");
+CheckSyntaxError('"abc');
+CheckSyntaxError('"a\tb"');
+CheckSyntaxError('"\\x41"');
+CheckSyntaxError('"\\u12"');
+CheckSyntaxError('{"\\u12":1}');
+CheckSyntaxError('{"a');
+CheckSyntaxError("[1] 2");
+CheckSyntaxError("\u00a01");
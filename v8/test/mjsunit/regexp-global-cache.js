@@ -0,0 +1,119 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Flags: --expose-gc
+
+// Test that repeated global regexp operations on the same subject, which are
+// answered from the regexp results cache, behave like the first one.
+
+var subject = "The quick brown fox jumps over the lazy dog. ";
+for (var i = 0; i < 4; i++) subject += subject;
+
+function checkReplace(re, replacement, expected_last_match) {
+  var first = subject.replace(re, replacement);
+  for (var i = 0; i < 3; i++) {
+    assertEquals(first, subject.replace(re, replacement));
+    assertEquals(expected_last_match, RegExp.lastMatch);
+    assertEquals(0, re.lastIndex);
+  }
+  return first;
+}
+
+// Atom regexps.
+assertEquals(subject.split("fox").join("cat"),
+             checkReplace(/fox/g, "cat", "fox"));
+assertEquals(subject.split("o").join(""), checkReplace(/o/g, "", "o"));
+
+// Irregexp with captures and $ patterns.
+var swapped = checkReplace(/(\w+) (\w+)/g, "$2 $1", "the lazy");
+assertEquals("quick The fox brown over jumps lazy the dog. ",
+             swapped.substring(0, 45));
+assertEquals("[T]he [q]uick ",
+             checkReplace(/\b(\w)/g, "[$1]", "d").substring(0, 14));
+assertEquals("<The> ", checkReplace(/\w+/g, "<$&>", "dog").substring(0, 6));
+assertEquals("$$ ", checkReplace(/\w+/g, "$$$$", "dog").substring(0, 3));
+assertEquals("x.", "ab.".replace(/\w+/g, "x"));
+var affixes = "a-b".replace(/-/g, "[$`|$']");
+assertEquals("a[a|b]b", affixes);
+assertEquals("a[a|b]b", "a-b".replace(/-/g, "[$`|$']"));
+
+// Empty matches.
+assertEquals("-a-b-c-", "abc".replace(/x*/g, "-"));
+assertEquals("-a-b-c-", "abc".replace(/x*/g, "-"));
+assertEquals("", RegExp.lastMatch);
+assertEquals("", "".replace(/x*/g, ""));
+
+// No match leaves the subject and the last match alone.
+"abc".match(/b/);
+assertEquals(subject, subject.replace(/zebra/g, "x"));
+assertEquals(subject, subject.replace(/zebra/g, "x"));
+assertEquals("b", RegExp.lastMatch);
+
+// Two-byte subjects and replacements.
+var two_byte = "ሴabcሴabc";
+assertEquals("ሴxbcሴxbc", two_byte.replace(/a/g, "x"));
+assertEquals("ሴxbcሴxbc", two_byte.replace(/a/g, "x"));
+assertEquals("⍅bc⍅bc", "abcabc".replace(/a/g, "⍅"));
+assertEquals("⍅bc⍅bc", "abcabc".replace(/a/g, "⍅"));
+
+// Captures are visible to replace functions and RegExp statics on a hit.
+for (var i = 0; i < 3; i++) {
+  var calls = [];
+  var result = "a1b2c3".replace(/([a-z])(\d)/g, function(m, l, d, pos) {
+    calls.push(m + ":" + l + ":" + d + ":" + pos);
+    return d + l;
+  });
+  assertEquals("1a2b3c", result);
+  assertEquals("a1:a:1:0,b2:b:2:2,c3:c:3:4", calls.join());
+  assertEquals("c", RegExp.$1);
+  assertEquals("3", RegExp.$2);
+}
+
+// String.prototype.match.
+for (var i = 0; i < 3; i++) {
+  assertEquals(["The", "the"], subject.substring(0, 45).match(/the/gi));
+  assertEquals(null, subject.match(/zebra/g));
+}
+
+// Recompiling a regexp must not hit results of the old pattern.
+var re = /fox/g;
+assertEquals(16, subject.match(re).length);
+re.compile("dog", "g");
+assertEquals(["dog", "dog"], subject.substring(0, 90).match(re));
+
+// Results survive and are dropped by garbage collections.
+var before = subject.replace(/(o)(\w)/g, "$2$1");
+gc();
+assertEquals(before, subject.replace(/(o)(\w)/g, "$2$1"));
+gc();
+assertEquals(before, subject.replace(/(o)(\w)/g, "$2$1"));
+
+// Flattened cons strings share the results of their flat contents.
+var cons = subject.substring(0, 20) + subject.substring(20);
+assertEquals(subject.replace(/\s/g, "_"), cons.replace(/\s/g, "_"));
+assertEquals(subject.replace(/\s/g, "_"), cons.replace(/\s/g, "_"));
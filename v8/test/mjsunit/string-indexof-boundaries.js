@@ -0,0 +1,79 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Test indexOf with matches at every position around the blocks scanned
+// by the vectorized character search, for one- and two-byte subjects.
+
+function NaiveIndexOf(subject, pattern, start) {
+  for (var i = start; i + pattern.length <= subject.length; i++) {
+    if (subject.substring(i, i + pattern.length) == pattern) return i;
+  }
+  return -1;
+}
+
+function Filler(length, two_byte) {
+  var s = "";
+  for (var i = 0; i < length; i++) {
+    s += String.fromCharCode(97 + i % 3);  // Only "a", "b" and "c".
+  }
+  // Prefixing a two-byte character that is then cut off again gives a
+  // two-byte subject.
+  return two_byte ? ("ሴ" + s).substring(1) : s;
+}
+
+var patterns = ["x", "xy", "xyz", "xa", "ax", "ሴ", "xሴ",
+                "ሴx", "axyb"];
+
+for (var two_byte = 0; two_byte < 2; two_byte++) {
+  for (var length = 0; length < 40; length++) {
+    var filler = Filler(length, two_byte);
+    for (var p = 0; p < patterns.length; p++) {
+      var pattern = patterns[p];
+      assertEquals(-1, filler.indexOf(pattern), "absent " + pattern);
+      for (var pos = 0; pos <= length; pos++) {
+        var subject = filler.substring(0, pos) + pattern +
+                      filler.substring(pos);
+        for (var start = 0; start <= pos + 1; start += 3) {
+          assertEquals(NaiveIndexOf(subject, pattern, start),
+                       subject.indexOf(pattern, start),
+                       pattern + " at " + pos + " from " + start);
+        }
+      }
+    }
+  }
+}
+
+// A partial match of the first two characters right at the end.
+assertEquals(-1, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaax".indexOf("xy"));
+assertEquals(-1, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaxy".indexOf("xyz"));
+assertEquals(34, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaxy".indexOf("xy"));
+
+// Two-byte pattern characters that match the low byte of an ASCII
+// character must not be found in a one-byte subject.
+assertEquals(-1, "abcabc".indexOf("š"));
+assertEquals(-1, "abcabc".indexOf("aŢ"));
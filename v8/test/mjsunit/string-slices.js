@@ -0,0 +1,125 @@
+// Copyright 2011 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Flags: --expose-externalize-string --allow-natives-syntax --expose-gc
+
+// Substrings of at least 13 characters share their parent's characters.
+
+var s = "abcdefghijklmnopqrstuvwxyz0123456789";
+var slice = s.substring(3, 30);
+assertEquals("defghijklmnopqrstuvwxyz0123", slice);
+assertEquals(27, slice.length);
+assertEquals(100, slice.charCodeAt(0));
+assertEquals("3", slice.charAt(26));
+assertTrue(isNaN(slice.charCodeAt(27)));
+
+// Slices of slices.
+var slice2 = slice.substring(2, 20);
+assertEquals("fghijklmnopqrstuvw", slice2);
+assertEquals("mno", slice2.substring(7, 10));
+assertEquals("pqrstuvwxyz0123456", s.substr(15, 18));
+assertEquals("fghijklmnopqrstuvw", s.slice(5, 23));
+
+// Slices of a flattened cons string.
+var cons = "";
+for (var i = 0; i < 20; i++) cons += String.fromCharCode(65 + i);
+cons.charCodeAt(0);  // Flatten it.
+var cons_slice = cons.substring(1, 18);
+assertEquals("BCDEFGHIJKLMNOPQR", cons_slice);
+assertEquals(66, cons_slice.charCodeAt(0));
+
+// Two-byte parents.
+var two_byte = "ሴ" + s + s;
+var two_byte_slice = two_byte.substring(1, 40);
+assertEquals(s + s.substring(0, 3), two_byte_slice);
+assertEquals(97, two_byte_slice.charCodeAt(0));
+assertEquals("ሴabcdefghijklm", two_byte.substring(0, 14));
+assertEquals(0x1234, two_byte.substring(0, 14).charCodeAt(0));
+
+// Concatenation, comparison, search and hashing.
+assertEquals("defghijklmnopqrstuvwxyz0123!", slice + "!");
+assertEquals("!defghijklmnopqrstuvwxyz0123", "!" + slice);
+assertTrue(slice == "defghijklmnopqrstuvwxyz0123");
+assertEquals(9, slice.indexOf("m"));
+assertEquals(-1, slice.indexOf("a"));
+var obj = {};
+obj[slice] = 42;
+assertEquals(42, obj["defghijklmnopqrstuvwxyz0123"]);
+assertEquals("DEFGHIJKLMNOPQRSTUVWXYZ0123", slice.toUpperCase());
+
+// Regular expressions on slices, including slices of two-byte strings.
+assertEquals(["jklmn", "k", "m"], /j(k)l(m)n/.exec(slice));
+assertEquals(7, slice.search(/kl/));
+assertEquals(["cdefghijk"], /c.*k/.exec(two_byte_slice));
+assertEquals("defghijklmnopqrstuvwxyz0-1-2-3",
+             slice.replace(/(\d)(?=\d)/g, "$1-"));
+
+// Slices survive garbage collection, also when their parent is otherwise
+// unreachable.
+function makeSlice() {
+  var parent = "0123456789" + "abcdefghijklmnopqrstuvwxyz";
+  parent.charCodeAt(0);  // Flatten it.
+  return parent.substring(5, 30);
+}
+var orphan = makeSlice();
+gc();
+gc();
+assertEquals("56789abcdefghijklmnopqrst", orphan);
+assertEquals("abcdefghijklmnopqrst", orphan.substring(5));
+
+// Externalizing the parent or the slice keeps its contents.
+var external_parent = "ABCDEFGHIJKLMNOPQRSTUVWXYZ" + "0123456789";
+external_parent.charCodeAt(0);
+var external_slice = external_parent.substring(10, 30);
+externalizeString(external_parent);
+assertEquals("KLMNOPQRSTUVWXYZ0123", external_slice);
+externalizeString(external_slice);
+assertEquals("KLMNOPQRSTUVWXYZ0123", external_slice);
+assertEquals("LMNOPQRSTUVWXYZ", external_slice.substring(1, 16));
+
+// Optimized charCodeAt reads through slices.
+function charCodeAt(str, i) { return str.charCodeAt(i); }
+for (var i = 0; i < 5; i++) charCodeAt(slice, i);
+%OptimizeFunctionOnNextCall(charCodeAt);
+assertEquals(101, charCodeAt(slice, 1));
+assertEquals(102, charCodeAt(slice2, 0));
+assertEquals(98, charCodeAt(two_byte_slice, 1));
+assertEquals(0x1234, charCodeAt(two_byte.substring(0, 14), 0));
+assertTrue(isNaN(charCodeAt(slice2, 18)));
+
+// Reading single characters of a rope that is still growing.
+var rope = "";
+for (var i = 0; i < 1000; i++) {
+  rope += String.fromCharCode(97 + i % 26);
+  assertEquals(97 + i % 26, rope.charCodeAt(i));
+  assertEquals(97, rope.charCodeAt(0));
+}
+assertEquals(1000, rope.length);
+for (var i = 0; i < 1000; i++) {
+  assertEquals(97 + i % 26, rope.charCodeAt(i));
+}
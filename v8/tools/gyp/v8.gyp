@@ -32,6 +32,7 @@
     'gcc_version%': 'unknown',
     'v8_target_arch%': '<(target_arch)',
     'v8_use_snapshot%': 'true',
+    'v8_snapshot_extra_code%': '',
     'v8_use_liveobjectlist%': 'false',
   },
   'conditions': [
@@ -242,7 +243,26 @@
               'outputs': [
                 '<(INTERMEDIATE_DIR)/snapshot.cc',
               ],
-              'action': ['<@(_inputs)', '<@(_outputs)'],
+              'variables': {
+                'mksnapshot_flags': [],
+              },
+              'conditions': [
+                ['v8_snapshot_extra_code!=""', {
+                  'inputs': [
+                    '<(v8_snapshot_extra_code)',
+                  ],
+                  'variables': {
+                    'mksnapshot_flags': [
+                      '--extra-code=<(v8_snapshot_extra_code)',
+                    ],
+                  },
+                }],
+              ],
+              'action': [
+                '<(PRODUCT_DIR)/<(EXECUTABLE_PREFIX)mksnapshot<(EXECUTABLE_SUFFIX)',
+                '<@(mksnapshot_flags)',
+                '<@(_outputs)',
+              ],
             },
           ],
         },
@@ -399,6 +419,7 @@
             '../../src/inspector.h',
             '../../src/interpreter-irregexp.cc',
             '../../src/interpreter-irregexp.h',
+            '../../src/json-parser.h',
             '../../src/jsregexp.cc',
             '../../src/jsregexp.h',
             '../../src/isolate.cc',
@@ -0,0 +1,23 @@
+// Loads a document linking resources/stylesheet-reuse.css in a new frame, and
+// passes the frame to the callback once the document has loaded.
+function loadFrame(callback)
+{
+    var frame = document.createElement("iframe");
+    frame.src = "resources/stylesheet-reuse-frame.html";
+    window.frameLoaded = function() {
+        setTimeout(function() { callback(frame); }, 0);
+    };
+    document.body.appendChild(frame);
+}
+
+function removeFrame(frame)
+{
+    frame.parentNode.removeChild(frame);
+    gc();
+}
+
+function targetColor(frame)
+{
+    var doc = frame.contentDocument;
+    return doc.defaultView.getComputedStyle(doc.getElementById("target"), null).color;
+}
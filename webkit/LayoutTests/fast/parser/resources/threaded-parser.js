@@ -0,0 +1,121 @@
+// Helpers for tests that parse a document with the threaded HTML parser (see
+// Settings::threadedHTMLParserEnabled()) and with the main-thread parser.
+// Only documents that are loaded, not ones script creates, use the threaded
+// parser, so the documents are loaded into iframes.
+var jsTestIsAsync = true;
+
+function setThreadedParserEnabled(enabled)
+{
+    if (window.layoutTestController)
+        layoutTestController.overridePreference("WebKitThreadedHTMLParserEnabled", enabled ? 1 : 0);
+}
+
+function escapeText(text)
+{
+    return text.replace(/\\/g, "\\\\").replace(/\r/g, "\\r").replace(/\n/g, "\\n").replace(/\0/g, "\\0").replace(/\uFFFD/g, "\\uFFFD");
+}
+
+function describeNode(node, indent, lines)
+{
+    switch (node.nodeType) {
+    case Node.DOCUMENT_TYPE_NODE:
+        lines.push(indent + "<!DOCTYPE " + node.name + " \"" + node.publicId + "\" \"" + node.systemId + "\">");
+        break;
+    case Node.ELEMENT_NODE:
+        var prefix = "";
+        if (node.namespaceURI == "http://www.w3.org/2000/svg")
+            prefix = "svg ";
+        else if (node.namespaceURI == "http://www.w3.org/1998/Math/MathML")
+            prefix = "math ";
+        lines.push(indent + "<" + prefix + node.localName + ">");
+        for (var i = 0; i < node.attributes.length; ++i)
+            lines.push(indent + "  " + node.attributes[i].name + "=\"" + escapeText(node.attributes[i].value) + "\"");
+        break;
+    case Node.TEXT_NODE:
+        lines.push(indent + "\"" + escapeText(node.data) + "\"");
+        break;
+    case Node.COMMENT_NODE:
+        lines.push(indent + "<!-- " + escapeText(node.data) + " -->");
+        break;
+    }
+    for (var child = node.firstChild; child; child = child.nextSibling)
+        describeNode(child, indent + "  ", lines);
+}
+
+// Describes the DOM of |document| in the html5lib tree test format.
+function describeDocument(document)
+{
+    var lines = [];
+    for (var child = document.firstChild; child; child = child.nextSibling)
+        describeNode(child, "| ", lines);
+    return lines.join("\n");
+}
+
+// Loads |url| into a new iframe, with the threaded parser if |threaded| is
+// true. |callback| is called with the iframe once it has loaded.
+function loadInFrame(url, threaded, callback)
+{
+    setThreadedParserEnabled(threaded);
+    var iframe = document.createElement("iframe");
+    iframe.onload = function() {
+        iframe.onload = null;
+        setTimeout(function() { callback(iframe); }, 0);
+    };
+    iframe.src = url;
+    document.body.appendChild(iframe);
+}
+
+// Parses |url| with the main-thread parser and then with the threaded one,
+// and calls |callback| with the description of each DOM.
+function parseWithBothParsers(url, callback)
+{
+    loadInFrame(url, false, function(mainThreadFrame) {
+        var mainThreadResult = describeDocument(mainThreadFrame.contentDocument);
+        document.body.removeChild(mainThreadFrame);
+        loadInFrame(url, true, function(threadedFrame) {
+            var threadedResult = describeDocument(threadedFrame.contentDocument);
+            document.body.removeChild(threadedFrame);
+            setThreadedParserEnabled(false);
+            callback(mainThreadResult, threadedResult);
+        });
+    });
+}
+
+var frameStoppingCallback;
+
+// Called by the document in a frame that loadUntilStopped() loaded, right
+// before the document stops its own parsing.
+function frameWillStopParsing(frameDocument)
+{
+    var callback = frameStoppingCallback;
+    frameStoppingCallback = null;
+    setTimeout(function() { callback(frameDocument); }, 0);
+}
+
+// Like loadInFrame(), for a document that stops its own parsing after it
+// calls frameWillStopParsing(). |callback| is called with the document once
+// the parser has stopped.
+function loadUntilStopped(url, threaded, callback)
+{
+    setThreadedParserEnabled(threaded);
+    var iframe = document.createElement("iframe");
+    frameStoppingCallback = function(frameDocument) {
+        if (iframe.parentNode)
+            document.body.removeChild(iframe);
+        callback(frameDocument);
+    };
+    iframe.src = url;
+    document.body.appendChild(iframe);
+}
+
+// Like parseWithBothParsers(), for documents that stop their own parsing.
+// |callback| is called with each parser's document.
+function parseUntilStoppedWithBothParsers(url, callback)
+{
+    loadUntilStopped(url, false, function(mainThreadDocument) {
+        loadUntilStopped(url, true, function(threadedDocument) {
+            setThreadedParserEnabled(false);
+            callback(mainThreadDocument, threadedDocument);
+        });
+    });
+}
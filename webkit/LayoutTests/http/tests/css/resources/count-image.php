@@ -0,0 +1,29 @@
+<?php
+require_once '../../resources/portabilityLayer.php';
+
+// Serves an image that must not be cached, and counts how often it was
+// requested. "?count" returns the count and "?reset" clears it.
+$tmpFile = sys_get_temp_dir() . "/" . "css_count_image_counter";
+
+header("Cache-Control: no-store");
+
+if (isset($_GET['reset'])) {
+    if (file_exists($tmpFile))
+        unlink($tmpFile);
+    header("Content-Type: text/plain");
+    print("0");
+    exit();
+}
+
+$value = file_exists($tmpFile) ? file_get_contents($tmpFile) : "0";
+
+if (isset($_GET['count'])) {
+    header("Content-Type: text/plain");
+    print($value);
+    exit();
+}
+
+file_put_contents($tmpFile, ++$value);
+header("Content-Type: image/gif");
+print(base64_decode("R0lGODlhAQABAIAAAAD/AP///yH5BAEAAAEALAAAAAABAAEAAAICRAEAOw=="));
+?>
@@ -311,7 +311,9 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	html/CheckboxInputType.cpp \
 	html/ClassList.cpp \
 	html/CollectionCache.cpp \
+	html/parser/BackgroundHTMLParser.cpp \
 	html/parser/CSSPreloadScanner.cpp \
+	html/parser/CompactHTMLToken.cpp \
 	html/ColorInputType.cpp \
 	html/DOMFormData.cpp \
 	html/DOMSettableTokenList.cpp \
@@ -400,6 +402,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	html/parser/HTMLMetaCharsetParser.cpp \
 	html/parser/HTMLParserIdioms.cpp \
 	html/parser/HTMLParserScheduler.cpp \
+	html/parser/HTMLParserThread.cpp \
 	html/parser/HTMLPreloadScanner.cpp \
 	html/parser/HTMLScriptRunner.cpp \
 	html/parser/HTMLSourceTracker.cpp \
@@ -657,6 +660,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/graphics/android/GraphicsLayerAndroid.cpp \
 	platform/graphics/android/ImageAndroid.cpp \
 	platform/graphics/android/ImageBufferAndroid.cpp \
+	platform/graphics/android/ImageDecodingService.cpp \
 	platform/graphics/android/ImageSourceAndroid.cpp \
 	platform/graphics/android/ImagesManager.cpp \
 	platform/graphics/android/ImageTexture.cpp \
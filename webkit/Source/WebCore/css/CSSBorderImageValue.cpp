@@ -67,4 +67,9 @@ void CSSBorderImageValue::addSubresourceStyleURLs(ListHashSet<KURL>& urls, const
     m_image->addSubresourceStyleURLs(urls, styleSheet);
 }
 
+void CSSBorderImageValue::clearCachedImages()
+{
+    m_image->clearCachedImages();
+}
+
 } // namespace WebCore
@@ -42,6 +42,7 @@ public:
     CSSValue* imageValue() const { return m_image.get(); }
 
     virtual void addSubresourceStyleURLs(ListHashSet<KURL>&, const CSSStyleSheet*);
+    virtual void clearCachedImages();
 
     // The border image.
     RefPtr<CSSValue> m_image;
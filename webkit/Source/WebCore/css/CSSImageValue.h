@@ -41,6 +41,8 @@ public:
     virtual StyleCachedImage* cachedImage(CachedResourceLoader*);
     // Returns a StyleCachedImage if the image is cached already, otherwise a StylePendingImage.
     StyleImage* cachedOrPendingImage();
+
+    virtual void clearCachedImages() { clearCachedImage(); }
     
 protected:
     CSSImageValue(const String& url);
@@ -109,6 +109,15 @@ void CSSMediaRule::deleteRule(unsigned index, ExceptionCode& ec)
         stylesheet()->styleSheetChanged();
 }
 
+void CSSMediaRule::clearCachedImages()
+{
+    if (!m_lstCSSRules)
+        return;
+    unsigned len = m_lstCSSRules->length();
+    for (unsigned i = 0; i < len; i++)
+        m_lstCSSRules->item(i)->clearCachedImages();
+}
+
 String CSSMediaRule::cssText() const
 {
     String result = "@media ";
@@ -48,6 +48,7 @@ public:
     void deleteRule(unsigned index, ExceptionCode&);
 
     virtual String cssText() const;
+    virtual void clearCachedImages();
 
     // Not part of the CSSOM
     unsigned append(CSSRule*);
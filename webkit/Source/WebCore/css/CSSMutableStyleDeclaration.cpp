@@ -789,6 +789,13 @@ void CSSMutableStyleDeclaration::addSubresourceStyleURLs(ListHashSet<KURL>& urls
         m_properties[i].value()->addSubresourceStyleURLs(urls, sheet);
 }
 
+void CSSMutableStyleDeclaration::clearCachedImages()
+{
+    size_t size = m_properties.size();
+    for (size_t i = 0; i < size; ++i)
+        m_properties[i].value()->clearCachedImages();
+}
+
 // This is the list of properties we want to copy in the copyBlockProperties() function.
 // It is the list of CSS properties that apply specially to block-level elements.
 static const int blockProperties[] = {
@@ -65,4 +65,10 @@ void CSSReflectValue::addSubresourceStyleURLs(ListHashSet<KURL>& urls, const CSS
         m_mask->addSubresourceStyleURLs(urls, styleSheet);
 }
 
+void CSSReflectValue::clearCachedImages()
+{
+    if (m_mask)
+        m_mask->clearCachedImages();
+}
+
 } // namespace WebCore
@@ -50,6 +50,7 @@ public:
     virtual String cssText() const;
 
     virtual void addSubresourceStyleURLs(ListHashSet<KURL>&, const CSSStyleSheet*);
+    virtual void clearCachedImages();
 
 private:
     CSSReflectValue(CSSReflectionDirection direction,
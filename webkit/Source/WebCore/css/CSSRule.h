@@ -61,6 +61,7 @@ public:
     void setCssText(const String&, ExceptionCode&);
 
     virtual void addSubresourceStyleURLs(ListHashSet<KURL>&) { }
+    virtual void clearCachedImages() { }
 
 protected:
     CSSRule(CSSStyleSheet* parent)
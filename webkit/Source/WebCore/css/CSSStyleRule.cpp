@@ -112,4 +112,10 @@ void CSSStyleRule::addSubresourceStyleURLs(ListHashSet<KURL>& urls)
         m_style->addSubresourceStyleURLs(urls);
 }
 
+void CSSStyleRule::clearCachedImages()
+{
+    if (m_style)
+        m_style->clearCachedImages();
+}
+
 } // namespace WebCore
@@ -57,6 +57,7 @@ public:
     CSSMutableStyleDeclaration* declaration() { return m_style.get(); }
 
     virtual void addSubresourceStyleURLs(ListHashSet<KURL>& urls);
+    virtual void clearCachedImages();
 
     int sourceLine() { return m_sourceLine; }
 
@@ -99,6 +99,7 @@
 #include "WebKitCSSTransformValue.h"
 #include "XMLNames.h"
 #include <wtf/StdLibExtras.h>
+#include <wtf/StringHasher.h>
 #include <wtf/Vector.h>
 
 #if USE(PLATFORM_STRATEGIES)
@@ -431,6 +432,9 @@ CSSStyleSelector::CSSStyleSelector(Document* document, StyleSheetList* styleShee
                                    CSSStyleSheet* pageUserSheet, const Vector<RefPtr<CSSStyleSheet> >* pageGroupUserSheets,
                                    bool strictParsing, bool matchAuthorAndUserStyles)
     : m_backgroundData(BackgroundFillLayer)
+    , m_matchedDeclarationCacheHits(0)
+    , m_matchedDeclarationCacheMisses(0)
+    , m_appliedDeclarationsAreCacheable(false)
     , m_checker(document, strictParsing)
     , m_element(0)
     , m_styledElement(0)
@@ -730,7 +734,12 @@ void CSSStyleSelector::matchRules(RuleSet* rules, int& firstRuleIndex, int& last
         for (unsigned i = 0; i < m_matchedRules.size(); i++) {
             if (!m_ruleList)
                 m_ruleList = CSSRuleList::create();
-            m_ruleList->append(m_matchedRules[i]->rule());
+            CSSStyleRule* rule = m_matchedRules[i]->rule();
+            if (StyleSheet* sheet = rule->stylesheet()) {
+                if (sheet->isCSSStyleSheet())
+                    static_cast<CSSStyleSheet*>(sheet)->setRulesExposed();
+            }
+            m_ruleList->append(rule);
         }
     }
 }
@@ -1128,6 +1137,80 @@ static inline bool parentStylePreventsSharing(const RenderStyle* parentStyle)
         || parentStyle->childrenAffectedByDirectAdjacentRules();
 }
 
+bool CSSStyleSelector::MatchRanges::operator==(const MatchRanges& other) const
+{
+    return firstUARule == other.firstUARule
+        && lastUARule == other.lastUARule
+        && firstUserRule == other.firstUserRule
+        && lastUserRule == other.lastUserRule
+        && firstAuthorRule == other.firstAuthorRule
+        && lastAuthorRule == other.lastAuthorRule;
+}
+
+// Enough for the distinct rule combinations of large documents; the cache is simply dropped when it fills up.
+static const unsigned maximumMatchedDeclarationCacheSize = 1024;
+
+bool CSSStyleSelector::canUseMatchedDeclarationCache(Element* e, bool matchVisitedPseudoClass) const
+{
+    if (m_matchedDecls.isEmpty() || !m_parentNode || !m_parentStyle || !m_rootElementStyle)
+        return false;
+    // Link styles depend on the visited state of the link.
+    if (matchVisitedPseudoClass || e->isLink() || m_elementLinkState != NotInsideLink)
+        return false;
+    // The inline style declaration can be mutated in place.
+    if (m_styledElement && m_styledElement->inlineStyleDecl())
+        return false;
+#if ENABLE(SVG)
+    // Lengths and font sizes of SVG elements are zoomed differently.
+    if (e->isSVGElement())
+        return false;
+#endif
+    return true;
+}
+
+unsigned CSSStyleSelector::computeMatchedDeclarationHash() const
+{
+    return StringHasher::hashMemory(m_matchedDecls.data(), m_matchedDecls.size() * sizeof(CSSMutableStyleDeclaration*));
+}
+
+const CSSStyleSelector::MatchedDeclarationCacheItem* CSSStyleSelector::findFromMatchedDeclarationCache(unsigned hash, const MatchRanges& ranges) const
+{
+    MatchedDeclarationCache::const_iterator it = m_matchedDeclarationCache.find(hash);
+    if (it == m_matchedDeclarationCache.end())
+        return 0;
+    const MatchedDeclarationCacheItem& cacheItem = it->second;
+
+    size_t size = m_matchedDecls.size();
+    if (size != cacheItem.declarations.size() || !(ranges == cacheItem.ranges))
+        return 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (m_matchedDecls[i] != cacheItem.declarations[i])
+            return 0;
+    }
+    if (m_parentStyle->inheritedNotEqual(cacheItem.parentRenderStyle.get()))
+        return 0;
+    if (m_rootElementStyle->fontDescription() != cacheItem.rootFontDescription)
+        return 0;
+    return &cacheItem;
+}
+
+void CSSStyleSelector::addToMatchedDeclarationCache(unsigned hash, const MatchRanges& ranges)
+{
+    if (m_matchedDeclarationCache.size() >= maximumMatchedDeclarationCacheSize)
+        m_matchedDeclarationCache.clear();
+
+    MatchedDeclarationCacheItem cacheItem;
+    cacheItem.declarations.reserveInitialCapacity(m_matchedDecls.size());
+    for (size_t i = 0; i < m_matchedDecls.size(); ++i)
+        cacheItem.declarations.uncheckedAppend(m_matchedDecls[i]);
+    cacheItem.ranges = ranges;
+    cacheItem.rootFontDescription = m_rootElementStyle->fontDescription();
+    // The cached style must not be affected by the adjustments made for this particular element.
+    cacheItem.renderStyle = RenderStyle::clone(m_style.get());
+    cacheItem.parentRenderStyle = m_parentStyle;
+    m_matchedDeclarationCache.set(hash, cacheItem);
+}
+
 ALWAYS_INLINE RenderStyle* CSSStyleSelector::locateSharedStyle()
 {
     if (!m_styledElement || !m_parentStyle)
@@ -1440,47 +1523,78 @@ PassRefPtr<RenderStyle> CSSStyleSelector::styleForElement(Element* e, RenderStyl
 
     // Reset the value back before applying properties, so that -webkit-link knows what color to use.
     m_checker.m_matchVisitedPseudoClass = matchVisitedPseudoClass;
-    
-    // Now we have all of the matched rules in the appropriate order.  Walk the rules and apply
-    // high-priority properties first, i.e., those properties that other properties depend on.
-    // The order is (1) high-priority not important, (2) high-priority important, (3) normal not important
-    // and (4) normal important.
-    m_lineHeightValue = 0;
-    applyDeclarations<true>(false, 0, m_matchedDecls.size() - 1);
-    if (!resolveForRootDefault) {
-        applyDeclarations<true>(true, firstAuthorRule, lastAuthorRule);
-        applyDeclarations<true>(true, firstUserRule, lastUserRule);
+
+    MatchRanges matchRanges = { firstUARule, lastUARule, firstUserRule, lastUserRule, firstAuthorRule, lastAuthorRule };
+    unsigned cacheHash = 0;
+    const MatchedDeclarationCacheItem* cacheItem = 0;
+    if (!resolveForRootDefault && !visitedStyle && e != e->document()->documentElement() && canUseMatchedDeclarationCache(e, matchVisitedPseudoClass)) {
+        cacheHash = computeMatchedDeclarationHash();
+        cacheItem = findFromMatchedDeclarationCache(cacheHash, matchRanges);
+        if (cacheItem)
+            ++m_matchedDeclarationCacheHits;
+        else
+            ++m_matchedDeclarationCacheMisses;
     }
-    applyDeclarations<true>(true, firstUARule, lastUARule);
-    
-    // If our font got dirtied, go ahead and update it now.
-    if (m_fontDirty)
-        updateFont();
 
-    // Line-height is set when we are sure we decided on the font-size
-    if (m_lineHeightValue)
-        applyProperty(CSSPropertyLineHeight, m_lineHeightValue);
+    if (cacheItem) {
+        // Applying the same declarations on top of the same inherited data gives the same result, so
+        // take it from the cache. The flags set by selector matching above are left alone.
+        m_style->copyNonInheritedFrom(cacheItem->renderStyle.get());
+        m_style->inheritFrom(cacheItem->renderStyle.get());
+    } else {
+        m_appliedDeclarationsAreCacheable = true;
 
-    // Now do the normal priority UA properties.
-    applyDeclarations<false>(false, firstUARule, lastUARule);
-    
-    // Cache our border and background so that we can examine them later.
-    cacheBorderAndBackground();
-    
-    // Now do the author and user normal priority properties and all the !important properties.
-    if (!resolveForRootDefault) {
-        applyDeclarations<false>(false, lastUARule + 1, m_matchedDecls.size() - 1);
-        applyDeclarations<false>(true, firstAuthorRule, lastAuthorRule);
-        applyDeclarations<false>(true, firstUserRule, lastUserRule);
+        // Now we have all of the matched rules in the appropriate order.  Walk the rules and apply
+        // high-priority properties first, i.e., those properties that other properties depend on.
+        // The order is (1) high-priority not important, (2) high-priority important, (3) normal not important
+        // and (4) normal important.
+        m_lineHeightValue = 0;
+        applyDeclarations<true>(false, 0, m_matchedDecls.size() - 1);
+        if (!resolveForRootDefault) {
+            applyDeclarations<true>(true, firstAuthorRule, lastAuthorRule);
+            applyDeclarations<true>(true, firstUserRule, lastUserRule);
+        }
+        applyDeclarations<true>(true, firstUARule, lastUARule);
+
+        // If our font got dirtied, go ahead and update it now.
+        if (m_fontDirty)
+            updateFont();
+
+        // Line-height is set when we are sure we decided on the font-size
+        if (m_lineHeightValue)
+            applyProperty(CSSPropertyLineHeight, m_lineHeightValue);
+
+        // Now do the normal priority UA properties.
+        applyDeclarations<false>(false, firstUARule, lastUARule);
+
+        // Cache our border and background so that we can examine them later.
+        cacheBorderAndBackground();
+
+        // Now do the author and user normal priority properties and all the !important properties.
+        if (!resolveForRootDefault) {
+            applyDeclarations<false>(false, lastUARule + 1, m_matchedDecls.size() - 1);
+            applyDeclarations<false>(true, firstAuthorRule, lastAuthorRule);
+            applyDeclarations<false>(true, firstUserRule, lastUserRule);
+        }
+        applyDeclarations<false>(true, firstUARule, lastUARule);
+
+        ASSERT(!m_fontDirty);
+        // If our font got dirtied by one of the non-essential font props,
+        // go ahead and update it a second time.
+        if (m_fontDirty)
+            updateFont();
+
+        // Styles with an appearance are adjusted using the border and background cached above, and
+        // unique styles were built from attributes of the element (attr() or SVG cursors).
+        if (cacheHash && m_appliedDeclarationsAreCacheable && !m_style->hasAppearance() && !m_style->unique()) {
+            // Images have to be loaded before the style is cached so that styles built from the
+            // cache do not refer to pending images.
+            loadPendingImages();
+            addToMatchedDeclarationCache(cacheHash, matchRanges);
+        }
+        m_appliedDeclarationsAreCacheable = false;
     }
-    applyDeclarations<false>(true, firstUARule, lastUARule);
 
-    ASSERT(!m_fontDirty);
-    // If our font got dirtied by one of the non-essential font props, 
-    // go ahead and update it a second time.
-    if (m_fontDirty)
-        updateFont();
-    
     // Clean up our style object's display and text decorations (among other fixups).
     adjustRenderStyle(style(), m_parentStyle, e);
 
@@ -3559,6 +3673,10 @@ void CSSStyleSelector::applyProperty(int id, CSSValue *value)
 
     bool isInherit = m_parentNode && valueType == CSSValue::CSS_INHERIT;
     bool isInitial = valueType == CSSValue::CSS_INITIAL || (!m_parentNode && valueType == CSSValue::CSS_INHERIT);
+
+    // Explicitly inherited non-inherited properties depend on more than the parent's inherited data.
+    if (isInherit)
+        m_appliedDeclarationsAreCacheable = false;
     
     id = CSSProperty::resolveDirectionAwareProperty(id, m_style->direction(), m_style->writingMode());
 
@@ -4771,6 +4889,7 @@ void CSSStyleSelector::applyProperty(int id, CSSValue *value)
             m_style->setEffectiveZoom(RenderStyle::initialZoom());
             m_style->setZoom(RenderStyle::initialZoom());
         } else if (primitiveValue->getIdent() == CSSValueDocument) {
+            m_appliedDeclarationsAreCacheable = false;
             float docZoom = m_checker.m_document->renderer()->style()->zoom();
             m_style->setEffectiveZoom(docZoom);
             m_style->setZoom(docZoom);
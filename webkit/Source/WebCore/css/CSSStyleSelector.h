@@ -183,6 +183,9 @@ public:
         bool usesBeforeAfterRules() const { return m_features.usesBeforeAfterRules; }
         bool usesLinkRules() const { return m_features.usesLinkRules; }
 
+        unsigned matchedDeclarationCacheHits() const { return m_matchedDeclarationCacheHits; }
+        unsigned matchedDeclarationCacheMisses() const { return m_matchedDeclarationCacheMisses; }
+
         static bool createTransformOperations(CSSValue* inValue, RenderStyle* inStyle, RenderStyle* rootStyle, TransformOperations& outOperations);
 
         struct Features {
@@ -218,6 +221,34 @@ public:
         template <bool firstPass>
         void applyDeclarations(bool important, int startIndex, int endIndex);
 
+        // The indices of the UA, user and author declarations in |m_matchedDecls|.
+        struct MatchRanges {
+            bool operator==(const MatchRanges&) const;
+
+            int firstUARule;
+            int lastUARule;
+            int firstUserRule;
+            int lastUserRule;
+            int firstAuthorRule;
+            int lastAuthorRule;
+        };
+
+        // Elements that match the same declarations in the same order and whose parents have identical
+        // inherited data end up with identical styles, so the style built by applying the declarations
+        // once is kept and copied into the next element instead of applying them all again.
+        struct MatchedDeclarationCacheItem {
+            Vector<RefPtr<CSSMutableStyleDeclaration> > declarations;
+            MatchRanges ranges;
+            FontDescription rootFontDescription; // For rem units.
+            RefPtr<RenderStyle> renderStyle;
+            RefPtr<RenderStyle> parentRenderStyle;
+        };
+
+        bool canUseMatchedDeclarationCache(Element*, bool matchVisitedPseudoClass) const;
+        unsigned computeMatchedDeclarationHash() const;
+        const MatchedDeclarationCacheItem* findFromMatchedDeclarationCache(unsigned hash, const MatchRanges&) const;
+        void addToMatchedDeclarationCache(unsigned hash, const MatchRanges&);
+
         void matchPageRules(RuleSet*, bool isLeftPage, bool isFirstPage, const String& pageName);
         void matchPageRulesForList(const Vector<RuleData>*, bool isLeftPage, bool isFirstPage, const String& pageName);
         bool isLeftPage(int pageIndex) const;
@@ -250,6 +281,13 @@ public:
         typedef HashMap<AtomicStringImpl*, RefPtr<WebKitCSSKeyframesRule> > KeyframesRuleMap;
         KeyframesRuleMap m_keyframesRuleMap;
 
+        typedef HashMap<unsigned, MatchedDeclarationCacheItem> MatchedDeclarationCache;
+        MatchedDeclarationCache m_matchedDeclarationCache;
+        unsigned m_matchedDeclarationCacheHits;
+        unsigned m_matchedDeclarationCacheMisses;
+        // Cleared while applying declarations whose result depends on more than the parent's inherited data.
+        bool m_appliedDeclarationsAreCacheable;
+
     public:
         static RenderStyle* styleNotYetAvailable() { return s_styleNotYetAvailable; }
 
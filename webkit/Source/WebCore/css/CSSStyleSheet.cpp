@@ -58,6 +58,7 @@ CSSStyleSheet::CSSStyleSheet(CSSStyleSheet* parentSheet, const String& href, con
     , m_strictParsing(!parentSheet || parentSheet->useStrictParsing())
     , m_isUserStyleSheet(parentSheet ? parentSheet->isUserStyleSheet() : false)
     , m_hasSyntacticallyValidCSSHeader(true)
+    , m_rulesExposed(false)
 {
 }
 
@@ -68,6 +69,7 @@ CSSStyleSheet::CSSStyleSheet(Node* parentNode, const String& href, const KURL& b
     , m_strictParsing(false)
     , m_isUserStyleSheet(false)
     , m_hasSyntacticallyValidCSSHeader(true)
+    , m_rulesExposed(false)
 {
     ASSERT(isAcceptableCSSStyleSheetParent(parentNode));
 }
@@ -78,6 +80,7 @@ CSSStyleSheet::CSSStyleSheet(CSSRule* ownerRule, const String& href, const KURL&
     , m_loadCompleted(false)
     , m_strictParsing(!ownerRule || ownerRule->useStrictParsing())
     , m_hasSyntacticallyValidCSSHeader(true)
+    , m_rulesExposed(false)
 {
     CSSStyleSheet* parentSheet = ownerRule ? ownerRule->parentStyleSheet() : 0;
     m_isUserStyleSheet = parentSheet ? parentSheet->isUserStyleSheet() : false;
@@ -150,6 +153,7 @@ PassRefPtr<CSSRuleList> CSSStyleSheet::cssRules(bool omitCharsetRules)
     KURL url = finalURL();
     if (!url.isEmpty() && document() && !document()->securityOrigin()->canRequest(url))
         return 0;
+    setRulesExposed();
     return CSSRuleList::create(this, omitCharsetRules);
 }
 
@@ -253,6 +257,8 @@ void CSSStyleSheet::styleSheetChanged()
     StyleBase* root = this;
     while (StyleBase* parent = root->parent())
         root = parent;
+    if (root->isCSSStyleSheet())
+        static_cast<CSSStyleSheet*>(root)->setRulesExposed();
     Document* documentToUpdate = root->isCSSStyleSheet() ? static_cast<CSSStyleSheet*>(root)->document() : 0;
     
     /* FIXME: We don't need to do everything updateStyleSelector does,
@@ -263,6 +269,26 @@ void CSSStyleSheet::styleSheetChanged()
         documentToUpdate->styleSelectorChanged(DeferRecalcStyle);
 }
 
+bool CSSStyleSheet::hasImportRules()
+{
+    unsigned size = length();
+    for (unsigned i = 0; i < size; ++i) {
+        if (item(i)->isImportRule())
+            return true;
+    }
+    return false;
+}
+
+void CSSStyleSheet::clearCachedImages()
+{
+    unsigned size = length();
+    for (unsigned i = 0; i < size; ++i) {
+        StyleBase* styleBase = item(i);
+        if (styleBase->isRule())
+            static_cast<CSSRule*>(styleBase)->clearCachedImages();
+    }
+}
+
 KURL CSSStyleSheet::completeURL(const String& url) const
 {
     // Always return a null URL when passed a null string.
@@ -104,6 +104,15 @@ public:
     void setHasSyntacticallyValidCSSHeader(bool b) { m_hasSyntacticallyValidCSSHeader = b; }
     bool hasSyntacticallyValidCSSHeader() const { return m_hasSyntacticallyValidCSSHeader; }
 
+    // Set once script or the inspector may hold on to the rules or has changed
+    // them. Such a sheet is never handed to another document for reuse; see
+    // CachedCSSStyleSheet::restoreParsedStyleSheet().
+    void setRulesExposed() { m_rulesExposed = true; }
+    bool rulesExposed() const { return m_rulesExposed; }
+
+    bool hasImportRules();
+    void clearCachedImages();
+
 private:
     CSSStyleSheet(Node* ownerNode, const String& originalURL, const KURL& finalURL, const String& charset);
     CSSStyleSheet(CSSStyleSheet* parentSheet, const String& originalURL, const KURL& finalURL, const String& charset);
@@ -118,6 +127,7 @@ private:
     bool m_strictParsing : 1;
     bool m_isUserStyleSheet : 1;
     bool m_hasSyntacticallyValidCSSHeader : 1;
+    bool m_rulesExposed : 1;
 };
 
 } // namespace
@@ -71,6 +71,9 @@ public:
 #endif
 
     virtual void addSubresourceStyleURLs(ListHashSet<KURL>&, const CSSStyleSheet*) { }
+
+    // Forgets the images loaded for the value, so that the next document using it requests them itself.
+    virtual void clearCachedImages() { }
 };
 
 } // namespace WebCore
@@ -127,4 +127,11 @@ void CSSValueList::addSubresourceStyleURLs(ListHashSet<KURL>& urls, const CSSSty
         m_values[i]->addSubresourceStyleURLs(urls, styleSheet);
 }
 
+void CSSValueList::clearCachedImages()
+{
+    size_t size = m_values.size();
+    for (size_t i = 0; i < size; ++i)
+        m_values[i]->clearCachedImages();
+}
+
 } // namespace WebCore
@@ -59,6 +59,7 @@ public:
     virtual String cssText() const;
 
     virtual void addSubresourceStyleURLs(ListHashSet<KURL>&, const CSSStyleSheet*);
+    virtual void clearCachedImages();
 
 protected:
     CSSValueList(bool isSpaceSeparated);
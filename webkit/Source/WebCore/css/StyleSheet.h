@@ -41,6 +41,7 @@ public:
 
     Node* ownerNode() const { return m_parentNode; }
     void clearOwnerNode() { m_parentNode = 0; }
+    void setOwnerNode(Node* ownerNode) { ASSERT(!m_parentNode); m_parentNode = ownerNode; }
     StyleSheet *parentStyleSheet() const;
 
     // Note that href is the URL that started the redirect chain that led to
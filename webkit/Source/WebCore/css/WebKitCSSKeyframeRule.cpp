@@ -52,6 +52,12 @@ String WebKitCSSKeyframeRule::cssText() const
     return result;
 }
 
+void WebKitCSSKeyframeRule::clearCachedImages()
+{
+    if (m_style)
+        m_style->clearCachedImages();
+}
+
 bool WebKitCSSKeyframeRule::parseString(const String& /*string*/, bool /*strict*/)
 {
     // FIXME
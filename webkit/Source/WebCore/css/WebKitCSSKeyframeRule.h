@@ -62,6 +62,7 @@ public:
     CSSMutableStyleDeclaration* style() const { return m_style.get(); }
 
     virtual String cssText() const;
+    virtual void clearCachedImages();
 
     // Not part of the CSSOM
     virtual bool parseString(const String&, bool = false);
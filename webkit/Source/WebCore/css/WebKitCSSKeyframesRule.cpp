@@ -137,6 +137,15 @@ int WebKitCSSKeyframesRule::findRuleIndex(const String& key) const
     return -1;
 }
 
+void WebKitCSSKeyframesRule::clearCachedImages()
+{
+    if (!m_lstCSSRules)
+        return;
+    unsigned len = m_lstCSSRules->length();
+    for (unsigned i = 0; i < len; i++)
+        m_lstCSSRules->item(i)->clearCachedImages();
+}
+
 String WebKitCSSKeyframesRule::cssText() const
 {
     String result = "@-webkit-keyframes ";
@@ -74,6 +74,7 @@ public:
     WebKitCSSKeyframeRule* findRule(const String& key);
 
     virtual String cssText() const;
+    virtual void clearCachedImages();
 
     /* not part of the DOM */
     unsigned length() const;
@@ -364,8 +364,6 @@ void HTMLLinkElement::setCSSStyleSheet(const String& href, const KURL& baseURL,
         return;
     }
 
-    m_sheet = CSSStyleSheet::create(this, href, baseURL, charset);
-
     bool strictParsing = !document()->inQuirksMode();
     bool enforceMIMEType = strictParsing;
     bool crossOriginCSS = false;
@@ -385,8 +383,24 @@ void HTMLLinkElement::setCSSStyleSheet(const String& href, const KURL& baseURL,
     }
 #endif
 
-    String sheetText = sheet->sheetText(enforceMIMEType, &validMIMEType);
-    m_sheet->parseString(sheetText, strictParsing);
+    // Work around <https://bugs.webkit.org/show_bug.cgi?id=28350>.
+    DEFINE_STATIC_LOCAL(const String, slashKHTMLFixesDotCss, ("/KHTMLFixes.css"));
+    bool mayNeedKHTMLFixesQuirk = strictParsing && needsSiteSpecificQuirks && baseURL.string().endsWith(slashKHTMLFixesDotCss);
+
+    ASSERT(sheet == m_cachedSheet);
+    String sheetText;
+    RefPtr<CSSStyleSheet> restoredSheet;
+    if (!mayNeedKHTMLFixesQuirk)
+        restoredSheet = m_cachedSheet->restoreParsedStyleSheet(href, strictParsing, enforceMIMEType, &validMIMEType);
+    if (restoredSheet) {
+        m_sheet = restoredSheet.release();
+        m_sheet->setOwnerNode(this);
+    } else {
+        m_sheet = CSSStyleSheet::create(this, href, baseURL, charset);
+        sheetText = sheet->sheetText(enforceMIMEType, &validMIMEType);
+        m_sheet->parseString(sheetText, strictParsing);
+        m_cachedSheet->saveParsedStyleSheet(m_sheet, enforceMIMEType, validMIMEType);
+    }
 
     // If we're loading a stylesheet cross-origin, and the MIME type is not
     // standard, require the CSS to at least start with a syntactically
@@ -396,16 +410,16 @@ void HTMLLinkElement::setCSSStyleSheet(const String& href, const KURL& baseURL,
     if (!document()->securityOrigin()->canRequest(baseURL))
         crossOriginCSS = true;
 
-    if (crossOriginCSS && !validMIMEType && !m_sheet->hasSyntacticallyValidCSSHeader())
+    if (crossOriginCSS && !validMIMEType && !m_sheet->hasSyntacticallyValidCSSHeader()) {
+        m_sheet->clearOwnerNode();
         m_sheet = CSSStyleSheet::create(this, href, baseURL, charset);
+    }
 
-    if (strictParsing && needsSiteSpecificQuirks) {
-        // Work around <https://bugs.webkit.org/show_bug.cgi?id=28350>.
-        DEFINE_STATIC_LOCAL(const String, slashKHTMLFixesDotCss, ("/KHTMLFixes.css"));
+    if (mayNeedKHTMLFixesQuirk) {
         DEFINE_STATIC_LOCAL(const String, mediaWikiKHTMLFixesStyleSheet, ("/* KHTML fix stylesheet */\n/* work around the horizontal scrollbars */\n#column-content { margin-left: 0; }\n\n"));
         // There are two variants of KHTMLFixes.css. One is equal to mediaWikiKHTMLFixesStyleSheet,
         // while the other lacks the second trailing newline.
-        if (baseURL.string().endsWith(slashKHTMLFixesDotCss) && !sheetText.isNull() && mediaWikiKHTMLFixesStyleSheet.startsWith(sheetText)
+        if (!sheetText.isNull() && mediaWikiKHTMLFixesStyleSheet.startsWith(sheetText)
                 && sheetText.length() >= mediaWikiKHTMLFixesStyleSheet.length() - 1) {
             ASSERT(m_sheet->length() == 1);
             ExceptionCode ec;
@@ -0,0 +1,337 @@
+/*
+ * Copyright (C) 2011 Google, Inc. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "BackgroundHTMLParser.h"
+
+#include "HTMLDocumentParser.h"
+#include "HTMLNames.h"
+#include "HTMLParserThread.h"
+#include <wtf/MainThread.h>
+
+namespace WebCore {
+
+using namespace HTMLNames;
+
+namespace {
+
+// Don't send more than this many tokens to the main thread at once so that
+// the tree builder can get started while the rest of the input is tokenized.
+const size_t maximumTokensPerChunk = 500;
+
+// The HTMLNames are AtomicStrings that belong to the main thread, but looking
+// at their characters from another thread is fine.
+inline bool threadSafeMatch(const String& localName, const QualifiedName& qName)
+{
+    return equal(localName.impl(), qName.localName().impl());
+}
+
+inline bool isTextModeState(HTMLTokenizer::State state)
+{
+    return state == HTMLTokenizer::RCDATAState
+        || state == HTMLTokenizer::RAWTEXTState
+        || state == HTMLTokenizer::ScriptDataState;
+}
+
+struct ChunkDelivery {
+    WTF_MAKE_NONCOPYABLE(ChunkDelivery); WTF_MAKE_FAST_ALLOCATED;
+public:
+    ChunkDelivery(PassRefPtr<BackgroundHTMLParser> parser, PassOwnPtr<BackgroundHTMLParser::ParsedChunk> chunk)
+        : parser(parser)
+        , chunk(chunk)
+    {
+    }
+
+    RefPtr<BackgroundHTMLParser> parser;
+    OwnPtr<BackgroundHTMLParser::ParsedChunk> chunk;
+};
+
+} // namespace
+
+class BackgroundHTMLParser::AppendTask : public HTMLParserThread::Task {
+public:
+    AppendTask(BackgroundHTMLParser* parser, const String& source)
+        : HTMLParserThread::Task(parser)
+        , m_parser(parser)
+        , m_source(source.crossThreadString())
+    {
+    }
+
+    virtual void performTask() { m_parser->appendOnParserThread(m_source); }
+
+private:
+    RefPtr<BackgroundHTMLParser> m_parser;
+    String m_source;
+};
+
+class BackgroundHTMLParser::FinishTask : public HTMLParserThread::Task {
+public:
+    FinishTask(BackgroundHTMLParser* parser)
+        : HTMLParserThread::Task(parser)
+        , m_parser(parser)
+    {
+    }
+
+    virtual void performTask() { m_parser->finishOnParserThread(); }
+
+private:
+    RefPtr<BackgroundHTMLParser> m_parser;
+};
+
+class BackgroundHTMLParser::RestartTask : public HTMLParserThread::Task {
+public:
+    RestartTask(BackgroundHTMLParser* parser, unsigned generation, const Vector<String>& source, bool sourceIsComplete, int offset, const TextPosition0& position, const HTMLTokenizer::Checkpoint& checkpoint, const Vector<UChar, 32>& appropriateEndTagName)
+        : HTMLParserThread::Task(parser)
+        , m_parser(parser)
+        , m_generation(generation)
+        , m_sourceIsComplete(sourceIsComplete)
+        , m_offset(offset)
+        , m_position(position)
+        , m_checkpoint(checkpoint)
+        , m_appropriateEndTagName(appropriateEndTagName)
+    {
+        m_source.reserveInitialCapacity(source.size());
+        for (size_t i = 0; i < source.size(); ++i)
+            m_source.append(source[i].crossThreadString());
+    }
+
+    virtual void performTask()
+    {
+        m_parser->restartOnParserThread(m_generation, m_source, m_sourceIsComplete, m_offset, m_position, m_checkpoint, m_appropriateEndTagName);
+    }
+
+private:
+    RefPtr<BackgroundHTMLParser> m_parser;
+    unsigned m_generation;
+    Vector<String> m_source;
+    bool m_sourceIsComplete;
+    int m_offset;
+    TextPosition0 m_position;
+    HTMLTokenizer::Checkpoint m_checkpoint;
+    Vector<UChar, 32> m_appropriateEndTagName;
+};
+
+BackgroundHTMLParser::BackgroundHTMLParser(HTMLDocumentParser* client, bool usePreHTML5ParserQuirks, bool scriptEnabled, bool pluginsEnabled)
+    : m_client(client)
+    , m_inputOffset(0)
+    , m_tokenizer(HTMLTokenizer::create(usePreHTML5ParserQuirks))
+    , m_cssScanner(0)
+    , m_generation(0)
+    , m_inTextMode(false)
+    , m_forceNullCharacterReplacementOutsideTextMode(false)
+    , m_inStyle(false)
+    , m_bodySeen(false)
+    , m_scriptEnabled(scriptEnabled)
+    , m_pluginsEnabled(pluginsEnabled)
+{
+    ASSERT(isMainThread());
+}
+
+void BackgroundHTMLParser::append(const String& source)
+{
+    ASSERT(isMainThread());
+    HTMLParserThread::shared()->postTask(adoptPtr(new AppendTask(this, source)));
+}
+
+void BackgroundHTMLParser::finish()
+{
+    ASSERT(isMainThread());
+    HTMLParserThread::shared()->postTask(adoptPtr(new FinishTask(this)));
+}
+
+void BackgroundHTMLParser::restart(unsigned generation, const Vector<String>& source, bool sourceIsComplete, int offset, const TextPosition0& position, const HTMLTokenizer::Checkpoint& checkpoint, const Vector<UChar, 32>& appropriateEndTagName)
+{
+    ASSERT(isMainThread());
+    HTMLParserThread::shared()->postTask(adoptPtr(new RestartTask(this, generation, source, sourceIsComplete, offset, position, checkpoint, appropriateEndTagName)));
+}
+
+void BackgroundHTMLParser::stop()
+{
+    ASSERT(isMainThread());
+    m_client = 0;
+    // A task that is already running still finishes, but the chunks it sends
+    // are dropped in didParseChunk().
+    HTMLParserThread::shared()->unscheduleTasks(this);
+}
+
+void BackgroundHTMLParser::appendOnParserThread(const String& source)
+{
+    m_input.append(SegmentedString(source));
+    pumpTokenizer();
+}
+
+void BackgroundHTMLParser::finishOnParserThread()
+{
+    // Matches HTMLInputStream::markEndOfFile().
+    static const UChar endOfFileMarker = 0;
+    m_input.append(SegmentedString(String(&endOfFileMarker, 1)));
+    m_input.close();
+    pumpTokenizer();
+}
+
+void BackgroundHTMLParser::restartOnParserThread(unsigned generation, const Vector<String>& source, bool sourceIsComplete, int offset, const TextPosition0& position, const HTMLTokenizer::Checkpoint& checkpoint, const Vector<UChar, 32>& appropriateEndTagName)
+{
+    ASSERT(generation > m_generation);
+    m_generation = generation;
+    m_chunk.clear();
+
+    m_input = SegmentedString();
+    for (size_t i = 0; i < source.size(); ++i)
+        m_input.append(SegmentedString(source[i]));
+    m_input.setCurrentPosition(position.m_line, position.m_column, 0);
+    m_inputOffset = offset - m_input.numberOfCharactersConsumed();
+
+    m_token.clear();
+    m_tokenizer->reset();
+    m_tokenizer->restoreFromCheckpoint(checkpoint);
+    m_tokenizer->setLineNumber(position.m_line.zeroBasedInt());
+    m_tokenizer->setAppropriateEndTagName(appropriateEndTagName.data(), appropriateEndTagName.size());
+
+    m_inTextMode = isTextModeState(checkpoint.state);
+    m_forceNullCharacterReplacementOutsideTextMode = m_inTextMode ? false : checkpoint.forceNullCharacterReplacement;
+    m_inStyle = false;
+    m_cssScanner.reset();
+
+    if (sourceIsComplete)
+        finishOnParserThread();
+    else
+        pumpTokenizer();
+}
+
+void BackgroundHTMLParser::pumpTokenizer()
+{
+    while (m_tokenizer->nextToken(m_input, m_token)) {
+        appendToken();
+        // The chunk must not share any Strings with this thread once it has
+        // been sent, so we only send it after appendToken() has returned.
+        if (m_chunk && m_chunk->tokens.size() >= maximumTokensPerChunk)
+            sendChunk();
+    }
+    sendChunk();
+}
+
+void BackgroundHTMLParser::appendToken()
+{
+    TextPosition0 endPosition(m_input.currentLine(), m_input.currentColumn());
+    CompactHTMLToken token(m_token, endPosition, m_inputOffset + m_input.numberOfCharactersConsumed());
+    token.setStateAfterEmission(m_tokenizer->state());
+
+    if (m_inStyle && m_token.type() == HTMLToken::Character)
+        m_cssScanner.scan(m_token, m_bodySeen);
+    m_token.clear();
+
+    if (token.type() == HTMLToken::StartTag && !m_bodySeen && threadSafeMatch(token.data(), bodyTag)) {
+        // Everything before <body> is preloaded as part of the head.
+        sendChunk();
+        m_bodySeen = true;
+    }
+
+    if (!m_chunk)
+        m_chunk = adoptPtr(new ParsedChunk(m_generation, m_bodySeen));
+
+    simulateTreeBuilder(token);
+
+    HTMLTokenizer::Checkpoint checkpoint;
+    m_tokenizer->createCheckpoint(checkpoint);
+    token.setExpectedCheckpoint(checkpoint, m_tokenizer->canCreateCheckpoint());
+    m_chunk->tokens.append(token);
+}
+
+// This mirrors the places where HTMLTreeBuilder changes the tokenizer's state
+// (see also HTMLTokenizer::updateStateFor). Where the approximation is wrong,
+// for example for <title> inside <svg>, HTMLDocumentParser notices and
+// restarts us.
+void BackgroundHTMLParser::simulateTreeBuilder(const CompactHTMLToken& token)
+{
+    if (token.type() == HTMLToken::EndTag) {
+        // In text mode the tokenizer only emits the end tag that leaves it.
+        if (m_inTextMode) {
+            m_inTextMode = false;
+            m_tokenizer->setForceNullCharacterReplacement(m_forceNullCharacterReplacementOutsideTextMode);
+        }
+        if (m_inStyle) {
+            m_inStyle = false;
+            m_cssScanner.takeStyleSheetImports(m_chunk->styleSheetImports);
+            m_cssScanner.reset();
+        }
+        return;
+    }
+
+    if (token.type() != HTMLToken::StartTag)
+        return;
+
+    const String& tagName = token.data();
+    HTMLTokenizer::State state = HTMLTokenizer::DataState;
+    if (threadSafeMatch(tagName, titleTag) || threadSafeMatch(tagName, textareaTag))
+        state = HTMLTokenizer::RCDATAState;
+    else if (threadSafeMatch(tagName, scriptTag))
+        state = HTMLTokenizer::ScriptDataState;
+    else if (threadSafeMatch(tagName, styleTag)
+        || threadSafeMatch(tagName, xmpTag)
+        || threadSafeMatch(tagName, iframeTag)
+        || (threadSafeMatch(tagName, noembedTag) && m_pluginsEnabled)
+        || threadSafeMatch(tagName, noframesTag)
+        || (threadSafeMatch(tagName, noscriptTag) && m_scriptEnabled))
+        state = HTMLTokenizer::RAWTEXTState;
+    else if (threadSafeMatch(tagName, plaintextTag))
+        m_tokenizer->setState(HTMLTokenizer::PLAINTEXTState);
+
+    if (isTextModeState(state)) {
+        m_tokenizer->setState(state);
+        m_inTextMode = true;
+        m_forceNullCharacterReplacementOutsideTextMode = m_tokenizer->forceNullCharacterReplacement();
+        m_tokenizer->setForceNullCharacterReplacement(true);
+    }
+
+    if (threadSafeMatch(tagName, preTag) || threadSafeMatch(tagName, listingTag) || threadSafeMatch(tagName, textareaTag))
+        m_tokenizer->setSkipLeadingNewLineForListing(true);
+
+    if (threadSafeMatch(tagName, styleTag))
+        m_inStyle = true;
+    else if (threadSafeMatch(tagName, imgTag)
+        || threadSafeMatch(tagName, inputTag)
+        || threadSafeMatch(tagName, linkTag)
+        || threadSafeMatch(tagName, scriptTag))
+        m_chunk->preloadCandidates.append(m_chunk->tokens.size());
+}
+
+void BackgroundHTMLParser::sendChunk()
+{
+    if (m_inStyle && m_chunk)
+        m_cssScanner.takeStyleSheetImports(m_chunk->styleSheetImports);
+    if (!m_chunk || (m_chunk->tokens.isEmpty() && m_chunk->styleSheetImports.isEmpty()))
+        return;
+    callOnMainThread(didParseChunk, new ChunkDelivery(this, m_chunk.release()));
+}
+
+void BackgroundHTMLParser::didParseChunk(void* context)
+{
+    ASSERT(isMainThread());
+    OwnPtr<ChunkDelivery> delivery = adoptPtr(static_cast<ChunkDelivery*>(context));
+    if (HTMLDocumentParser* client = delivery->parser->m_client)
+        client->didReceiveParsedChunk(delivery->chunk.release());
+}
+
+} // namespace WebCore
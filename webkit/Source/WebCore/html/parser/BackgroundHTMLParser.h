@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2011 Google, Inc. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BackgroundHTMLParser_h
+#define BackgroundHTMLParser_h
+
+#include "CSSPreloadScanner.h"
+#include "CompactHTMLToken.h"
+#include "HTMLToken.h"
+#include "HTMLTokenizer.h"
+#include "SegmentedString.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class HTMLDocumentParser;
+
+// Tokenizes the HTML an HTMLDocumentParser receives from the network on the
+// HTMLParserThread and sends the tokens back to the main thread in batches
+// (ParsedChunks), so that the main thread only has to build the tree.
+//
+// Tokenization depends on the tree builder, which changes the tokenizer's
+// state after some tags. The BackgroundHTMLParser approximates those changes
+// and records its expectation with every token. HTMLDocumentParser compares
+// the expectation with what the real tree builder did and calls restart()
+// when they disagree; the tokens after the disagreement are then thrown away
+// and produced again from the correct state.
+class BackgroundHTMLParser : public ThreadSafeRefCounted<BackgroundHTMLParser> {
+public:
+    static PassRefPtr<BackgroundHTMLParser> create(HTMLDocumentParser* client, bool usePreHTML5ParserQuirks, bool scriptEnabled, bool pluginsEnabled)
+    {
+        return adoptRef(new BackgroundHTMLParser(client, usePreHTML5ParserQuirks, scriptEnabled, pluginsEnabled));
+    }
+
+    struct ParsedChunk {
+        WTF_MAKE_NONCOPYABLE(ParsedChunk); WTF_MAKE_FAST_ALLOCATED;
+    public:
+        ParsedChunk(unsigned generation, bool bodySeen)
+            : generation(generation)
+            , bodySeen(bodySeen)
+        {
+        }
+
+        unsigned generation;
+        Vector<CompactHTMLToken> tokens;
+        // Indices into tokens of the start tags HTMLPreloadScanner::preload()
+        // might want to load something for.
+        Vector<size_t> preloadCandidates;
+        // Style sheets @imported from <style> elements.
+        Vector<String> styleSheetImports;
+        bool bodySeen;
+    };
+
+    // These are called on the main thread.
+    void append(const String&);
+    void finish();
+    void restart(unsigned generation, const Vector<String>& source, bool sourceIsComplete, int offset, const TextPosition0&, const HTMLTokenizer::Checkpoint&, const Vector<UChar, 32>& appropriateEndTagName);
+    void stop();
+
+private:
+    BackgroundHTMLParser(HTMLDocumentParser*, bool usePreHTML5ParserQuirks, bool scriptEnabled, bool pluginsEnabled);
+
+    class AppendTask;
+    class FinishTask;
+    class RestartTask;
+
+    // These are called on the parser thread.
+    void appendOnParserThread(const String&);
+    void finishOnParserThread();
+    void restartOnParserThread(unsigned generation, const Vector<String>& source, bool sourceIsComplete, int offset, const TextPosition0&, const HTMLTokenizer::Checkpoint&, const Vector<UChar, 32>& appropriateEndTagName);
+
+    void pumpTokenizer();
+    void appendToken();
+    void simulateTreeBuilder(const CompactHTMLToken&);
+    void sendChunk();
+
+    static void didParseChunk(void* context);
+
+    // Only touched on the main thread.
+    HTMLDocumentParser* m_client;
+
+    // Only touched on the parser thread.
+    SegmentedString m_input;
+    int m_inputOffset;
+    OwnPtr<HTMLTokenizer> m_tokenizer;
+    HTMLToken m_token;
+    CSSPreloadScanner m_cssScanner;
+    OwnPtr<ParsedChunk> m_chunk;
+    unsigned m_generation;
+    bool m_inTextMode;
+    bool m_forceNullCharacterReplacementOutsideTextMode;
+    bool m_inStyle;
+    bool m_bodySeen;
+
+    // Copied from the Frame on the main thread.
+    bool m_scriptEnabled;
+    bool m_pluginsEnabled;
+};
+
+} // namespace WebCore
+
+#endif // BackgroundHTMLParser_h
@@ -38,11 +38,15 @@ class HTMLToken;
 class CSSPreloadScanner {
     WTF_MAKE_NONCOPYABLE(CSSPreloadScanner);
 public:
+    // Without a Document, the scanner only collects the URLs of the style
+    // sheets it finds; see takeStyleSheetImports().
     CSSPreloadScanner(Document*);
 
     void reset();
     void scan(const HTMLToken&, bool scanningBody);
 
+    void takeStyleSheetImports(Vector<String>&);
+
 private:
     enum State {
         Initial,
@@ -66,6 +70,7 @@ private:
 
     bool m_scanningBody;
     Document* m_document;
+    Vector<String> m_styleSheetImports;
 };
 
 }
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2011 Google, Inc. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "CompactHTMLToken.h"
+
+namespace WebCore {
+
+CompactHTMLToken::CompactHTMLToken(const HTMLToken& token, const TextPosition0& endPosition, int endOffset)
+    : m_type(token.type())
+    , m_stateAfterEmission(HTMLTokenizer::DataState)
+    , m_selfClosing(false)
+    , m_hasPublicIdentifier(false)
+    , m_hasSystemIdentifier(false)
+    , m_forceQuirks(false)
+    , m_isCheckpoint(false)
+    , m_endPosition(endPosition)
+    , m_endOffset(endOffset)
+{
+    switch (token.type()) {
+    case HTMLToken::Uninitialized:
+        ASSERT_NOT_REACHED();
+        break;
+    case HTMLToken::DOCTYPE:
+        m_data = String(token.name().data(), token.name().size());
+        m_forceQuirks = token.forceQuirks();
+        m_hasPublicIdentifier = token.m_doctypeData->m_hasPublicIdentifier;
+        m_hasSystemIdentifier = token.m_doctypeData->m_hasSystemIdentifier;
+        m_publicIdentifier = String(token.publicIdentifier().data(), token.publicIdentifier().size());
+        m_systemIdentifier = String(token.systemIdentifier().data(), token.systemIdentifier().size());
+        break;
+    case HTMLToken::EndOfFile:
+        break;
+    case HTMLToken::StartTag:
+    case HTMLToken::EndTag: {
+        m_selfClosing = token.selfClosing();
+        m_data = String(token.name().data(), token.name().size());
+        const HTMLToken::AttributeList& attributes = token.attributes();
+        m_attributes.reserveInitialCapacity(attributes.size());
+        for (HTMLToken::AttributeList::const_iterator it = attributes.begin(); it != attributes.end(); ++it) {
+            // Same as AtomicHTMLToken::initializeAttributes().
+            if (it->m_name.isEmpty())
+                continue;
+            m_attributes.append(Attribute(String(it->m_name.data(), it->m_name.size()), String(it->m_value.data(), it->m_value.size())));
+        }
+        break;
+    }
+    case HTMLToken::Comment:
+        m_data = String(token.comment().data(), token.comment().size());
+        break;
+    case HTMLToken::Character:
+        m_data = String(token.characters().data(), token.characters().size());
+        break;
+    }
+}
+
+AtomicHTMLToken::AtomicHTMLToken(const CompactHTMLToken& token)
+    : m_type(token.type())
+    , m_externalCharacters(0)
+    , m_externalCharactersLength(0)
+{
+    switch (m_type) {
+    case HTMLToken::Uninitialized:
+        ASSERT_NOT_REACHED();
+        break;
+    case HTMLToken::DOCTYPE:
+        m_name = token.data();
+        m_doctypeData = adoptPtr(new HTMLToken::DoctypeData());
+        m_doctypeData->m_hasPublicIdentifier = token.hasPublicIdentifier();
+        m_doctypeData->m_hasSystemIdentifier = token.hasSystemIdentifier();
+        m_doctypeData->m_forceQuirks = token.forceQuirks();
+        m_doctypeData->m_publicIdentifier.append(token.publicIdentifier().characters(), token.publicIdentifier().length());
+        m_doctypeData->m_systemIdentifier.append(token.systemIdentifier().characters(), token.systemIdentifier().length());
+        break;
+    case HTMLToken::EndOfFile:
+        break;
+    case HTMLToken::StartTag:
+    case HTMLToken::EndTag: {
+        m_selfClosing = token.selfClosing();
+        m_name = token.data();
+        const Vector<CompactHTMLToken::Attribute>& attributes = token.attributes();
+        if (attributes.isEmpty())
+            break;
+        m_attributes = NamedNodeMap::create();
+        m_attributes->reserveInitialCapacity(attributes.size());
+        for (size_t i = 0; i < attributes.size(); ++i)
+            m_attributes->insertAttribute(Attribute::createMapped(attributes[i].name, attributes[i].value), false);
+        break;
+    }
+    case HTMLToken::Comment:
+        m_data = token.data();
+        break;
+    case HTMLToken::Character:
+        m_externalCharacters = token.data().characters();
+        m_externalCharactersLength = token.data().length();
+        break;
+    }
+}
+
+}
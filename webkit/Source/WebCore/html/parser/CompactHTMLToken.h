@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2011 Google, Inc. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CompactHTMLToken_h
+#define CompactHTMLToken_h
+
+#include "HTMLToken.h"
+#include "HTMLTokenizer.h"
+#include "PlatformString.h"
+#include <wtf/Vector.h>
+#include <wtf/text/TextPosition.h>
+
+namespace WebCore {
+
+// A CompactHTMLToken is an HTMLToken with its character data moved into
+// Strings, so that it can be queued cheaply and handed from the parser
+// thread to the main thread. It also records where the tokenizer stood after
+// emitting the token, which HTMLDocumentParser uses to check that the
+// BackgroundHTMLParser tokenized the input the way the tree builder wanted.
+//
+// The Strings in a CompactHTMLToken are not shared with anything else, so
+// the token may be handed to another thread as long as the sending thread
+// lets go of it.
+class CompactHTMLToken {
+public:
+    struct Attribute {
+        Attribute(const String& name, const String& value)
+            : name(name)
+            , value(value)
+        {
+        }
+
+        String name;
+        String value;
+    };
+
+    CompactHTMLToken(const HTMLToken&, const TextPosition0& endPosition, int endOffset);
+
+    HTMLToken::Type type() const { return static_cast<HTMLToken::Type>(m_type); }
+
+    // "name" for DOCTYPE, StartTag, and EndTag
+    // "characters" for Character
+    // "data" for Comment
+    const String& data() const { return m_data; }
+
+    bool selfClosing() const { return m_selfClosing; }
+    const Vector<Attribute>& attributes() const { return m_attributes; }
+
+    // For DOCTYPE
+    bool hasPublicIdentifier() const { return m_hasPublicIdentifier; }
+    bool hasSystemIdentifier() const { return m_hasSystemIdentifier; }
+    const String& publicIdentifier() const { return m_publicIdentifier; }
+    const String& systemIdentifier() const { return m_systemIdentifier; }
+    bool forceQuirks() const { return m_forceQuirks; }
+
+    // Where the input stood right after the token was emitted, counted from
+    // the start of the data received from the network.
+    const TextPosition0& endPosition() const { return m_endPosition; }
+    int endOffset() const { return m_endOffset; }
+
+    // The tokenizer state right after emitting the token, and the state the
+    // BackgroundHTMLParser expects the tree builder to leave the tokenizer in
+    // after processing it. Tokenization of the input following the token is
+    // only valid if the expectation holds.
+    HTMLTokenizer::State stateAfterEmission() const { return static_cast<HTMLTokenizer::State>(m_stateAfterEmission); }
+    const HTMLTokenizer::Checkpoint& expectedCheckpoint() const { return m_expectedCheckpoint; }
+    bool isCheckpoint() const { return m_isCheckpoint; }
+
+    void setStateAfterEmission(HTMLTokenizer::State state) { m_stateAfterEmission = state; }
+    void setExpectedCheckpoint(const HTMLTokenizer::Checkpoint& checkpoint, bool isCheckpoint)
+    {
+        m_expectedCheckpoint = checkpoint;
+        m_isCheckpoint = isCheckpoint;
+    }
+
+private:
+    unsigned m_type : 4;
+    unsigned m_stateAfterEmission : 7;
+    bool m_selfClosing : 1;
+    bool m_hasPublicIdentifier : 1;
+    bool m_hasSystemIdentifier : 1;
+    bool m_forceQuirks : 1;
+    bool m_isCheckpoint : 1;
+
+    String m_data;
+    Vector<Attribute> m_attributes;
+
+    String m_publicIdentifier;
+    String m_systemIdentifier;
+
+    TextPosition0 m_endPosition;
+    int m_endOffset;
+    HTMLTokenizer::Checkpoint m_expectedCheckpoint;
+};
+
+}
+
+#endif
@@ -26,6 +26,8 @@
 #include "config.h"
 #include "HTMLDocumentParser.h"
 
+#include "CachedResourceLoader.h"
+#include "CompactHTMLToken.h"
 #include "ContentSecurityPolicy.h"
 #include "DocumentFragment.h"
 #include "Element.h"
@@ -87,6 +89,14 @@ HTMLDocumentParser::HTMLDocumentParser(HTMLDocument* document, bool reportErrors
     , m_xssFilter(this)
     , m_endWasDelayed(false)
     , m_pumpSessionNestingLevel(0)
+    , m_backgroundParserGeneration(0)
+    , m_haveCheckedForBackgroundParser(false)
+    , m_backgroundParserWasFinished(false)
+    , m_nextTokenIndex(0)
+    , m_backgroundSourceOffset(0)
+    , m_lastTokenEndOffset(0)
+    , m_lastTokenEndPosition(TextPosition0::minimumPosition())
+    , m_lastTokenWasCheckpoint(true)
 {
 }
 
@@ -99,6 +109,14 @@ HTMLDocumentParser::HTMLDocumentParser(DocumentFragment* fragment, Element* cont
     , m_xssFilter(this)
     , m_endWasDelayed(false)
     , m_pumpSessionNestingLevel(0)
+    , m_backgroundParserGeneration(0)
+    , m_haveCheckedForBackgroundParser(true)
+    , m_backgroundParserWasFinished(false)
+    , m_nextTokenIndex(0)
+    , m_backgroundSourceOffset(0)
+    , m_lastTokenEndOffset(0)
+    , m_lastTokenEndPosition(TextPosition0::minimumPosition())
+    , m_lastTokenWasCheckpoint(true)
 {
     bool reportErrors = false; // For now document fragment parsing never reports errors.
     m_tokenizer->setState(tokenizerStateForContextElement(contextElement, reportErrors));
@@ -109,6 +127,7 @@ HTMLDocumentParser::~HTMLDocumentParser()
     ASSERT(!m_parserScheduler);
     ASSERT(!m_pumpSessionNestingLevel);
     ASSERT(!m_preloadScanner);
+    ASSERT(!m_backgroundParser);
 }
 
 void HTMLDocumentParser::detach()
@@ -117,6 +136,7 @@ void HTMLDocumentParser::detach()
     if (m_scriptRunner)
         m_scriptRunner->detach();
     m_treeBuilder->detach();
+    stopBackgroundParser();
     // FIXME: It seems wrong that we would have a preload scanner here.
     // Yet during fast/dom/HTMLScriptElement/script-load-events.html we do.
     m_preloadScanner.clear();
@@ -127,6 +147,7 @@ void HTMLDocumentParser::stopParsing()
 {
     DocumentParser::stopParsing();
     m_parserScheduler.clear(); // Deleting the scheduler will clear any timers.
+    stopBackgroundParser();
 }
 
 // This kicks off "Once the user agent stops parsing" as described by:
@@ -162,7 +183,7 @@ bool HTMLDocumentParser::isParsingFragment() const
 
 bool HTMLDocumentParser::processingData() const
 {
-    return isScheduledForResume() || inPumpSession();
+    return isScheduledForResume() || inPumpSession() || m_backgroundParser;
 }
 
 void HTMLDocumentParser::pumpTokenizerIfPossible(SynchronousMode mode)
@@ -263,11 +284,26 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willWriteHTML(document(), m_input.current().length(), m_tokenizer->lineNumber());
 
     while (canTakeNextToken(mode, session) && !session.needsYield) {
+        if (m_backgroundParser && m_input.current().isEmpty() && !m_input.hasInsertionPoint()) {
+            if (!constructTreeFromBackgroundToken())
+                break;
+            continue;
+        }
+
         if (!isParsingFragment())
             m_sourceTracker.start(m_input, m_token);
 
-        if (!m_tokenizer->nextToken(m_input.current(), m_token))
+        if (!m_tokenizer->nextToken(m_input.current(), m_token)) {
+            // Once what document.write() inserted has been tokenized, we go
+            // back to the tokens from the background parser, unless the
+            // inserted input can't be tokenized without the input after it.
+            if (m_backgroundParser && !m_input.hasInsertionPoint()) {
+                if (!m_input.current().isEmpty())
+                    tokenizeRemainingInputOnMainThread();
+                continue;
+            }
             break;
+        }
 
         if (!isParsingFragment()) {
             m_sourceTracker.end(m_input, m_token);
@@ -291,7 +327,8 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     if (session.needsYield)
         m_parserScheduler->scheduleForResume();
 
-    if (isWaitingForScripts()) {
+    // The background parser runs its own preload scanner.
+    if (isWaitingForScripts() && !m_backgroundParser) {
         ASSERT(m_tokenizer->state() == HTMLTokenizer::DataState);
         if (!m_preloadScanner) {
             m_preloadScanner.set(new HTMLPreloadScanner(document()));
@@ -303,6 +340,182 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     InspectorInstrumentation::didWriteHTML(cookie, m_tokenizer->lineNumber());
 }
 
+bool HTMLDocumentParser::shouldUseBackgroundParser()
+{
+    ASSERT(!isParsingFragment());
+    if (wasCreatedByScript() || !m_input.current().isEmpty())
+        return false;
+    Frame* frame = document()->frame();
+    if (!frame || !frame->settings() || !frame->settings()->threadedHTMLParserEnabled())
+        return false;
+    // The XSSFilter needs the source of every token, which only the
+    // tokenizer reading m_input can tell it.
+    return !m_xssFilter.isEnabled();
+}
+
+void HTMLDocumentParser::startBackgroundParser()
+{
+    ASSERT(!m_backgroundParser);
+    Frame* frame = document()->frame();
+    m_backgroundParser = BackgroundHTMLParser::create(this, usePreHTML5ParserQuirks(document()), HTMLTreeBuilder::scriptEnabled(frame), HTMLTreeBuilder::pluginsEnabled(frame));
+    m_tokenizer->createCheckpoint(m_expectedCheckpoint);
+}
+
+void HTMLDocumentParser::stopBackgroundParser()
+{
+    if (!m_backgroundParser)
+        return;
+    m_backgroundParser->stop();
+    m_backgroundParser = 0;
+    m_parsedChunks.clear();
+    m_nextTokenIndex = 0;
+    m_backgroundSource.clear();
+}
+
+void HTMLDocumentParser::didReceiveParsedChunk(PassOwnPtr<BackgroundHTMLParser::ParsedChunk> passedChunk)
+{
+    OwnPtr<BackgroundHTMLParser::ParsedChunk> chunk = passedChunk;
+    if (isStopped() || chunk->generation != m_backgroundParserGeneration)
+        return;
+
+    // pumpTokenizer can cause this parser to be detached from the Document,
+    // but we need to ensure it isn't deleted yet.
+    RefPtr<HTMLDocumentParser> protect(this);
+
+    // Getting the loads started early is the point of scanning on the
+    // parser thread, so we do it even if the tree builder is paused.
+    for (size_t i = 0; i < chunk->preloadCandidates.size(); ++i)
+        HTMLPreloadScanner::preload(document(), chunk->tokens[chunk->preloadCandidates[i]], chunk->bodySeen);
+    bool scanningBody = document()->body() || chunk->bodySeen;
+    for (size_t i = 0; i < chunk->styleSheetImports.size(); ++i)
+        document()->cachedResourceLoader()->preload(CachedResource::CSSStyleSheet, chunk->styleSheetImports[i], String(), scanningBody);
+
+    m_parsedChunks.append(chunk.release());
+
+    // As in append(), we don't consume input in a nested write.
+    if (inPumpSession())
+        return;
+
+    pumpTokenizerIfPossible(AllowYield);
+    if (m_backgroundParser)
+        discardConsumedBackgroundSource(KeepPartiallyConsumedSource);
+    endIfDelayed();
+}
+
+// Returns false if there's no token to process until the background parser
+// sends more.
+bool HTMLDocumentParser::constructTreeFromBackgroundToken()
+{
+    ASSERT(m_backgroundParser);
+    ASSERT(m_input.current().isEmpty());
+
+    if (!m_token.isUninitialized() || !m_tokenizer->canCreateCheckpoint()) {
+        // document.write() left a token half done. Where it ends depends on
+        // input the background parser tokenized without knowing about it.
+        tokenizeRemainingInputOnMainThread();
+        return true;
+    }
+
+    HTMLTokenizer::Checkpoint checkpoint;
+    m_tokenizer->createCheckpoint(checkpoint);
+    if (checkpoint != m_expectedCheckpoint) {
+        // The tree builder (or document.write) put the tokenizer in a state
+        // the background parser didn't predict, so the tokens it sent after
+        // the last one we processed are wrong.
+        restartBackgroundParser(checkpoint);
+        return false;
+    }
+
+    while (!m_parsedChunks.isEmpty() && m_nextTokenIndex == m_parsedChunks.first()->tokens.size()) {
+        m_parsedChunks.remove(0);
+        m_nextTokenIndex = 0;
+    }
+    if (m_parsedChunks.isEmpty())
+        return false;
+
+    // We don't remove the chunk until the next call, so the token stays alive
+    // while the tree builder uses it.
+    const CompactHTMLToken& token = m_parsedChunks.first()->tokens[m_nextTokenIndex++];
+
+    if (token.type() == HTMLToken::EndOfFile) {
+        // Let the main-thread tokenizer emit the end of file, so that we end
+        // up in the same state as without a background parser.
+        ASSERT(m_backgroundParserWasFinished);
+        stopBackgroundParser();
+        m_input.current().setCurrentPosition(m_lastTokenEndPosition.m_line, m_lastTokenEndPosition.m_column, 0);
+        m_input.markEndOfFile();
+        return true;
+    }
+
+    // Bring m_tokenizer to where it would be had it emitted the token itself.
+    checkpoint.state = token.stateAfterEmission();
+    checkpoint.skipLeadingNewLineForListing = false;
+    m_tokenizer->restoreFromCheckpoint(checkpoint);
+    m_tokenizer->setLineNumber(token.endPosition().m_line.zeroBasedInt());
+    if (token.type() == HTMLToken::StartTag)
+        m_tokenizer->setAppropriateEndTagName(token.data().characters(), token.data().length());
+
+    m_lastTokenEndOffset = token.endOffset();
+    m_lastTokenEndPosition = token.endPosition();
+    m_expectedCheckpoint = token.expectedCheckpoint();
+    m_lastTokenWasCheckpoint = token.isCheckpoint();
+
+    AtomicHTMLToken atomicToken(token);
+    m_treeBuilder->constructTreeFromAtomicToken(atomicToken);
+    return true;
+}
+
+void HTMLDocumentParser::restartBackgroundParser(const HTMLTokenizer::Checkpoint& checkpoint)
+{
+    // The tree builder only changes the tokenizer's state after tags, which
+    // the tokenizer always emits at a checkpoint.
+    ASSERT(m_lastTokenWasCheckpoint);
+
+    discardConsumedBackgroundSource(TrimPartiallyConsumedSource);
+
+    m_parsedChunks.clear();
+    m_nextTokenIndex = 0;
+    m_expectedCheckpoint = checkpoint;
+    m_backgroundParser->restart(++m_backgroundParserGeneration, m_backgroundSource, m_backgroundParserWasFinished, m_lastTokenEndOffset, m_lastTokenEndPosition, checkpoint, m_tokenizer->appropriateEndTagName());
+}
+
+void HTMLDocumentParser::tokenizeRemainingInputOnMainThread()
+{
+    ASSERT(m_backgroundParser);
+    ASSERT(!m_input.hasInsertionPoint());
+    ASSERT(m_lastTokenWasCheckpoint);
+
+    discardConsumedBackgroundSource(TrimPartiallyConsumedSource);
+    Vector<String> source;
+    source.swap(m_backgroundSource);
+    bool wasFinished = m_backgroundParserWasFinished;
+    stopBackgroundParser();
+
+    // m_input's line and column have not moved while the background parser
+    // was tokenizing, so we bring them up to date before appending.
+    m_input.current().setCurrentPosition(m_lastTokenEndPosition.m_line, m_lastTokenEndPosition.m_column, m_input.current().length());
+    for (size_t i = 0; i < source.size(); ++i)
+        m_input.appendToEnd(SegmentedString(source[i]));
+    if (wasFinished)
+        m_input.markEndOfFile();
+}
+
+void HTMLDocumentParser::discardConsumedBackgroundSource(BackgroundSourceTrimming trimming)
+{
+    while (!m_backgroundSource.isEmpty()) {
+        int length = m_backgroundSource.first().length();
+        if (m_backgroundSourceOffset + length > m_lastTokenEndOffset)
+            break;
+        m_backgroundSourceOffset += length;
+        m_backgroundSource.remove(0);
+    }
+
+    if (trimming == TrimPartiallyConsumedSource && !m_backgroundSource.isEmpty()) {
+        m_backgroundSource.first() = m_backgroundSource.first().substring(m_lastTokenEndOffset - m_backgroundSourceOffset);
+        m_backgroundSourceOffset = m_lastTokenEndOffset;
+    }
+}
+
 bool HTMLDocumentParser::hasInsertionPoint()
 {
     // FIXME: The wasCreatedByScript() branch here might not be fully correct.
@@ -351,6 +564,23 @@ void HTMLDocumentParser::append(const SegmentedString& source)
     // but we need to ensure it isn't deleted yet.
     RefPtr<HTMLDocumentParser> protect(this);
 
+    if (!m_haveCheckedForBackgroundParser) {
+        m_haveCheckedForBackgroundParser = true;
+        if (shouldUseBackgroundParser())
+            startBackgroundParser();
+    }
+
+    if (m_backgroundParser) {
+        String sourceString = source.toString();
+        m_backgroundSource.append(sourceString);
+        m_backgroundParser->append(sourceString);
+        // The tokens come back in didReceiveParsedChunk().
+#ifdef ANDROID_INSTRUMENT
+        android::TimeCounter::record(android::TimeCounter::ParsingTimeCounter, __FUNCTION__);
+#endif
+        return;
+    }
+
     if (m_preloadScanner) {
         if (m_input.current().isEmpty() && !isWaitingForScripts()) {
             // We have parsed until the end of the current input and so are now moving ahead of the preload scanner.
@@ -436,14 +666,21 @@ void HTMLDocumentParser::finish()
     // We're not going to get any more data off the network, so we tell the
     // input stream we've reached the end of file.  finish() can be called more
     // than once, if the first time does not call end().
-    if (!m_input.haveSeenEndOfFile())
+    if (m_backgroundParser) {
+        // We mark the end of m_input once the background parser has
+        // tokenized everything before it.
+        if (!m_backgroundParserWasFinished) {
+            m_backgroundParserWasFinished = true;
+            m_backgroundParser->finish();
+        }
+    } else if (!m_input.haveSeenEndOfFile())
         m_input.markEndOfFile();
     attemptToEnd();
 }
 
 bool HTMLDocumentParser::finishWasCalled()
 {
-    return m_input.haveSeenEndOfFile();
+    return m_input.haveSeenEndOfFile() || m_backgroundParserWasFinished;
 }
 
 // This function is virtual and just for the DocumentParser interface.
@@ -472,6 +709,11 @@ int HTMLDocumentParser::lineNumber() const
 
 TextPosition0 HTMLDocumentParser::textPosition() const
 {
+    // m_input does not see the network input while the background parser
+    // tokenizes it.
+    if (m_backgroundParser)
+        return m_lastTokenEndPosition;
+
     const SegmentedString& currentString = m_input.current();
     WTF::ZeroBasedNumber line = currentString.currentLine();
     WTF::ZeroBasedNumber column = currentString.currentColumn();
@@ -26,17 +26,22 @@
 #ifndef HTMLDocumentParser_h
 #define HTMLDocumentParser_h
 
+#include "BackgroundHTMLParser.h"
 #include "CachedResourceClient.h"
 #include "FragmentScriptingPermission.h"
 #include "HTMLInputStream.h"
 #include "HTMLScriptRunnerHost.h"
 #include "HTMLSourceTracker.h"
 #include "HTMLToken.h"
+#include "HTMLTokenizer.h"
 #include "ScriptableDocumentParser.h"
 #include "SegmentedString.h"
 #include "Timer.h"
 #include "XSSFilter.h"
 #include <wtf/OwnPtr.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+#include <wtf/text/TextPosition.h>
 
 namespace WebCore {
 
@@ -44,7 +49,6 @@ class Document;
 class DocumentFragment;
 class HTMLDocument;
 class HTMLParserScheduler;
-class HTMLTokenizer;
 class HTMLScriptRunner;
 class HTMLTreeBuilder;
 class HTMLPreloadScanner;
@@ -70,6 +74,9 @@ public:
     // Exposed for HTMLParserScheduler
     void resumeParsingAfterYield();
 
+    // Exposed for BackgroundHTMLParser
+    void didReceiveParsedChunk(PassOwnPtr<BackgroundHTMLParser::ParsedChunk>);
+
     static void parseDocumentFragment(const String&, DocumentFragment*, Element* contextElement, FragmentScriptingPermission = FragmentScriptingAllowed);
     
     static bool usePreHTML5ParserQuirks(Document*);
@@ -123,6 +130,18 @@ private:
     void pumpTokenizer(SynchronousMode);
     void pumpTokenizerIfPossible(SynchronousMode);
 
+    bool shouldUseBackgroundParser();
+    void startBackgroundParser();
+    void stopBackgroundParser();
+    bool constructTreeFromBackgroundToken();
+    void restartBackgroundParser(const HTMLTokenizer::Checkpoint&);
+    void tokenizeRemainingInputOnMainThread();
+    enum BackgroundSourceTrimming {
+        KeepPartiallyConsumedSource,
+        TrimPartiallyConsumedSource,
+    };
+    void discardConsumedBackgroundSource(BackgroundSourceTrimming);
+
     bool runScriptsForPausedTreeBuilder();
     void resumeParsingAfterScriptExecution();
 
@@ -136,7 +155,7 @@ private:
     bool isScheduledForResume() const;
     bool inScriptExecution() const;
     bool inPumpSession() const { return m_pumpSessionNestingLevel > 0; }
-    bool shouldDelayEnd() const { return inPumpSession() || isWaitingForScripts() || inScriptExecution() || isScheduledForResume(); }
+    bool shouldDelayEnd() const { return inPumpSession() || isWaitingForScripts() || inScriptExecution() || isScheduledForResume() || m_backgroundParser; }
 
     ScriptController* script() const;
 
@@ -155,6 +174,28 @@ private:
 
     bool m_endWasDelayed;
     unsigned m_pumpSessionNestingLevel;
+
+    // While m_backgroundParser is set, the input we receive from the network
+    // is tokenized on the HTMLParserThread and m_input only holds what
+    // document.write() inserts.
+    RefPtr<BackgroundHTMLParser> m_backgroundParser;
+    unsigned m_backgroundParserGeneration;
+    bool m_haveCheckedForBackgroundParser;
+    bool m_backgroundParserWasFinished;
+    Vector<OwnPtr<BackgroundHTMLParser::ParsedChunk> > m_parsedChunks;
+    size_t m_nextTokenIndex;
+
+    // The network input from m_backgroundSourceOffset on, kept so that we
+    // can restart the background parser or take over from it.
+    Vector<String> m_backgroundSource;
+    int m_backgroundSourceOffset;
+
+    // Where the last token we received from the background parser ended and
+    // the tokenizer state it expected the tree builder to leave behind.
+    int m_lastTokenEndOffset;
+    TextPosition0 m_lastTokenEndPosition;
+    HTMLTokenizer::Checkpoint m_expectedCheckpoint;
+    bool m_lastTokenWasCheckpoint;
 };
 
 }
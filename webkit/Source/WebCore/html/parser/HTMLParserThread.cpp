@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2011 Google, Inc. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HTMLParserThread.h"
+
+#include <wtf/MainThread.h>
+
+namespace WebCore {
+
+HTMLParserThread::HTMLParserThread()
+    : m_threadID(0)
+{
+}
+
+HTMLParserThread* HTMLParserThread::shared()
+{
+    ASSERT(isMainThread());
+    static HTMLParserThread* thread = new HTMLParserThread;
+    return thread;
+}
+
+void HTMLParserThread::postTask(PassOwnPtr<Task> task)
+{
+    {
+        MutexLocker lock(m_threadCreationMutex);
+        if (!m_threadID)
+            m_threadID = createThread(HTMLParserThread::threadStart, this, "WebCore: HTMLParser");
+    }
+    m_queue.append(task);
+}
+
+class SameInstancePredicate {
+public:
+    SameInstancePredicate(const void* instance) : m_instance(instance) { }
+    bool operator()(HTMLParserThread::Task* task) const { return task->instance() == m_instance; }
+private:
+    const void* m_instance;
+};
+
+void HTMLParserThread::unscheduleTasks(const void* instance)
+{
+    SameInstancePredicate predicate(instance);
+    m_queue.removeIf(predicate);
+}
+
+void* HTMLParserThread::threadStart(void* arg)
+{
+    static_cast<HTMLParserThread*>(arg)->runLoop();
+    return 0;
+}
+
+void HTMLParserThread::runLoop()
+{
+    {
+        // Wait for postTask() to finish creating the thread so that
+        // m_threadID is established before we start running tasks.
+        MutexLocker lock(m_threadCreationMutex);
+    }
+
+    while (OwnPtr<Task> task = m_queue.waitForMessage())
+        task->performTask();
+}
+
+} // namespace WebCore
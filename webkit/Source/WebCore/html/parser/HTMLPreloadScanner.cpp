@@ -29,6 +29,7 @@
 #include "HTMLPreloadScanner.h"
 
 #include "CachedResourceLoader.h"
+#include "CompactHTMLToken.h"
 #include "Document.h"
 #include "InputType.h"
 #include "HTMLDocumentParser.h"
@@ -53,41 +54,60 @@ public:
         , m_linkMediaAttributeIsScreen(true)
         , m_inputIsImage(false)
     {
-        processAttributes(token.attributes());
-    }
-
-    void processAttributes(const HTMLToken::AttributeList& attributes)
-    {
-        if (m_tagName != imgTag
-            && m_tagName != inputTag
-            && m_tagName != linkTag
-            && m_tagName != scriptTag)
+        if (!isPreloadableTag())
             return;
 
+        const HTMLToken::AttributeList& attributes = token.attributes();
         for (HTMLToken::AttributeList::const_iterator iter = attributes.begin();
              iter != attributes.end(); ++iter) {
             AtomicString attributeName(iter->m_name.data(), iter->m_name.size());
             String attributeValue(iter->m_value.data(), iter->m_value.size());
+            processAttribute(attributeName, attributeValue);
+        }
+    }
+
+    PreloadTask(const CompactHTMLToken& token)
+        : m_tagName(token.data())
+        , m_linkIsStyleSheet(false)
+        , m_linkMediaAttributeIsScreen(true)
+        , m_inputIsImage(false)
+    {
+        if (!isPreloadableTag())
+            return;
+
+        const Vector<CompactHTMLToken::Attribute>& attributes = token.attributes();
+        for (size_t i = 0; i < attributes.size(); ++i)
+            processAttribute(attributes[i].name, attributes[i].value);
+    }
+
+    bool isPreloadableTag() const
+    {
+        return m_tagName == imgTag
+            || m_tagName == inputTag
+            || m_tagName == linkTag
+            || m_tagName == scriptTag;
+    }
 
-            if (attributeName == charsetAttr)
-                m_charset = attributeValue;
-
-            if (m_tagName == scriptTag || m_tagName == imgTag) {
-                if (attributeName == srcAttr)
-                    setUrlToLoad(attributeValue);
-            } else if (m_tagName == linkTag) {
-                if (attributeName == hrefAttr)
-                    setUrlToLoad(attributeValue);
-                else if (attributeName == relAttr)
-                    m_linkIsStyleSheet = relAttributeIsStyleSheet(attributeValue);
-                else if (attributeName == mediaAttr)
-                    m_linkMediaAttributeIsScreen = linkMediaAttributeIsScreen(attributeValue);
-            } else if (m_tagName == inputTag) {
-                if (attributeName == srcAttr)
-                    setUrlToLoad(attributeValue);
-                else if (attributeName == typeAttr)
-                    m_inputIsImage = equalIgnoringCase(attributeValue, InputTypeNames::image());
-            }
+    void processAttribute(const AtomicString& attributeName, const String& attributeValue)
+    {
+        if (attributeName == charsetAttr)
+            m_charset = attributeValue;
+
+        if (m_tagName == scriptTag || m_tagName == imgTag) {
+            if (attributeName == srcAttr)
+                setUrlToLoad(attributeValue);
+        } else if (m_tagName == linkTag) {
+            if (attributeName == hrefAttr)
+                setUrlToLoad(attributeValue);
+            else if (attributeName == relAttr)
+                m_linkIsStyleSheet = relAttributeIsStyleSheet(attributeValue);
+            else if (attributeName == mediaAttr)
+                m_linkMediaAttributeIsScreen = linkMediaAttributeIsScreen(attributeValue);
+        } else if (m_tagName == inputTag) {
+            if (attributeName == srcAttr)
+                setUrlToLoad(attributeValue);
+            else if (attributeName == typeAttr)
+                m_inputIsImage = equalIgnoringCase(attributeValue, InputTypeNames::image());
         }
     }
 
@@ -197,6 +217,13 @@ void HTMLPreloadScanner::processToken()
     task.preload(m_document, scanningBody());
 }
 
+void HTMLPreloadScanner::preload(Document* document, const CompactHTMLToken& token, bool bodySeen)
+{
+    ASSERT(token.type() == HTMLToken::StartTag);
+    PreloadTask task(token);
+    task.preload(document, document->body() || bodySeen);
+}
+
 bool HTMLPreloadScanner::scanningBody() const
 {
     return m_document->body() || m_bodySeen;
@@ -33,6 +33,7 @@
 
 namespace WebCore {
 
+class CompactHTMLToken;
 class Document;
 class HTMLToken;
 class HTMLTokenizer;
@@ -46,6 +47,10 @@ public:
     void appendToEnd(const SegmentedString&);
     void scan();
 
+    // Used for the start tags the BackgroundHTMLParser finds on the parser
+    // thread, where we can't evaluate media queries or start loads.
+    static void preload(Document*, const CompactHTMLToken& startTag, bool bodySeen);
+
 private:
     void processToken();
     bool scanningBody() const;
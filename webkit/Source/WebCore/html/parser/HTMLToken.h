@@ -32,6 +32,8 @@
 
 namespace WebCore {
 
+class CompactHTMLToken;
+
 class HTMLToken {
     WTF_MAKE_NONCOPYABLE(HTMLToken); WTF_MAKE_FAST_ALLOCATED;
 public:
@@ -160,6 +162,12 @@ public:
         m_data.append(characters);
     }
 
+    void appendToCharacter(const UChar* characters, size_t length)
+    {
+        ASSERT(m_type == Character);
+        m_data.append(characters, length);
+    }
+
     void appendToComment(UChar character)
     {
         ASSERT(character);
@@ -222,6 +230,13 @@ public:
         m_currentAttribute->m_value.append(character);
     }
 
+    void appendToAttributeValue(const UChar* characters, size_t length)
+    {
+        ASSERT(m_type == StartTag || m_type == EndTag);
+        ASSERT(m_currentAttribute->m_valueRange.m_start);
+        m_currentAttribute->m_value.append(characters, length);
+    }
+
     void appendToAttributeValue(size_t i, const String& value)
     {
         ASSERT(!value.isEmpty());
@@ -340,6 +355,7 @@ private:
     // AtomicHTMLToken will be.  I'm marking this a friend for now, but we'll
     // want to end up with a cleaner interface between the two classes.
     friend class AtomicHTMLToken;
+    friend class CompactHTMLToken;
 
     class DoctypeData {
         WTF_MAKE_NONCOPYABLE(DoctypeData);
@@ -407,11 +423,15 @@ public:
             m_data = String(token.comment().data(), token.comment().size());
             break;
         case HTMLToken::Character:
-            m_externalCharacters = &token.characters();
+            m_externalCharacters = token.characters().data();
+            m_externalCharactersLength = token.characters().size();
             break;
         }
     }
 
+    // Defined in CompactHTMLToken.cpp.
+    explicit AtomicHTMLToken(const CompactHTMLToken&);
+
     AtomicHTMLToken(HTMLToken::Type type, AtomicString name, PassRefPtr<NamedNodeMap> attributes = 0)
         : m_type(type)
         , m_name(name)
@@ -460,10 +480,16 @@ public:
         return m_attributes.release();
     }
 
-    const HTMLToken::DataVector& characters() const
+    const UChar* characters() const
+    {
+        ASSERT(m_type == HTMLToken::Character);
+        return m_externalCharacters;
+    }
+
+    size_t charactersLength() const
     {
         ASSERT(m_type == HTMLToken::Character);
-        return *m_externalCharacters;
+        return m_externalCharactersLength;
     }
 
     const String& comment() const
@@ -515,13 +541,15 @@ private:
 
     // "characters" for Character
     //
-    // We don't want to copy the the characters out of the HTMLToken, so we
-    // keep a pointer to its buffer instead.  This buffer is owned by the
-    // HTMLToken and causes a lifetime dependence between these objects.
+    // We don't want to copy the the characters out of the HTMLToken (or the
+    // CompactHTMLToken), so we keep a pointer to its buffer instead.  This
+    // buffer is owned by the token and causes a lifetime dependence between
+    // these objects.
     //
     // FIXME: Add a mechanism for "internalizing" the characters when the
     //        HTMLToken is destructed.
-    const HTMLToken::DataVector* m_externalCharacters;
+    const UChar* m_externalCharacters;
+    size_t m_externalCharactersLength;
 
     // For DOCTYPE
     OwnPtr<HTMLToken::DoctypeData> m_doctypeData;
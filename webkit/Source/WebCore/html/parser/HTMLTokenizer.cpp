@@ -40,6 +40,12 @@
 #include <wtf/text/CString.h>
 #include <wtf/unicode/Unicode.h>
 
+#if CPU(X86_64) || (CPU(X86) && defined(__SSE2__))
+#include <emmintrin.h>
+#elif CPU(ARM_NEON) && COMPILER(GCC)
+#include <arm_neon.h>
+#endif
+
 using namespace WTF;
 
 namespace WebCore {
@@ -62,6 +68,57 @@ inline bool isTokenizerWhitespace(UChar cc)
     return cc == ' ' || cc == '\x0A' || cc == '\x09' || cc == '\x0C';
 }
 
+// Returns the number of characters at the start of |characters| that the
+// tokenizer can buffer as they are, i.e., the characters before the first
+// |delimiter1|, |delimiter2|, or character that the InputStreamPreprocessor
+// needs to see ('\0', '\r' and '\n'). Runs of such characters make up most
+// of the input in the data and attribute value states, so we look at eight
+// characters at a time where we can.
+inline size_t scanPlainCharacters(const UChar* characters, size_t length, UChar delimiter1, UChar delimiter2)
+{
+    size_t i = 0;
+#if CPU(X86_64) || (CPU(X86) && defined(__SSE2__))
+    const __m128i delimiter1s = _mm_set1_epi16(delimiter1);
+    const __m128i delimiter2s = _mm_set1_epi16(delimiter2);
+    const __m128i nulls = _mm_setzero_si128();
+    const __m128i carriageReturns = _mm_set1_epi16('\r');
+    const __m128i newlines = _mm_set1_epi16('\n');
+    for (; i + 8 <= length; i += 8) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters + i));
+        __m128i matches = _mm_or_si128(_mm_cmpeq_epi16(block, delimiter1s), _mm_cmpeq_epi16(block, delimiter2s));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi16(block, nulls));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi16(block, carriageReturns));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi16(block, newlines));
+        // The loop below finds which of the eight it was.
+        if (_mm_movemask_epi8(matches))
+            break;
+    }
+#elif CPU(ARM_NEON) && COMPILER(GCC)
+    const uint16x8_t delimiter1s = vdupq_n_u16(delimiter1);
+    const uint16x8_t delimiter2s = vdupq_n_u16(delimiter2);
+    const uint16x8_t nulls = vdupq_n_u16(0);
+    const uint16x8_t carriageReturns = vdupq_n_u16('\r');
+    const uint16x8_t newlines = vdupq_n_u16('\n');
+    for (; i + 8 <= length; i += 8) {
+        uint16x8_t block = vld1q_u16(reinterpret_cast<const uint16_t*>(characters + i));
+        uint16x8_t matches = vorrq_u16(vceqq_u16(block, delimiter1s), vceqq_u16(block, delimiter2s));
+        matches = vorrq_u16(matches, vceqq_u16(block, nulls));
+        matches = vorrq_u16(matches, vceqq_u16(block, carriageReturns));
+        matches = vorrq_u16(matches, vceqq_u16(block, newlines));
+        uint32x2_t folded = vreinterpret_u32_u16(vorr_u16(vget_low_u16(matches), vget_high_u16(matches)));
+        // The loop below finds which of the eight it was.
+        if (vget_lane_u32(folded, 0) | vget_lane_u32(folded, 1))
+            break;
+    }
+#endif
+    for (; i < length; ++i) {
+        UChar character = characters[i];
+        if (character == delimiter1 || character == delimiter2 || character == '\0' || character == '\r' || character == '\n')
+            break;
+    }
+    return i;
+}
+
 inline void advanceStringAndASSERTIgnoringCase(SegmentedString& source, const char* expectedCharacters)
 {
     while (*expectedCharacters)
@@ -317,6 +374,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferCharacterRun(source, '<', '&');
             ADVANCE_TO(DataState);
         }
     }
@@ -338,6 +396,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferCharacterRun(source, '<', '&');
             ADVANCE_TO(RCDATAState);
         }
     }
@@ -357,6 +416,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferCharacterRun(source, '<', '<');
             ADVANCE_TO(RAWTEXTState);
         }
     }
@@ -369,6 +429,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             return emitEndOfFile(source);
         else {
             bufferCharacter(cc);
+            bufferCharacterRun(source, '<', '<');
             ADVANCE_TO(ScriptDataState);
         }
     }
@@ -377,8 +438,10 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
     BEGIN_STATE(PLAINTEXTState) {
         if (cc == InputStreamPreprocessor::endOfFileMarker)
             return emitEndOfFile(source);
-        else
+        else {
             bufferCharacter(cc);
+            bufferCharacterRun(source, '\0', '\0');
+        }
         ADVANCE_TO(PLAINTEXTState);
     }
     END_STATE()
@@ -1004,6 +1067,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             RECONSUME_IN(DataState);
         } else {
             m_token->appendToAttributeValue(cc);
+            appendAttributeValueRun(source, '"', '&');
             ADVANCE_TO(AttributeValueDoubleQuotedState);
         }
     }
@@ -1022,6 +1086,7 @@ bool HTMLTokenizer::nextToken(SegmentedString& source, HTMLToken& token)
             RECONSUME_IN(DataState);
         } else {
             m_token->appendToAttributeValue(cc);
+            appendAttributeValueRun(source, '\'', '&');
             ADVANCE_TO(AttributeValueSingleQuotedState);
         }
     }
@@ -1662,6 +1727,40 @@ void HTMLTokenizer::updateStateFor(const AtomicString& tagName, Frame* frame)
         setState(RAWTEXTState);
 }
 
+bool HTMLTokenizer::canCreateCheckpoint() const
+{
+    switch (m_state) {
+    case DataState:
+    case RCDATAState:
+    case RAWTEXTState:
+    case ScriptDataState:
+    case PLAINTEXTState:
+        break;
+    default:
+        return false;
+    }
+    // A pending end tag or a swallowed '\r' whose '\n' we have yet to skip
+    // aren't captured by the checkpoint.
+    return m_bufferedEndTagName.isEmpty() && !m_inputStreamPreprocessor.skipNextNewLine();
+}
+
+void HTMLTokenizer::createCheckpoint(Checkpoint& checkpoint) const
+{
+    checkpoint.state = m_state;
+    checkpoint.skipLeadingNewLineForListing = m_skipLeadingNewLineForListing;
+    checkpoint.forceNullCharacterReplacement = m_forceNullCharacterReplacement;
+    checkpoint.shouldAllowCDATA = m_shouldAllowCDATA;
+}
+
+void HTMLTokenizer::restoreFromCheckpoint(const Checkpoint& checkpoint)
+{
+    m_state = checkpoint.state;
+    m_skipLeadingNewLineForListing = checkpoint.skipLeadingNewLineForListing;
+    m_forceNullCharacterReplacement = checkpoint.forceNullCharacterReplacement;
+    m_shouldAllowCDATA = checkpoint.shouldAllowCDATA;
+    m_bufferedEndTagName.clear();
+}
+
 inline bool HTMLTokenizer::temporaryBufferIs(const String& expectedString)
 {
     return vectorEqualsString(m_temporaryBuffer, expectedString);
@@ -1685,6 +1784,33 @@ inline void HTMLTokenizer::bufferCharacter(UChar character)
     m_token->appendToCharacter(character);
 }
 
+inline size_t HTMLTokenizer::plainCharacterRunLength(SegmentedString& source, UChar delimiter1, UChar delimiter2)
+{
+    // A newline needs its line counted when we advance past it, and a '\r'
+    // needs the InputStreamPreprocessor to look at the character after it.
+    if (m_inputStreamPreprocessor.nextInputCharacter() == '\n')
+        return 0;
+    return scanPlainCharacters(source.charactersAfterCurrent(), source.numberOfCharactersAfterCurrent(), delimiter1, delimiter2);
+}
+
+// Buffers the characters after the current one up to the next one the
+// current state needs to look at, and leaves |source| on the last of them.
+inline void HTMLTokenizer::bufferCharacterRun(SegmentedString& source, UChar delimiter1, UChar delimiter2)
+{
+    if (size_t length = plainCharacterRunLength(source, delimiter1, delimiter2)) {
+        m_token->appendToCharacter(source.charactersAfterCurrent(), length);
+        source.advancePastNonNewlines(length);
+    }
+}
+
+inline void HTMLTokenizer::appendAttributeValueRun(SegmentedString& source, UChar delimiter1, UChar delimiter2)
+{
+    if (size_t length = plainCharacterRunLength(source, delimiter1, delimiter2)) {
+        m_token->appendToAttributeValue(source.charactersAfterCurrent(), length);
+        source.advancePastNonNewlines(length);
+    }
+}
+
 inline void HTMLTokenizer::parseError()
 {
     notImplemented();
@@ -162,6 +162,32 @@ public:
     bool shouldAllowCDATA() const { return m_shouldAllowCDATA; }
     void setShouldAllowCDATA(bool value) { m_shouldAllowCDATA = value; }
 
+    // The part of the tokenizer's state that survives from one token to the
+    // next and that the tree builder can change. When canCreateCheckpoint()
+    // is true, a tokenizer restored from a checkpoint (plus the line number
+    // and the appropriate end tag name) continues exactly where this one
+    // stopped. BackgroundHTMLParser uses checkpoints to move tokenization
+    // between threads.
+    struct Checkpoint {
+        State state;
+        bool skipLeadingNewLineForListing;
+        bool forceNullCharacterReplacement;
+        bool shouldAllowCDATA;
+    };
+
+    bool canCreateCheckpoint() const;
+    void createCheckpoint(Checkpoint&) const;
+    void restoreFromCheckpoint(const Checkpoint&);
+
+    void setLineNumber(int lineNumber) { m_lineNumber = lineNumber; }
+
+    const Vector<UChar, 32>& appropriateEndTagName() const { return m_appropriateEndTagName; }
+    void setAppropriateEndTagName(const UChar* characters, size_t length)
+    {
+        m_appropriateEndTagName.clear();
+        m_appropriateEndTagName.append(characters, length);
+    }
+
     bool shouldSkipNullCharacters() const
     {
         return !m_forceNullCharacterReplacement
@@ -184,6 +210,7 @@ private:
         }
 
         UChar nextInputCharacter() const { return m_nextInputCharacter; }
+        bool skipNextNewLine() const { return m_skipNextNewLine; }
 
         // Returns whether we succeeded in peeking at the next character.
         // The only way we can fail to peek is if there are no more
@@ -263,6 +290,9 @@ private:
     inline void parseError();
     inline void bufferCharacter(UChar);
     inline void bufferCodePoint(unsigned);
+    inline size_t plainCharacterRunLength(SegmentedString&, UChar delimiter1, UChar delimiter2);
+    inline void bufferCharacterRun(SegmentedString&, UChar delimiter1, UChar delimiter2);
+    inline void appendAttributeValueRun(SegmentedString&, UChar delimiter1, UChar delimiter2);
 
     inline bool emitAndResumeIn(SegmentedString&, State);
     inline bool emitAndReconsumeIn(SegmentedString&, State);
@@ -313,6 +343,19 @@ private:
     bool m_usePreHTML5ParserQuirks;
 };
 
+inline bool operator==(const HTMLTokenizer::Checkpoint& a, const HTMLTokenizer::Checkpoint& b)
+{
+    return a.state == b.state
+        && a.skipLeadingNewLineForListing == b.skipLeadingNewLineForListing
+        && a.forceNullCharacterReplacement == b.forceNullCharacterReplacement
+        && a.shouldAllowCDATA == b.shouldAllowCDATA;
+}
+
+inline bool operator!=(const HTMLTokenizer::Checkpoint& a, const HTMLTokenizer::Checkpoint& b)
+{
+    return !(a == b);
+}
+
 }
 
 #endif
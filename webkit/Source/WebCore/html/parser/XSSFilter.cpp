@@ -189,6 +189,15 @@ void XSSFilter::init()
         m_isEnabled = false;
 }
 
+bool XSSFilter::isEnabled()
+{
+    if (m_state == Uninitialized) {
+        init();
+        ASSERT(m_state == Initial);
+    }
+    return m_isEnabled && m_xssProtection != XSSProtectionDisabled;
+}
+
 void XSSFilter::filterToken(HTMLToken& token)
 {
     if (m_state == Uninitialized) {
@@ -41,6 +41,10 @@ public:
 
     void filterToken(HTMLToken&);
 
+    // Returns false if filterToken() will never change a token of this
+    // document.
+    bool isEnabled();
+
 private:
     enum State {
         Uninitialized,
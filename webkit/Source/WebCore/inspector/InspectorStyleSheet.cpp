@@ -633,6 +633,8 @@ InspectorStyleSheet::InspectorStyleSheet(const String& id, PassRefPtr<CSSStyleSh
     , m_isRevalidating(false)
 {
     m_parsedStyleSheet = new ParsedStyleSheet();
+    if (m_pageStyleSheet)
+        m_pageStyleSheet->setRulesExposed();
 }
 
 InspectorStyleSheet::~InspectorStyleSheet()
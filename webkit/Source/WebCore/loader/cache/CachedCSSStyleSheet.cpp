@@ -28,11 +28,13 @@
 #include "CachedCSSStyleSheet.h"
 
 #include "MemoryCache.h"
+#include "CSSStyleSheet.h"
 #include "CachedResourceClient.h"
 #include "CachedResourceClientWalker.h"
 #include "HTTPParsers.h"
 #include "TextResourceDecoder.h"
 #include "SharedBuffer.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/Vector.h>
 
 namespace WebCore {
@@ -40,6 +42,8 @@ namespace WebCore {
 CachedCSSStyleSheet::CachedCSSStyleSheet(const String& url, const String& charset)
     : CachedResource(url, CSSStyleSheet)
     , m_decoder(TextResourceDecoder::create("text/css", charset))
+    , m_parsedStyleSheetEnforcedMIMEType(false)
+    , m_parsedStyleSheetHasValidMIMEType(false)
 {
     // Prefer text/css but accept any type (dell.com serves a stylesheet
     // as text/html; see <http://bugs.webkit.org/show_bug.cgi?id=11451>).
@@ -52,8 +56,12 @@ CachedCSSStyleSheet::~CachedCSSStyleSheet()
 
 void CachedCSSStyleSheet::didAddClient(CachedResourceClient *c)
 {
-    if (!isLoading())
+    if (!isLoading()) {
+        // The client parses the sheet right away.
+        double parseStartTime = currentTime();
         c->setCSSStyleSheet(m_url, m_response.url(), m_decoder->encoding().name(), this);
+        didDecode(currentTime() - parseStartTime);
+    }
 }
 
 void CachedCSSStyleSheet::allClientsRemoved()
@@ -96,12 +104,15 @@ void CachedCSSStyleSheet::data(PassRefPtr<SharedBuffer> data, bool allDataReceiv
     m_data = data;
     setEncodedSize(m_data.get() ? m_data->size() : 0);
     // Decode the data to find out the encoding and keep the sheet text around during checkNotify()
+    double decodeStartTime = currentTime();
     if (m_data) {
         m_decodedSheetText = m_decoder->decode(m_data->data(), m_data->size());
         m_decodedSheetText += m_decoder->flush();
     }
     setLoading(false);
+    // The clients parse the sheet in checkNotify(), so that counts too.
     checkNotify();
+    didDecode(currentTime() - decodeStartTime);
     // Clear the decoded text as it is unlikely to be needed immediately again and is cheap to regenerate.
     m_decodedSheetText = String();
 }
@@ -116,6 +127,56 @@ void CachedCSSStyleSheet::checkNotify()
         c->setCSSStyleSheet(m_url, m_response.url(), m_decoder->encoding().name(), this);
 }
 
+void CachedCSSStyleSheet::saveParsedStyleSheet(PassRefPtr<WebCore::CSSStyleSheet> sheet, bool enforceMIMEType, bool hasValidMIMEType)
+{
+    // Sheets with @import rules load their imports through the document that
+    // parsed them, so they stay with that document.
+    if (errorOccurred() || sheet->hasImportRules())
+        return;
+
+    m_parsedStyleSheet = sheet;
+    m_parsedStyleSheetEnforcedMIMEType = enforceMIMEType;
+    m_parsedStyleSheetHasValidMIMEType = hasValidMIMEType;
+
+    // We don't know how much memory the rules take. They are several times
+    // the size of the text they were parsed from, so count them as such.
+    static const unsigned parsedSizePerEncodedByte = 4;
+    setDecodedSize(encodedSize() * parsedSizePerEncodedByte);
+}
+
+PassRefPtr<WebCore::CSSStyleSheet> CachedCSSStyleSheet::restoreParsedStyleSheet(const String& href, bool strictParsing, bool enforceMIMEType, bool* hasValidMIMEType)
+{
+    if (!m_parsedStyleSheet)
+        return 0;
+
+    // Only hand the sheet out once the document it was parsed for has let go of
+    // it, and only if nothing could have changed it since it was parsed.
+    if (!m_parsedStyleSheet->hasOneRef() || m_parsedStyleSheet->ownerNode() || m_parsedStyleSheet->rulesExposed() || m_parsedStyleSheet->disabled()) {
+        // Such a sheet will never be handed out, so stop holding on to it.
+        if (m_parsedStyleSheet->rulesExposed() || m_parsedStyleSheet->disabled())
+            destroyDecodedData();
+        return 0;
+    }
+
+    if (m_parsedStyleSheet->href() != href || m_parsedStyleSheet->useStrictParsing() != strictParsing || m_parsedStyleSheetEnforcedMIMEType != enforceMIMEType)
+        return 0;
+
+    // The images were requested on behalf of the document the sheet was parsed
+    // for. Drop them so that the new document requests them itself, with its
+    // own security checks.
+    m_parsedStyleSheet->clearCachedImages();
+
+    if (hasValidMIMEType)
+        *hasValidMIMEType = m_parsedStyleSheetHasValidMIMEType;
+    return m_parsedStyleSheet;
+}
+
+void CachedCSSStyleSheet::destroyDecodedData()
+{
+    m_parsedStyleSheet = 0;
+    setDecodedSize(0);
+}
+
 void CachedCSSStyleSheet::error(CachedResource::Status status)
 {
     setStatus(status);
@@ -32,6 +32,7 @@
 
 namespace WebCore {
 
+    class CSSStyleSheet;
     class CachedResourceLoader;
     class TextResourceDecoder;
 
@@ -52,6 +53,14 @@ namespace WebCore {
         virtual void error(CachedResource::Status);
 
         void checkNotify();
+
+        // Navigating within a site links the same sheets from every page. The
+        // sheet parsed for one document is kept here, and handed to a later one
+        // parsing with the same settings once nothing else refers to it.
+        void saveParsedStyleSheet(PassRefPtr<WebCore::CSSStyleSheet>, bool enforceMIMEType, bool hasValidMIMEType);
+        PassRefPtr<WebCore::CSSStyleSheet> restoreParsedStyleSheet(const String& href, bool strictParsing, bool enforceMIMEType, bool* hasValidMIMEType);
+
+        virtual void destroyDecodedData();
     
     private:
         bool canUseSheet(bool enforceMIMEType, bool* hasValidMIMEType) const;
@@ -60,6 +69,10 @@ namespace WebCore {
     protected:
         RefPtr<TextResourceDecoder> m_decoder;
         String m_decodedSheetText;
+
+        RefPtr<WebCore::CSSStyleSheet> m_parsedStyleSheet;
+        bool m_parsedStyleSheetEnforcedMIMEType;
+        bool m_parsedStyleSheetHasValidMIMEType;
     };
 
 }
@@ -89,10 +89,12 @@ CachedResource::CachedResource(const String& url, Type type)
     , m_encodedSize(0)
     , m_decodedSize(0)
     , m_accessCount(0)
+    , m_decodeCost(0)
     , m_handleCount(0)
     , m_preloadCount(0)
     , m_preloadResult(PreloadNotReferenced)
     , m_inLiveDecodedResourcesList(false)
+    , m_decodedDataPrunedByCache(false)
     , m_requestedFromNetworkingLayer(false)
     , m_sendResourceLoadCallbacks(true)
     , m_inCache(false)
@@ -371,6 +373,29 @@ void CachedResource::setDecodedSize(unsigned size)
     }
 }
 
+void CachedResource::didDecode(double decodeTime)
+{
+    if (m_decodedDataPrunedByCache) {
+        m_decodedDataPrunedByCache = false;
+        if (inCache())
+            memoryCache()->resourceRedecoded(this);
+    }
+
+    // Saturate at a minute so that the cache's weighting can't overflow.
+    unsigned cost = static_cast<unsigned>(std::min(decodeTime * 1000, 60000.0));
+    if (cost == m_decodeCost)
+        return;
+
+    // As with a size change, the cost picks the resource's LRU list.
+    if (inCache())
+        memoryCache()->removeFromLRUList(this);
+
+    m_decodeCost = cost;
+
+    if (inCache())
+        memoryCache()->insertInLRUList(this);
+}
+
 void CachedResource::setEncodedSize(unsigned size)
 {
     if (size == m_encodedSize)
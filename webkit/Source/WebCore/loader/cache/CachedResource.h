@@ -143,6 +143,9 @@ public:
     unsigned accessCount() const { return m_accessCount; }
     void increaseAccessCount() { m_accessCount++; }
 
+    // Milliseconds the last decode or parse of this resource took.
+    unsigned decodeCost() const { return m_decodeCost; }
+
     // Computes the status of an object after loading.  
     // Updates the expire date on the cache entry file
     void finish();
@@ -224,6 +227,8 @@ protected:
     void setEncodedSize(unsigned);
     void setDecodedSize(unsigned);
     void didAccessDecodedData(double timeStamp);
+    // Subclasses report how long producing their decoded data took, in seconds.
+    void didDecode(double decodeTime);
 
     bool isSafeToMakePurgeable() const;
     
@@ -255,12 +260,14 @@ private:
     unsigned m_encodedSize;
     unsigned m_decodedSize;
     unsigned m_accessCount;
+    unsigned m_decodeCost;
     unsigned m_handleCount;
     unsigned m_preloadCount;
 
     unsigned m_preloadResult : 2; // PreloadResult
 
     bool m_inLiveDecodedResourcesList : 1;
+    bool m_decodedDataPrunedByCache : 1;
     bool m_requestedFromNetworkingLayer : 1;
     bool m_sendResourceLoadCallbacks : 1;
 
@@ -39,6 +39,7 @@
 #include "ResourceHandle.h"
 #include "SecurityOrigin.h"
 #include "SecurityOriginHash.h"
+#include <algorithm>
 #include <stdio.h>
 #include <wtf/CurrentTime.h>
 #include <wtf/text/CString.h>
@@ -55,6 +56,7 @@ static const int cDefaultCacheCapacity = 8192 * 1024;
 static const double cMinDelayBeforeLiveDecodedPrune = 1; // Seconds.
 static const float cTargetPrunePercentage = .95f; // Percentage of capacity toward which we prune, to avoid immediately pruning again.
 static const double cDefaultDecodedDataDeletionInterval = 0;
+static const unsigned cMaxPrunedURLs = 256;
 
 MemoryCache* memoryCache()
 {
@@ -95,6 +97,13 @@ bool MemoryCache::add(CachedResource* resource)
     
     m_resources.set(resource->url(), resource);
     resource->setInCache(true);
+
+    HashSet<String>::iterator prunedURL = m_prunedURLs.find(resource->url());
+    if (prunedURL != m_prunedURLs.end()) {
+        m_prunedURLs.remove(prunedURL);
+        if (TypeStatistic* statistic = typeStatisticFor(m_thrashStatistics, resource->type()))
+            statistic->refetches++;
+    }
     
     resourceAccessed(resource);
     
@@ -166,6 +175,18 @@ unsigned MemoryCache::liveCapacity() const
     return m_capacity - deadCapacity();
 }
 
+// The Greedy-Dual-Size-Frequency priority of a resource's decoded data: how
+// often the resource was used and how long decoding it took, per decoded byte.
+static inline double decodedDataPriority(CachedResource* resource)
+{
+    return static_cast<double>(resource->accessCount()) * (resource->decodeCost() + 1) / resource->decodedSize();
+}
+
+static bool hasLowerDecodedDataPriority(CachedResource* a, CachedResource* b)
+{
+    return decodedDataPriority(a) < decodedDataPriority(b);
+}
+
 void MemoryCache::pruneLiveResources()
 {
     if (!m_pruneEnabled)
@@ -180,7 +201,7 @@ void MemoryCache::pruneLiveResources()
     if (!currentTime) // In case prune is called directly, outside of a Frame paint.
         currentTime = WTF::currentTime();
     
-    // Destroy any decoded data in live objects that we can.
+    // Collect the live objects whose decoded data we can destroy.
     // Start from the tail, since this is the least recently accessed of the objects.
 
     // The list might not be sorted by the m_lastDecodedAccessTime. The impact
@@ -188,25 +209,34 @@ void MemoryCache::pruneLiveResources()
     // elapsedTime will evaluate to false as the currentTime will be a lot
     // greater than the current->m_lastDecodedAccessTime.
     // For more details see: https://bugs.webkit.org/show_bug.cgi?id=30209
-    CachedResource* current = m_liveDecodedResources.m_tail;
-    while (current) {
-        CachedResource* prev = current->m_prevInLiveResourcesList;
+    Vector<CachedResource*> candidates;
+    for (CachedResource* current = m_liveDecodedResources.m_tail; current; current = current->m_prevInLiveResourcesList) {
         ASSERT(current->hasClients());
         if (current->isLoaded() && current->decodedSize()) {
             // Check to see if the remaining resources are too new to prune.
             double elapsedTime = currentTime - current->m_lastDecodedAccessTime;
             if (elapsedTime < cMinDelayBeforeLiveDecodedPrune)
-                return;
+                break;
+            candidates.append(current);
+        }
+    }
 
-            // Destroy our decoded data. This will remove us from 
-            // m_liveDecodedResources, and possibly move us to a different LRU 
-            // list in m_allResources.
-            current->destroyDecodedData();
+    // Destroy the decoded data that is cheapest to get back first. The sort
+    // is stable, so recency still decides between equals.
+    stable_sort(candidates.begin(), candidates.end(), hasLowerDecodedDataPriority);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        CachedResource* current = candidates[i];
+        if (!current->inLiveDecodedResourcesList())
+            continue;
 
-            if (targetSize && m_liveSize <= targetSize)
-                return;
-        }
-        current = prev;
+        // Destroy our decoded data. This will remove us from 
+        // m_liveDecodedResources, and possibly move us to a different LRU 
+        // list in m_allResources.
+        current->m_decodedDataPrunedByCache = true;
+        current->destroyDecodedData();
+
+        if (targetSize && m_liveSize <= targetSize)
+            return;
     }
 }
 
@@ -231,7 +261,7 @@ void MemoryCache::pruneDeadResources()
                 if (current->wasPurged()) {
                     ASSERT(!current->hasClients());
                     ASSERT(!current->isPreloaded());
-                    evict(current);
+                    evictWhilePruning(current);
                 }
                 current = prev;
             }
@@ -253,6 +283,8 @@ void MemoryCache::pruneDeadResources()
                 // Destroy our decoded data. This will remove us from 
                 // m_liveDecodedResources, and possibly move us to a different 
                 // LRU list in m_allResources.
+                if (current->decodedSize())
+                    current->m_decodedDataPrunedByCache = true;
                 current->destroyDecodedData();
                 
                 if (targetSize && m_deadSize <= targetSize) {
@@ -269,7 +301,7 @@ void MemoryCache::pruneDeadResources()
             CachedResource* prev = current->m_prevInAllResourcesList;
             if (!current->hasClients() && !current->isPreloaded() && !current->isCacheValidator()) {
                 if (!makeResourcePurgeable(current))
-                    evict(current);
+                    evictWhilePruning(current);
 
                 // If evict() caused pruneDeadResources() to be re-entered, bail out. This can happen when removing an
                 // SVG CachedImage that has subresources.
@@ -352,6 +384,16 @@ void MemoryCache::evict(CachedResource* resource)
         delete resource;
 }
 
+void MemoryCache::evictWhilePruning(CachedResource* resource)
+{
+    if (resource->inCache()) {
+        if (m_prunedURLs.size() >= cMaxPrunedURLs)
+            m_prunedURLs.clear();
+        m_prunedURLs.add(resource->url());
+    }
+    evict(resource);
+}
+
 static inline unsigned fastLog2(unsigned i)
 {
     unsigned log2 = 0;
@@ -372,8 +414,12 @@ static inline unsigned fastLog2(unsigned i)
 
 MemoryCache::LRUList* MemoryCache::lruListFor(CachedResource* resource)
 {
+    // Greedy-Dual-Size-Frequency, with LRU order within each list standing in
+    // for the aging: large resources that are seldom used and cheap to decode
+    // again go in the higher lists, which are pruned first.
     unsigned accessCount = max(resource->accessCount(), 1U);
-    unsigned queueIndex = fastLog2(resource->size() / accessCount);
+    unsigned long long weight = static_cast<unsigned long long>(accessCount) * (resource->decodeCost() + 1);
+    unsigned queueIndex = fastLog2(static_cast<unsigned>(resource->size() / weight));
 #ifndef NDEBUG
     resource->m_lruIndex = queueIndex;
 #endif
@@ -584,6 +630,12 @@ void MemoryCache::removeFromLiveResourcesSize(CachedResource* resource)
     m_deadSize += resource->size();
 }
 
+void MemoryCache::resourceRedecoded(CachedResource* resource)
+{
+    if (TypeStatistic* statistic = typeStatisticFor(m_thrashStatistics, resource->type()))
+        statistic->redecodes++;
+}
+
 void MemoryCache::adjustSize(bool live, int delta)
 {
     if (live) {
@@ -608,33 +660,35 @@ void MemoryCache::TypeStatistic::addResource(CachedResource* o)
     purgedSize += purged ? pageSize : 0;
 }
 
+MemoryCache::TypeStatistic* MemoryCache::typeStatisticFor(Statistics& stats, CachedResource::Type type)
+{
+    switch (type) {
+    case CachedResource::ImageResource:
+        return &stats.images;
+    case CachedResource::CSSStyleSheet:
+        return &stats.cssStyleSheets;
+    case CachedResource::Script:
+        return &stats.scripts;
+#if ENABLE(XSLT)
+    case CachedResource::XSLStyleSheet:
+        return &stats.xslStyleSheets;
+#endif
+    case CachedResource::FontResource:
+        return &stats.fonts;
+    default:
+        return 0;
+    }
+}
+
 MemoryCache::Statistics MemoryCache::getStatistics()
 {
-    Statistics stats;
+    // Start from the counts we keep as we go, and add up the rest.
+    Statistics stats = m_thrashStatistics;
     CachedResourceMap::iterator e = m_resources.end();
     for (CachedResourceMap::iterator i = m_resources.begin(); i != e; ++i) {
         CachedResource* resource = i->second;
-        switch (resource->type()) {
-        case CachedResource::ImageResource:
-            stats.images.addResource(resource);
-            break;
-        case CachedResource::CSSStyleSheet:
-            stats.cssStyleSheets.addResource(resource);
-            break;
-        case CachedResource::Script:
-            stats.scripts.addResource(resource);
-            break;
-#if ENABLE(XSLT)
-        case CachedResource::XSLStyleSheet:
-            stats.xslStyleSheets.addResource(resource);
-            break;
-#endif
-        case CachedResource::FontResource:
-            stats.fonts.addResource(resource);
-            break;
-        default:
-            break;
-        }
+        if (TypeStatistic* statistic = typeStatisticFor(stats, resource->type()))
+            statistic->addResource(resource);
     }
     return stats;
 }
@@ -680,6 +734,14 @@ void MemoryCache::dumpStats()
     printf("%-13s %13d %13d %13d %13d %13d %13d\n", "JavaScript", s.scripts.count, s.scripts.size, s.scripts.liveSize, s.scripts.decodedSize, s.scripts.purgeableSize, s.scripts.purgedSize);
     printf("%-13s %13d %13d %13d %13d %13d %13d\n", "Fonts", s.fonts.count, s.fonts.size, s.fonts.liveSize, s.fonts.decodedSize, s.fonts.purgeableSize, s.fonts.purgedSize);
     printf("%-13s %-13s %-13s %-13s %-13s %-13s %-13s\n\n", "-------------", "-------------", "-------------", "-------------", "-------------", "-------------", "-------------");
+    printf("%-13s %-13s %-13s\n", "", "Redecodes", "Refetches");
+    printf("%-13s %13d %13d\n", "Images", s.images.redecodes, s.images.refetches);
+    printf("%-13s %13d %13d\n", "CSS", s.cssStyleSheets.redecodes, s.cssStyleSheets.refetches);
+#if ENABLE(XSLT)
+    printf("%-13s %13d %13d\n", "XSL", s.xslStyleSheets.redecodes, s.xslStyleSheets.refetches);
+#endif
+    printf("%-13s %13d %13d\n", "JavaScript", s.scripts.redecodes, s.scripts.refetches);
+    printf("%-13s %13d %13d\n\n", "Fonts", s.fonts.redecodes, s.fonts.refetches);
 }
 
 void MemoryCache::dumpLRULists(bool includeLive) const
@@ -92,7 +92,9 @@ public:
         int decodedSize;
         int purgeableSize;
         int purgedSize;
-        TypeStatistic() : count(0), size(0), liveSize(0), decodedSize(0), purgeableSize(0), purgedSize(0) { }
+        int redecodes; // Decodes of data the cache had pruned.
+        int refetches; // Loads of URLs the cache had evicted.
+        TypeStatistic() : count(0), size(0), liveSize(0), decodedSize(0), purgeableSize(0), purgedSize(0), redecodes(0), refetches(0) { }
         void addResource(CachedResource*);
     };
     
@@ -160,6 +162,9 @@ public:
     void addToLiveResourcesSize(CachedResource*);
     void removeFromLiveResourcesSize(CachedResource*);
 
+    // Called when a resource decodes data that pruning destroyed.
+    void resourceRedecoded(CachedResource*);
+
     static bool shouldMakeResourcePurgeableOnEviction();
 
     // Function to collect cache statistics for the caches window in the Safari Debug menu.
@@ -182,6 +187,7 @@ private:
     ~MemoryCache(); // Not implemented to make sure nobody accidentally calls delete -- WebCore does not delete singletons.
        
     LRUList* lruListFor(CachedResource*);
+    static TypeStatistic* typeStatisticFor(Statistics&, CachedResource::Type);
 #ifndef NDEBUG
     void dumpStats();
     void dumpLRULists(bool includeLive) const;
@@ -195,6 +201,7 @@ private:
 
     bool makeResourcePurgeable(CachedResource*);
     void evict(CachedResource*);
+    void evictWhilePruning(CachedResource*);
 
     bool m_disabled;  // Whether or not the cache is enabled.
     bool m_pruneEnabled;
@@ -219,6 +226,12 @@ private:
     // A URL-based map of all resources that are in the cache (including the freshest version of objects that are currently being 
     // referenced by a Web page).
     HashMap<String, CachedResource*> m_resources;
+
+    // URLs of the resources most recently evicted by pruning, to count how many of them get loaded again.
+    HashSet<String> m_prunedURLs;
+
+    // Re-decode and re-fetch counts, for tuning the capacities.
+    Statistics m_thrashStatistics;
 };
 
 inline bool MemoryCache::shouldMakeResourcePurgeableOnEviction()
@@ -443,6 +443,11 @@ namespace WebCore {
         void setUsePreHTML5ParserQuirks(bool flag) { m_usePreHTML5ParserQuirks = flag; }
         bool usePreHTML5ParserQuirks() const { return m_usePreHTML5ParserQuirks; }
 
+        // When enabled, HTML received from the network is tokenized on a
+        // background thread and the main thread only builds the tree.
+        void setThreadedHTMLParserEnabled(bool flag) { m_threadedHTMLParserEnabled = flag; }
+        bool threadedHTMLParserEnabled() const { return m_threadedHTMLParserEnabled; }
+
         void setHyperlinkAuditingEnabled(bool flag) { m_hyperlinkAuditingEnabled = flag; }
         bool hyperlinkAuditingEnabled() const { return m_hyperlinkAuditingEnabled; }
 
@@ -586,6 +591,7 @@ namespace WebCore {
         bool m_memoryInfoEnabled: 1;
         bool m_interactiveFormValidation: 1;
         bool m_usePreHTML5ParserQuirks: 1;
+        bool m_threadedHTMLParserEnabled : 1;
         bool m_hyperlinkAuditingEnabled : 1;
         bool m_crossOriginCheckInGetMatchedCSSRulesDisabled : 1;
         bool m_useQuickLookResourceCachingQuirks : 1;
@@ -36,6 +36,10 @@
 #include <wtf/CurrentTime.h>
 #include <wtf/Vector.h>
 
+#if PLATFORM(ANDROID)
+#include "ImageDecodingService.h"
+#endif
+
 namespace WebCore {
 
 static int frameBytes(const IntSize& frameSize)
@@ -69,14 +73,23 @@ BitmapImage::BitmapImage(ImageObserver* observer)
 
 BitmapImage::~BitmapImage()
 {
+#if PLATFORM(ANDROID)
+    // Only here: a repaint asked for while the pixels were decoding must
+    // survive destroyDecodedData(), or the image would stay missing.
+    ImageDecodingService::shared().cancelRepaint(this);
+#endif
     invalidatePlatformData();
     stopAnimation();
 }
 
 void BitmapImage::destroyDecodedData(bool destroyAll)
+{
+    destroyDecodedFrames(destroyAll ? m_frames.size() : m_currentFrame, destroyAll);
+}
+
+void BitmapImage::destroyDecodedFrames(size_t clearBeforeFrame, bool destroyDecoder)
 {
     int framesCleared = 0;
-    const size_t clearBeforeFrame = destroyAll ? m_frames.size() : m_currentFrame;
     for (size_t i = 0; i < clearBeforeFrame; ++i) {
         // The underlying frame isn't actually changing (we're just trying to
         // save the memory for the framebuffer data), so we don't need to clear
@@ -87,16 +100,20 @@ void BitmapImage::destroyDecodedData(bool destroyAll)
 
     destroyMetadataAndNotify(framesCleared);
 
-    m_source.clear(destroyAll, clearBeforeFrame, data(), m_allDataReceived);
+    m_source.clear(destroyDecoder, clearBeforeFrame, data(), m_allDataReceived);
     return;
 }
 
-void BitmapImage::destroyDecodedDataIfNecessary(bool destroyAll)
+void BitmapImage::destroyDecodedDataIfNecessary(bool destroyAll, bool keepDecoder)
 {
     // Animated images >5MB are considered large enough that we'll only hang on
     // to one frame at a time.
     static const unsigned cLargeAnimationCutoff = 5242880;
-    if (m_frames.size() * frameBytes(m_size) > cLargeAnimationCutoff)
+    if (m_frames.size() * frameBytes(m_size) <= cLargeAnimationCutoff)
+        return;
+    if (destroyAll && keepDecoder)
+        destroyDecodedFrames(m_frames.size(), false);
+    else
         destroyDecodedData(destroyAll);
 }
 
@@ -124,7 +141,17 @@ void BitmapImage::cacheFrame(size_t index)
     if (m_frames.size() < numFrames)
         m_frames.grow(numFrames);
 
+    double decodeStartTime = currentTime();
     m_frames[index].m_frame = m_source.createFrameAtIndex(index);
+#if PLATFORM(ANDROID)
+    // Android decodes the pixels of still images when they are first locked,
+    // and ImageDecodingService reports how long that takes. Only the frames of
+    // animated GIFs are decoded here.
+    if (numFrames > 1 && imageObserver())
+#else
+    if (imageObserver())
+#endif
+        imageObserver()->didDecode(this, currentTime() - decodeStartTime);
     if (numFrames == 1 && m_frames[index].m_frame)
         checkForSolidColor();
 
@@ -457,7 +484,12 @@ bool BitmapImage::internalAdvanceAnimation(bool skippingFrames)
             destroyAll = true;
         }
     }
-    destroyDecodedDataIfNecessary(destroyAll);
+    // A fully loaded animation that loops keeps its decoder, so that the frames
+    // the decoder keeps to decode the others from survive, and decoding does
+    // not start over from the first frame. Those frames are not counted in the
+    // decoded size, so they are dropped with the decoder as soon as the
+    // animation is reset or the cache destroys the image's decoded data.
+    destroyDecodedDataIfNecessary(destroyAll, m_allDataReceived);
 
     // We need to draw this frame if we advanced to it while not skipping, or if
     // while trying to skip frames we hit the last frame and thus had to stop.
@@ -211,9 +211,15 @@ protected:
     // low without redecoding the whole image on every frame.
     virtual void destroyDecodedData(bool destroyAll = true);
 
+    // Clears the frames before |clearBeforeFrame|, and destroys the decoder
+    // too if |destroyDecoder| is true. Otherwise the decoder clears its own
+    // frame buffer cache up to the same frame.
+    void destroyDecodedFrames(size_t clearBeforeFrame, bool destroyDecoder);
+
     // If the image is large enough, calls destroyDecodedData() and passes
-    // |destroyAll| along.
-    void destroyDecodedDataIfNecessary(bool destroyAll);
+    // |destroyAll| along. If |keepDecoder| is true, all frames are still
+    // cleared when |destroyAll| is, but the decoder is kept.
+    void destroyDecodedDataIfNecessary(bool destroyAll, bool keepDecoder = false);
 
     // Generally called by destroyDecodedData(), destroys whole-image metadata
     // and notifies observers that the memory footprint has (hopefully)
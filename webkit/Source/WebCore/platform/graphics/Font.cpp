@@ -172,15 +172,40 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
         return floatWidthUsingSVGFont(run);
 #endif
 
+    // Breaking lines measures the same words again on every layout. A word's
+    // width doesn't depend on where it is unless tabs, justification or spacing
+    // come into play, so remember the widths of short runs.
+    bool useWidthCache = !fallbackFonts && !glyphOverflow && canUseWidthCache(run);
+    float width;
+    if (useWidthCache && m_fontList->widthCache().lookup(run.characters(), run.length(), width))
+        return width;
+
     CodePath codePathToUse = codePath(run);
     if (codePathToUse != Complex) {
         // If the complex text implementation cannot return fallback fonts, avoid
         // returning them for simple text as well.
         static bool returnFallbackFonts = canReturnFallbackFontsForComplexText();
-        return floatWidthForSimpleText(run, 0, returnFallbackFonts ? fallbackFonts : 0, codePathToUse == SimpleWithGlyphOverflow || (glyphOverflow && glyphOverflow->computeBounds) ? glyphOverflow : 0);
-    }
+        width = floatWidthForSimpleText(run, 0, returnFallbackFonts ? fallbackFonts : 0, codePathToUse == SimpleWithGlyphOverflow || (glyphOverflow && glyphOverflow->computeBounds) ? glyphOverflow : 0);
+    } else
+        width = floatWidthForComplexText(run, fallbackFonts, glyphOverflow);
+
+    // The widths measured while web fonts load are replaced once they have loaded.
+    if (useWidthCache && !m_fontList->loadingCustomFonts())
+        m_fontList->widthCache().add(run.characters(), run.length(), width);
+    return width;
+}
 
-    return floatWidthForComplexText(run, fallbackFonts, glyphOverflow);
+bool Font::canUseWidthCache(const TextRun& run) const
+{
+    if (!run.length() || static_cast<unsigned>(run.length()) > WidthCache::maxRunLength)
+        return false;
+    if (run.allowTabs() || run.expansion() || run.rtl() || run.directionalOverride() || run.spacingDisabled())
+        return false;
+#if ENABLE(SVG)
+    if (run.horizontalGlyphStretch() != 1)
+        return false;
+#endif
+    return m_fontList && !letterSpacing() && !wordSpacing();
 }
 
 float Font::width(const TextRun& run, int extraCharsAvailable, int& charsConsumed, String& glyphName) const
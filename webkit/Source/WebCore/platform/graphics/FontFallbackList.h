@@ -24,6 +24,8 @@
 #include "FontSelector.h"
 #include "SimpleFontData.h"
 #include <wtf/Forward.h>
+#include <wtf/HashMap.h>
+#include <wtf/StringHasher.h>
 
 namespace WebCore {
 
@@ -37,6 +39,91 @@ class FontSelector;
 
 const int cAllFamiliesScanned = -1;
 
+// Widths of short runs of text, keyed by their characters. Laying out lines
+// measures the same words over and over; see Font::width().
+class WidthCache {
+    WTF_MAKE_NONCOPYABLE(WidthCache);
+public:
+    static const unsigned maxRunLength = 15;
+
+    WidthCache() { }
+
+    bool lookup(const UChar* characters, unsigned length, float& width) const
+    {
+        if (m_widths.isEmpty())
+            return false;
+        Map::const_iterator it = m_widths.find(Key(characters, length));
+        if (it == m_widths.end())
+            return false;
+        width = it->second;
+        return true;
+    }
+
+    void add(const UChar* characters, unsigned length, float width)
+    {
+        // Keeping track of which widths were used last would cost more than
+        // measuring the occasional word again, so start over once full.
+        if (m_widths.size() >= maxSize)
+            m_widths.clear();
+        m_widths.set(Key(characters, length), width);
+    }
+
+    void clear() { m_widths.clear(); }
+
+private:
+    static const unsigned maxSize = 1024;
+
+    // Keeps the characters inline so that looking up a width doesn't allocate.
+    class Key {
+    public:
+        Key()
+            : m_length(0)
+            , m_hash(0)
+        {
+        }
+
+        Key(WTF::HashTableDeletedValueType)
+            : m_length(deletedValueLength)
+            , m_hash(0)
+        {
+        }
+
+        Key(const UChar* characters, unsigned length)
+            : m_length(length)
+            , m_hash(StringHasher::computeHash(characters, length))
+        {
+            ASSERT(length && length <= maxRunLength);
+            memcpy(m_characters, characters, length * sizeof(UChar));
+        }
+
+        bool isHashTableDeletedValue() const { return m_length == deletedValueLength; }
+        unsigned hash() const { return m_hash; }
+
+        bool operator==(const Key& other) const
+        {
+            if (m_length != other.m_length || m_hash != other.m_hash)
+                return false;
+            return m_length > maxRunLength || !memcmp(m_characters, other.m_characters, m_length * sizeof(UChar));
+        }
+
+    private:
+        static const unsigned deletedValueLength = maxRunLength + 1;
+
+        unsigned m_length;
+        unsigned m_hash;
+        UChar m_characters[maxRunLength];
+    };
+
+    struct KeyHash {
+        static unsigned hash(const Key& key) { return key.hash(); }
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = true;
+    };
+
+    typedef HashMap<Key, float, KeyHash, WTF::SimpleClassHashTraits<Key> > Map;
+    Map m_widths;
+};
+
 class FontFallbackList : public RefCounted<FontFallbackList> {
 public:
     static PassRefPtr<FontFallbackList> create() { return adoptRef(new FontFallbackList()); }
@@ -52,6 +139,8 @@ public:
     FontSelector* fontSelector() const { return m_fontSelector.get(); }
     unsigned generation() const { return m_generation; }
 
+    WidthCache& widthCache() const { return m_widthCache; }
+
 private:
     FontFallbackList();
 
@@ -79,6 +168,7 @@ private:
     mutable Pitch m_pitch;
     mutable bool m_loadingCustomFonts;
     unsigned m_generation;
+    mutable WidthCache m_widthCache;
 
     friend class Font;
 };
@@ -38,6 +38,7 @@ protected:
     virtual ~ImageObserver() {}
 public:
     virtual void decodedSizeChanged(const Image*, int delta) = 0;
+    virtual void didDecode(const Image*, double decodeTime) = 0; // In seconds.
     virtual void didDraw(const Image*) = 0;
 
     virtual bool shouldPauseAnimation(const Image*) = 0;
@@ -672,6 +672,7 @@ bool GraphicsLayerAndroid::paintContext(SkPicture* context,
         return false;
 
     PlatformGraphicsContext platformContext(canvas);
+    platformContext.setDefersImageDecoding(true);
     GraphicsContext graphicsContext(&platformContext);
 
     paintGraphicsLayerContents(graphicsContext, rect);
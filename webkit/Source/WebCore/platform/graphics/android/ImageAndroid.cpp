@@ -30,6 +30,8 @@
 #include "Image.h"
 #include "FloatRect.h"
 #include "GraphicsContext.h"
+#include "ImageDecodingService.h"
+#include "ImageObserver.h"
 #include "PlatformGraphicsContext.h"
 #include "PlatformString.h"
 #include "SharedBuffer.h"
@@ -172,6 +174,23 @@ static void round_scaled(SkIRect* dst, const WebCore::FloatRect& src,
              SkScalarRound(SkFloatToScalar((src.y() + src.height()) * sy)));
 }
 
+// If the ImageDecodingService is still decoding the pixels, recording them
+// would make the tile painter wait for them, so we leave the image out and
+// draw it again once they are ready.
+static bool deferDrawingUntilDecoded(GraphicsContext* ctxt, SkPixelRef* pixelRef, Image* image)
+{
+    ImageDecodingService& decodingService = ImageDecodingService::shared();
+    if (ctxt->platformContext()->defersImageDecoding() && decodingService.isDecoding(pixelRef)) {
+        decodingService.repaintWhenDecoded(pixelRef, image);
+        return true;
+    }
+    decodingService.didDraw(pixelRef);
+    double decodeTime;
+    if (decodingService.takeDecodeTime(pixelRef, decodeTime) && image->imageObserver())
+        image->imageObserver()->didDecode(image, decodeTime);
+    return false;
+}
+
 static inline void fixPaintForBitmapsThatMaySeam(SkPaint* paint) {
     /*  Bitmaps may be drawn to seem next to other images. If we are drawn
         zoomed, or at fractional coordinates, we may see cracks/edges if
@@ -207,6 +226,9 @@ void BitmapImage::draw(GraphicsContext* ctxt, const FloatRect& dstRect,
         return;
     }
 
+    if (deferDrawingUntilDecoded(ctxt, bitmap.pixelRef(), this))
+        return;
+
     SkIRect srcR;
     SkRect  dstR(dstRect);
     float invScaleX = (float)bitmap.width() / image->origWidth();
@@ -264,6 +286,9 @@ void Image::drawPattern(GraphicsContext* ctxt, const FloatRect& srcRect,
         return;
     }
 
+    if (deferDrawingUntilDecoded(ctxt, origBitmap.pixelRef(), this))
+        return;
+
     SkRect  dstR(destRect);
     if (dstR.isEmpty()) {
         return;
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ImageDecodingService.h"
+
+#include "Image.h"
+#include "ImageObserver.h"
+#include "IntRect.h"
+#include "SkPixelRef.h"
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// SkImageRef serializes decoding behind a global mutex, so more threads than
+// this mostly wait for each other.
+static const unsigned workerThreadCount = 2;
+
+#ifdef ANDROID_LARGE_MEMORY_DEVICE
+static const size_t defaultBudget = 32 * 1024 * 1024;
+#else
+static const size_t defaultBudget = 8 * 1024 * 1024;
+#endif
+
+ImageDecodingService::DecodeTask::DecodeTask(SkPixelRef* pixelRef, unsigned sequence)
+    : pixelRef(pixelRef)
+    , sequence(sequence)
+    , decodeTime(0)
+    , succeeded(false)
+{
+    pixelRef->ref();
+}
+
+ImageDecodingService::DecodeTask::~DecodeTask()
+{
+    pixelRef->unref();
+}
+
+ImageDecodingService::ImageDecodingService()
+    : m_decodedBytes(0)
+    , m_budget(defaultBudget)
+    , m_lastSequence(0)
+    , m_startedWorkers(false)
+{
+}
+
+ImageDecodingService& ImageDecodingService::shared()
+{
+    ASSERT(isMainThread());
+    static ImageDecodingService* service = new ImageDecodingService;
+    return *service;
+}
+
+void ImageDecodingService::decode(SkPixelRef* pixelRef, size_t byteSize)
+{
+    // An image that doesn't fit in the budget would only push everything else
+    // out of it, so we leave it to be decoded when it is drawn.
+    if (!pixelRef || byteSize > m_budget || m_entries.contains(pixelRef))
+        return;
+
+    if (!m_startedWorkers) {
+        m_startedWorkers = true;
+        for (unsigned i = 0; i < workerThreadCount; ++i)
+            createThread(ImageDecodingService::workerThreadStart, this, "WebCore: ImageDecoder");
+    }
+
+    Entry entry;
+    entry.sequence = ++m_lastSequence;
+    entry.byteSize = byteSize;
+    pixelRef->ref();
+    m_entries.set(pixelRef, entry);
+    m_queue.append(adoptPtr(new DecodeTask(pixelRef, entry.sequence)));
+}
+
+class SamePixelRefPredicate {
+public:
+    SamePixelRefPredicate(SkPixelRef* pixelRef) : m_pixelRef(pixelRef) { }
+    template<typename Task> bool operator()(Task* task) const { return task->pixelRef == m_pixelRef; }
+private:
+    SkPixelRef* m_pixelRef;
+};
+
+void ImageDecodingService::discard(SkPixelRef* pixelRef)
+{
+    if (!pixelRef)
+        return;
+    EntryMap::iterator it = m_entries.find(pixelRef);
+    if (it == m_entries.end())
+        return;
+
+    if (it->second.state == Decoded) {
+        m_decodedBytes -= it->second.byteSize;
+        m_decodedPixelRefs.remove(pixelRef);
+        pixelRef->unlockPixels();
+    } else {
+        // If a worker has already started on it, finishDecode() unlocks it.
+        SamePixelRefPredicate predicate(pixelRef);
+        m_queue.removeIf(predicate);
+    }
+    m_entries.remove(it);
+
+    repaintWaitingImages(pixelRef);
+    pixelRef->unref();
+}
+
+bool ImageDecodingService::isDecoding(SkPixelRef* pixelRef) const
+{
+    if (!pixelRef)
+        return false;
+    EntryMap::const_iterator it = m_entries.find(pixelRef);
+    return it != m_entries.end() && it->second.state == Decoding;
+}
+
+void ImageDecodingService::repaintWhenDecoded(SkPixelRef* pixelRef, Image* image)
+{
+    ASSERT(isDecoding(pixelRef));
+    m_waitingImages.set(image, pixelRef);
+}
+
+void ImageDecodingService::cancelRepaint(Image* image)
+{
+    m_waitingImages.remove(image);
+}
+
+void ImageDecodingService::didDraw(SkPixelRef* pixelRef)
+{
+    if (!pixelRef || !m_decodedPixelRefs.contains(pixelRef))
+        return;
+    m_decodedPixelRefs.remove(pixelRef);
+    m_decodedPixelRefs.add(pixelRef);
+}
+
+bool ImageDecodingService::takeDecodeTime(SkPixelRef* pixelRef, double& decodeTime)
+{
+    if (!pixelRef)
+        return false;
+    EntryMap::iterator it = m_entries.find(pixelRef);
+    if (it == m_entries.end() || it->second.state != Decoded || it->second.reportedDecodeTime)
+        return false;
+    it->second.reportedDecodeTime = true;
+    decodeTime = it->second.decodeTime;
+    return true;
+}
+
+void ImageDecodingService::setBudget(size_t budget)
+{
+    m_budget = budget;
+    releaseLeastRecentlyDrawn();
+}
+
+void* ImageDecodingService::workerThreadStart(void* service)
+{
+    static_cast<ImageDecodingService*>(service)->runWorker();
+    return 0;
+}
+
+void ImageDecodingService::runWorker()
+{
+    while (OwnPtr<DecodeTask> task = m_queue.waitForMessage()) {
+        // SkImageRef decodes when its pixels are first locked. The main thread
+        // unlocks them when it no longer wants to keep them.
+        double startTime = currentTime();
+        task->pixelRef->lockPixels();
+        task->succeeded = task->pixelRef->pixels();
+        task->decodeTime = currentTime() - startTime;
+        callOnMainThread(ImageDecodingService::didDecode, task.leakPtr());
+    }
+}
+
+void ImageDecodingService::didDecode(void* context)
+{
+    OwnPtr<DecodeTask> task = adoptPtr(static_cast<DecodeTask*>(context));
+    shared().finishDecode(task.get());
+}
+
+void ImageDecodingService::finishDecode(DecodeTask* task)
+{
+    SkPixelRef* pixelRef = task->pixelRef;
+    EntryMap::iterator it = m_entries.find(pixelRef);
+    if (it == m_entries.end() || it->second.sequence != task->sequence) {
+        // It was discarded while we were decoding it.
+        pixelRef->unlockPixels();
+        return;
+    }
+
+    if (task->succeeded) {
+        it->second.state = Decoded;
+        it->second.decodeTime = task->decodeTime;
+        m_decodedBytes += it->second.byteSize;
+        m_decodedPixelRefs.add(pixelRef);
+        releaseLeastRecentlyDrawn();
+    } else {
+        pixelRef->unlockPixels();
+        m_entries.remove(it);
+        pixelRef->unref();
+    }
+
+    repaintWaitingImages(pixelRef);
+}
+
+void ImageDecodingService::repaintWaitingImages(SkPixelRef* pixelRef)
+{
+    Vector<Image*> images;
+    HashMap<Image*, SkPixelRef*>::iterator end = m_waitingImages.end();
+    for (HashMap<Image*, SkPixelRef*>::iterator it = m_waitingImages.begin(); it != end; ++it) {
+        if (it->second == pixelRef)
+            images.append(it->first);
+    }
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        // Repainting one image can destroy another, which cancels its repaint.
+        HashMap<Image*, SkPixelRef*>::iterator it = m_waitingImages.find(images[i]);
+        if (it == m_waitingImages.end() || it->second != pixelRef)
+            continue;
+        m_waitingImages.remove(it);
+        Image* image = images[i];
+        if (ImageObserver* observer = image->imageObserver())
+            observer->changedInRect(image, IntRect(IntPoint(), image->size()));
+    }
+}
+
+void ImageDecodingService::releaseLeastRecentlyDrawn()
+{
+    while (m_decodedBytes > m_budget && !m_decodedPixelRefs.isEmpty())
+        discard(m_decodedPixelRefs.first());
+}
+
+} // namespace WebCore
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ImageDecodingService_h
+#define ImageDecodingService_h
+
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/MessageQueue.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Threading.h>
+
+class SkPixelRef;
+
+namespace WebCore {
+
+class Image;
+
+// Decodes the pixels of complete images on a pool of worker threads, so that
+// the tiles that draw them don't have to wait for SkImageRef to decode them.
+// Decoded pixels stay locked until the budget, which is shared by every image
+// in the process, needs the room for images drawn more recently, or until the
+// image's ImageSource lets go of them. All of the functions below must be
+// called on the main thread.
+class ImageDecodingService {
+    WTF_MAKE_NONCOPYABLE(ImageDecodingService); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static ImageDecodingService& shared();
+
+    void decode(SkPixelRef*, size_t byteSize);
+    // Images waiting for |pixelRef| to be decoded are asked to repaint right
+    // away, and then draw it without the service's help.
+    void discard(SkPixelRef*);
+
+    // Whether |pixelRef| is waiting for or being decoded.
+    bool isDecoding(SkPixelRef*) const;
+
+    // Asks |image|'s observer to repaint it once |pixelRef| is decoded, or
+    // once the decode is discarded. ~BitmapImage() calls cancelRepaint().
+    void repaintWhenDecoded(SkPixelRef*, Image*);
+    void cancelRepaint(Image*);
+
+    // Keeps |pixelRef| decoded in favor of the images drawn before it.
+    void didDraw(SkPixelRef*);
+
+    // Returns true and sets |decodeTime| to the time a worker spent decoding
+    // |pixelRef|, once per decode, so that the image can report it.
+    bool takeDecodeTime(SkPixelRef*, double& decodeTime);
+
+    size_t budget() const { return m_budget; }
+    void setBudget(size_t);
+
+private:
+    ImageDecodingService();
+
+    // Holds a reference to |pixelRef| until it is done with it.
+    struct DecodeTask {
+        WTF_MAKE_NONCOPYABLE(DecodeTask); WTF_MAKE_FAST_ALLOCATED;
+    public:
+        DecodeTask(SkPixelRef*, unsigned sequence);
+        ~DecodeTask();
+
+        SkPixelRef* pixelRef;
+        unsigned sequence;
+        double decodeTime;
+        bool succeeded;
+    };
+
+    enum State {
+        Decoding,
+        Decoded
+    };
+
+    struct Entry {
+        Entry() : sequence(0), byteSize(0), decodeTime(0), state(Decoding), reportedDecodeTime(false) { }
+        unsigned sequence;
+        size_t byteSize;
+        double decodeTime;
+        State state;
+        bool reportedDecodeTime;
+    };
+
+    static void* workerThreadStart(void*);
+    void runWorker();
+    static void didDecode(void*);
+    void finishDecode(DecodeTask*);
+    void repaintWaitingImages(SkPixelRef*);
+    void releaseLeastRecentlyDrawn();
+
+    typedef HashMap<SkPixelRef*, Entry> EntryMap;
+    EntryMap m_entries;
+    ListHashSet<SkPixelRef*> m_decodedPixelRefs; // Least recently drawn first.
+    HashMap<Image*, SkPixelRef*> m_waitingImages;
+    size_t m_decodedBytes;
+    size_t m_budget;
+    unsigned m_lastSequence;
+    bool m_startedWorkers;
+    MessageQueue<DecodeTask> m_queue;
+};
+
+} // namespace WebCore
+
+#endif // ImageDecodingService_h
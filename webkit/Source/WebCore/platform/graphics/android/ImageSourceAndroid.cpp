@@ -25,6 +25,7 @@
 
 #include "config.h"
 #include "BitmapAllocatorAndroid.h"
+#include "ImageDecodingService.h"
 #include "ImageSource.h"
 #include "IntSize.h"
 #include "NotImplemented.h"
@@ -141,6 +142,8 @@ ImageSource::ImageSource(AlphaOption alphaOption, GammaAndColorProfileOption gam
 }
 
 ImageSource::~ImageSource() {
+    if (m_decoder.m_image)
+        ImageDecodingService::shared().discard(m_decoder.m_image->bitmap().pixelRef());
     delete m_decoder.m_image;
 #ifdef ANDROID_ANIMATED_GIF
     delete m_decoder.m_gifDecoder;
@@ -306,6 +309,7 @@ void ImageSource::setData(SharedBuffer* data, bool allDataReceived)
 
         SkBitmap* bm = &decoder->bitmap();
         SkPixelRef* ref = convertToRLE(bm, data->data(), data->size());
+        bool decodesLazily = !ref;
 
         if (ref) {
             bm->setPixelRef(ref)->unref();
@@ -321,6 +325,10 @@ void ImageSource::setData(SharedBuffer* data, bool allDataReceived)
         ref->setImmutable();
         // give it the URL if we have one
         ref->setURI(m_decoder.m_url);
+
+        // Get the decoding done before the image is drawn.
+        if (decodesLazily)
+            ImageDecodingService::shared().decode(ref, bm->getSize());
     }
 }
 
@@ -458,6 +466,10 @@ bool ImageSource::frameIsCompleteAtIndex(size_t index)
 
 void ImageSource::clear(bool destroyAll, size_t clearBeforeFrame, SharedBuffer* data, bool allDataReceived)
 {
+    // The pixels are decoded again when they are next drawn.
+    if (destroyAll && m_decoder.m_image)
+        ImageDecodingService::shared().discard(m_decoder.m_image->bitmap().pixelRef());
+
 #ifdef ANDROID_ANIMATED_GIF
     if (!destroyAll) {
         if (m_decoder.m_gifDecoder)
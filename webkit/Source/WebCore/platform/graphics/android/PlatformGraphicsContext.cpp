@@ -38,6 +38,7 @@ PlatformGraphicsContext::PlatformGraphicsContext(SkCanvas* canvas)
         : mCanvas(canvas), m_deleteCanvas(false)
         , m_canvasState(DEFAULT)
         , m_picture(0)
+        , m_defersImageDecoding(false)
 {
 }
 
@@ -46,6 +47,7 @@ PlatformGraphicsContext::PlatformGraphicsContext()
 //    , m_buttons(0)
     , m_canvasState(DEFAULT)
     , m_picture(0)
+    , m_defersImageDecoding(false)
 {
 }
 
@@ -53,6 +55,7 @@ PlatformGraphicsContext::PlatformGraphicsContext(int width, int height)
     : m_deleteCanvas(false)
     , m_canvasState(RECORDING)
     , m_picture(new SkPicture)
+    , m_defersImageDecoding(false)
 {
     mCanvas = m_picture->beginRecording(width, height, 0);
 }
@@ -78,12 +78,19 @@ public:
 
     void setIsAnimating();
 
+    // Whether images whose pixels are still being decoded can be left out and
+    // drawn again later. This is the case for the pictures the tiles are
+    // painted from, but not for pixels JavaScript can read back.
+    bool defersImageDecoding() const { return m_defersImageDecoding; }
+    void setDefersImageDecoding(bool defersImageDecoding) { m_defersImageDecoding = defersImageDecoding; }
+
 private:
     bool m_deleteCanvas;
     enum CanvasState m_canvasState;
 
     SkPicture* m_picture;
 
+    bool m_defersImageDecoding;
 };
 
 }
@@ -281,19 +281,25 @@ template <MatchType type> int getScaledValue(const Vector<int>& scaledValues, in
 }
 
 void ImageDecoder::prepareScaleDataIfNecessary()
+{
+    prepareScaleDataIfNecessary(size());
+}
+
+void ImageDecoder::prepareScaleDataIfNecessary(const IntSize& decodedSize)
 {
     m_scaled = false;
     m_scaledColumns.clear();
     m_scaledRows.clear();
 
-    int width = size().width();
-    int height = size().height();
+    int width = decodedSize.width();
+    int height = decodedSize.height();
     int numPixels = height * width;
-    if (m_maxNumPixels <= 0 || numPixels <= m_maxNumPixels)
+    bool needsSampling = m_maxNumPixels > 0 && numPixels > m_maxNumPixels;
+    if (!needsSampling && decodedSize == size())
         return;
 
     m_scaled = true;
-    double scale = sqrt(m_maxNumPixels / (double)numPixels);
+    double scale = needsSampling ? sqrt(m_maxNumPixels / (double)numPixels) : 1;
     fillScaledValues(m_scaledColumns, scale, width);
     fillScaledValues(m_scaledRows, scale, height);
 }
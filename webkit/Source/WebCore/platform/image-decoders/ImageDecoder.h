@@ -322,10 +322,15 @@ namespace WebCore {
 
 #if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
         void setMaxNumPixels(int m) { m_maxNumPixels = m; }
+        int maxNumPixels() const { return m_maxNumPixels; }
 #endif
 
     protected:
         void prepareScaleDataIfNecessary();
+        // For decoders that can produce pixels at a smaller size than size()
+        // to begin with, |decodedSize| is the size they produce them at. The
+        // scaled rows and columns then index into the decoded pixels.
+        void prepareScaleDataIfNecessary(const IntSize& decodedSize);
         int upperBoundScaledX(int origX, int searchStart = 0);
         int lowerBoundScaledX(int origX, int searchStart = 0);
         int upperBoundScaledY(int origY, int searchStart = 0);
@@ -29,6 +29,10 @@
 
 namespace WebCore {
 
+// How much memory clearFrameBufferCache() may spend on keeping frames that
+// cleared frames can be decoded again from.
+static const size_t cMaxKeyframeBytes = 2 * 1024 * 1024;
+
 GIFImageDecoder::GIFImageDecoder(ImageSource::AlphaOption alphaOption,
                                  ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
     : ImageDecoder(alphaOption, gammaAndColorProfileOption)
@@ -124,8 +128,16 @@ ImageFrame* GIFImageDecoder::frameBufferAtIndex(size_t index)
         return 0;
 
     ImageFrame& frame = m_frameBufferCache[index];
-    if (frame.status() != ImageFrame::FrameComplete)
+    if (frame.status() != ImageFrame::FrameComplete) {
+        // If clearFrameBufferCache() has thrown away frames we need, the
+        // reader is somewhere past them.  Rather than starting over from the
+        // first frame, go back to the last frame we still have.
+        size_t startingFrame = startingFrameFor(index);
+        size_t nextFrame = m_reader ? m_reader->images_decoded : m_frameCheckpoints.size();
+        if ((startingFrame != nextFrame) && (startingFrame < m_frameCheckpoints.size()))
+            rewindToFrame(startingFrame);
         decode(index + 1, GIFFullQuery);
+    }
     return &frame;
 }
 
@@ -177,19 +189,100 @@ void GIFImageDecoder::clearFrameBufferCache(size_t clearBeforeFrame)
             i->clearPixelData();
     }
 
-    // Now |i| holds the last frame we need to preserve; clear prior frames.
+    // Now |i| holds the last frame we need to preserve; clear prior frames,
+    // except for the keyframes frameBufferAtIndex() can decode from if the
+    // cleared ones are asked for again.
     for (Vector<ImageFrame>::iterator j(m_frameBufferCache.begin()); j != i; ++j) {
         ASSERT(j->status() != ImageFrame::FramePartial);
-        if (j->status() != ImageFrame::FrameEmpty)
+        if ((j->status() != ImageFrame::FrameEmpty) && !isKeyframe(j - m_frameBufferCache.begin()))
             j->clearPixelData();
     }
 }
 
+size_t GIFImageDecoder::startingFrameFor(size_t frameIndex) const
+{
+    // Walk back the same way initFrameBuffer() looks for the frame it starts
+    // from, until we find one that is still complete.
+    while (frameIndex) {
+        size_t previousFrame = frameIndex - 1;
+        while (previousFrame && (m_frameBufferCache[previousFrame].disposalMethod() == ImageFrame::DisposeOverwritePrevious))
+            --previousFrame;
+        if (m_frameBufferCache[previousFrame].status() == ImageFrame::FrameComplete)
+            break;
+        frameIndex = previousFrame;
+    }
+    return frameIndex;
+}
+
+void GIFImageDecoder::rewindToFrame(size_t frameIndex)
+{
+    if (failed())
+        return;
+
+    // A frame we stop decoding partway through has to be started over, as
+    // initFrameBuffer() only sets up empty frames.
+    if (m_reader && (m_reader->images_decoded < m_frameBufferCache.size())) {
+        ImageFrame& buffer = m_frameBufferCache[m_reader->images_decoded];
+        if (buffer.status() == ImageFrame::FramePartial)
+            buffer.clearPixelData();
+    }
+
+    if (!m_reader) {
+        // gifComplete() has thrown the reader away.  A new one needs the
+        // global colormap again, which comes before the first image header.
+        m_reader.set(new GIFImageReader(this));
+        m_reader->read((const unsigned char*)m_data->data(), m_data->size(), GIFFullQuery, 0);
+        if (!m_reader)
+            return;
+    }
+
+    m_reader->rewind_to_frame(frameIndex, m_frameCheckpoints[frameIndex]);
+    m_readOffset = m_frameCheckpoints[frameIndex].readOffset;
+}
+
+bool GIFImageDecoder::isKeyframe(size_t frameIndex) const
+{
+    const ImageFrame& buffer = m_frameBufferCache[frameIndex];
+    if (buffer.disposalMethod() == ImageFrame::DisposeOverwritePrevious)
+        return false; // No later frame starts from this one.
+
+    const size_t frameBytes = scaledSize().width() * scaledSize().height() * sizeof(ImageFrame::PixelData);
+    const size_t maxKeyframes = frameBytes ? cMaxKeyframeBytes / frameBytes : 0;
+    if (!maxKeyframes)
+        return false;
+
+    // Keep evenly spaced frames, as many as fit.  The spacing is a power of
+    // two so that as more frames arrive, the keyframes stay a subset of the
+    // ones we kept before.
+    size_t interval = 1;
+    while (m_frameBufferCache.size() > interval * maxKeyframes)
+        interval *= 2;
+    return !(frameIndex % interval);
+}
+
 void GIFImageDecoder::decodingHalted(unsigned bytesLeft)
 {
     m_readOffset = m_data->size() - bytesLeft;
 }
 
+void GIFImageDecoder::frameStarted(unsigned frameIndex, unsigned bytesLeft)
+{
+    if (frameIndex > m_frameCheckpoints.size())
+        return;
+
+    const GIFFrameReader* frameReader = m_reader->frame_reader;
+    FrameCheckpoint checkpoint;
+    checkpoint.readOffset = m_data->size() - bytesLeft;
+    checkpoint.delayTime = frameReader->delay_time;
+    checkpoint.transparentPixel = frameReader->tpixel;
+    checkpoint.isTransparent = frameReader->is_transparent;
+    checkpoint.disposalMethod = frameReader->disposal_method;
+    if (frameIndex == m_frameCheckpoints.size())
+        m_frameCheckpoints.append(checkpoint);
+    else
+        m_frameCheckpoints[frameIndex] = checkpoint;
+}
+
 bool GIFImageDecoder::haveDecodedRow(unsigned frameIndex, unsigned char* rowBuffer, unsigned char* rowEnd, unsigned rowNumber, unsigned repeatCount, bool writeTransparentPixels)
 {
     const GIFFrameReader* frameReader = m_reader->frame_reader;
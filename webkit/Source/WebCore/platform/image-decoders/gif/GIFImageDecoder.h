@@ -41,6 +41,17 @@ namespace WebCore {
 
         enum GIFQuery { GIFFullQuery, GIFSizeQuery, GIFFrameCountQuery };
 
+        // What the reader needs to start decoding a frame over again: where
+        // its image header is, and the graphic control extension values that
+        // came before it.
+        struct FrameCheckpoint {
+            unsigned readOffset;
+            unsigned delayTime;
+            int transparentPixel;
+            bool isTransparent;
+            ImageFrame::FrameDisposalMethod disposalMethod;
+        };
+
         // ImageDecoder
         virtual String filenameExtension() const { return "gif"; }
         virtual void setData(SharedBuffer* data, bool allDataReceived);
@@ -57,6 +68,7 @@ namespace WebCore {
 
         // Callbacks from the GIF reader.
         void decodingHalted(unsigned bytesLeft);
+        void frameStarted(unsigned frameIndex, unsigned bytesLeft);
         bool haveDecodedRow(unsigned frameIndex, unsigned char* rowBuffer, unsigned char* rowEnd, unsigned rowNumber, unsigned repeatCount, bool writeTransparentPixels);
         bool frameComplete(unsigned frameIndex, unsigned frameDuration, ImageFrame::FrameDisposalMethod disposalMethod);
         void gifComplete();
@@ -73,11 +85,23 @@ namespace WebCore {
         // failure, this will mark the image as failed.
         bool initFrameBuffer(unsigned frameIndex);
 
+        // Returns the first frame we need to decode to get to |frameIndex|,
+        // given the frames still in the cache to build upon.
+        size_t startingFrameFor(size_t frameIndex) const;
+
+        // Makes the next decode() start at the image header of |frameIndex|.
+        void rewindToFrame(size_t frameIndex);
+
+        // Whether clearFrameBufferCache() keeps |frameIndex| around for later
+        // frames to be decoded from.
+        bool isKeyframe(size_t frameIndex) const;
+
         bool m_alreadyScannedThisDataForFrameCount;
         bool m_currentBufferSawAlpha;
         mutable int m_repetitionCount;
         OwnPtr<GIFImageReader> m_reader;
         unsigned m_readOffset;
+        Vector<FrameCheckpoint> m_frameCheckpoints;
     };
 
 } // namespace WebCore
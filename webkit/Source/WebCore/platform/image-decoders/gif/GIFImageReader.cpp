@@ -762,6 +762,11 @@ bool GIFImageReader::read(const unsigned char *buf, unsigned len,
       if (query == GIFImageDecoder::GIFFullQuery && !frame_reader)
         frame_reader = new GIFFrameReader();
 
+      // CALLBACK: Let the decoder know where this frame starts, so that it
+      // can come back to it.
+      if (clientptr && frame_reader)
+        clientptr->frameStarted(images_decoded, len + 9);
+
       if (frame_reader) {
         frame_reader->x_offset = x_offset;
         frame_reader->y_offset = y_offset;
@@ -923,3 +928,21 @@ bool GIFImageReader::read(const unsigned char *buf, unsigned len,
     clientptr->decodingHalted(0);
   return false;
 }
+
+void GIFImageReader::rewind_to_frame(unsigned frame_index, const WebCore::GIFImageDecoder::FrameCheckpoint& checkpoint)
+{
+  state = gif_image_header;
+  bytes_to_consume = 9;
+  bytes_in_hold = 0;
+  count = 0;
+  images_decoded = frame_index;
+  images_count = frame_index;
+
+  if (!frame_reader)
+    frame_reader = new GIFFrameReader();
+
+  frame_reader->delay_time = checkpoint.delayTime;
+  frame_reader->tpixel = checkpoint.transparentPixel;
+  frame_reader->is_transparent = checkpoint.isTransparent;
+  frame_reader->disposal_method = checkpoint.disposalMethod;
+}
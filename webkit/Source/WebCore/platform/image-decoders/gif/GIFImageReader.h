@@ -201,6 +201,10 @@ struct GIFImageReader {
     bool read(const unsigned char * buf, unsigned int numbytes, 
               WebCore::GIFImageDecoder::GIFQuery query = WebCore::GIFImageDecoder::GIFFullQuery, unsigned haltAtFrame = -1);
 
+    // Sets up the state machine to read the image header of frame
+    // |frame_index| next.  The caller hands read() the data from there on.
+    void rewind_to_frame(unsigned frame_index, const WebCore::GIFImageDecoder::FrameCheckpoint& checkpoint);
+
 private:
     bool output_row();
     bool do_lzw(const unsigned char *q);
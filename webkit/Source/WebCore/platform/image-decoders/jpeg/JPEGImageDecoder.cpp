@@ -237,8 +237,18 @@ public:
             // image is a sequential JPEG.
             m_info.buffered_image = jpeg_has_multiple_scans(&m_info);
 
+            // We can fill in the size now that the header is available.
+            if (!m_decoder->setSize(m_info.image_width, m_info.image_height))
+                return false;
+
+            // When we're going to downsample the image anyway, libjpeg can
+            // skip most of the IDCT by decoding at a fraction of the size.
+            m_info.scale_num = 1;
+            m_info.scale_denom = m_decoder->desiredScaleDenominator();
+
             // Used to set up image size so arrays can be allocated.
             jpeg_calc_output_dimensions(&m_info);
+            m_decoder->setDecodedSize(m_info.output_width, m_info.output_height);
 
             // Make a one-row-high sample array that will go away when done with
             // image. Always make it big enough to hold an RGB row.  Since this
@@ -248,10 +258,6 @@ public:
 
             m_state = JPEG_START_DECOMPRESS;
 
-            // We can fill in the size now that the header is available.
-            if (!m_decoder->setSize(m_info.image_width, m_info.image_height))
-                return false;
-
             if (!m_decoder->ignoresGammaAndColorProfile())
                 m_decoder->setColorProfile(readColorProfile(info()));
 
@@ -422,13 +428,34 @@ bool JPEGImageDecoder::isSizeAvailable()
     return ImageDecoder::isSizeAvailable();
 }
 
-bool JPEGImageDecoder::setSize(unsigned width, unsigned height)
+unsigned JPEGImageDecoder::desiredScaleDenominator() const
 {
-    if (!ImageDecoder::setSize(width, height))
-        return false;
+    unsigned scaleDenominator = 1;
+#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    int maxNumPixels = this->maxNumPixels();
+    if (maxNumPixels <= 0)
+        return scaleDenominator;
+
+    // We stop at the smallest scale that still has |maxNumPixels| pixels and
+    // sample the rest of the way down as before, so the image ends up the
+    // same size as without DCT scaling.
+    unsigned long long width = size().width();
+    unsigned long long height = size().height();
+    while (scaleDenominator < 8) {
+        unsigned nextScaleDenominator = scaleDenominator * 2;
+        unsigned long long scaledWidth = (width + nextScaleDenominator - 1) / nextScaleDenominator;
+        unsigned long long scaledHeight = (height + nextScaleDenominator - 1) / nextScaleDenominator;
+        if (scaledWidth * scaledHeight < static_cast<unsigned long long>(maxNumPixels))
+            break;
+        scaleDenominator = nextScaleDenominator;
+    }
+#endif
+    return scaleDenominator;
+}
 
-    prepareScaleDataIfNecessary();
-    return true;
+void JPEGImageDecoder::setDecodedSize(unsigned width, unsigned height)
+{
+    prepareScaleDataIfNecessary(IntSize(width, height));
 }
 
 ImageFrame* JPEGImageDecoder::frameBufferAtIndex(size_t index)
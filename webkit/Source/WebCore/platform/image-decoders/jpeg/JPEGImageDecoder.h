@@ -43,13 +43,18 @@ namespace WebCore {
         // ImageDecoder
         virtual String filenameExtension() const { return "jpg"; }
         virtual bool isSizeAvailable();
-        virtual bool setSize(unsigned width, unsigned height);
         virtual ImageFrame* frameBufferAtIndex(size_t index);
         // CAUTION: setFailed() deletes |m_reader|.  Be careful to avoid
         // accessing deleted memory, especially when calling this from inside
         // JPEGImageReader!
         virtual bool setFailed();
 
+        // Returns how many times smaller than size() libjpeg should decode
+        // the image: 1, 2, 4 or 8.
+        unsigned desiredScaleDenominator() const;
+        // Tells us the size libjpeg is going to decode the image at.
+        void setDecodedSize(unsigned width, unsigned height);
+
         bool outputScanlines();
         void jpegComplete();
 
@@ -185,7 +185,24 @@ public:
         }
         advanceSlowCase();
     }
-    
+
+    // The characters after the current one that advancePastNonNewlines() can
+    // skip. The last character of the current substring is not included, so
+    // skipping never has to move on to the next substring.
+    const UChar* charactersAfterCurrent() const { return m_pushedChar1 ? 0 : m_currentString.m_current + 1; }
+    unsigned numberOfCharactersAfterCurrent() const { return m_pushedChar1 ? 0 : m_currentString.m_length - 1; }
+
+    // Consumes the current character and the |count| - 1 after it, which
+    // must not be newlines.
+    void advancePastNonNewlines(unsigned count)
+    {
+        ASSERT(count <= numberOfCharactersAfterCurrent());
+        ASSERT(*current() != '\n');
+        m_currentString.m_length -= count;
+        m_currentString.m_current += count;
+        m_currentChar = m_currentString.m_current;
+    }
+
     void advance(int& lineNumber)
     {
         if (!m_pushedChar1 && m_currentString.m_length > 1) {
@@ -40,6 +40,7 @@
 #include "HTMLIFrameElement.h"
 #include "HTMLNames.h"
 #include "HitTestResult.h"
+#include "IntPointHash.h"
 #include "NodeList.h"
 #include "Page.h"
 #include "RenderApplet.h"
@@ -104,6 +105,102 @@ struct CompositingState {
 #endif
 };
 
+// The bounds of the layers composited so far, in absolute coordinates. The bounds
+// are bucketed into a grid of tiles, so that testing a layer for overlap only looks
+// at the layers near it rather than at every composited layer on the page.
+class RenderLayerCompositor::OverlapMap {
+    WTF_MAKE_NONCOPYABLE(OverlapMap); WTF_MAKE_FAST_ALLOCATED;
+public:
+    OverlapMap() { }
+
+    bool isEmpty() const { return m_layers.isEmpty(); }
+
+    void add(RenderLayer* layer, const IntRect& bounds)
+    {
+        if (!m_layers.add(layer).second)
+            return;
+
+        m_rects.append(bounds);
+
+        TileRange range(bounds);
+        if (range.tileCount() > maxTilesPerRect) {
+            // Layers covering much of the page would take up lots of tiles,
+            // and there usually are only a few of them.
+            m_largeRects.append(bounds);
+            return;
+        }
+
+        for (int row = range.firstRow; row <= range.lastRow; ++row) {
+            for (int column = range.firstColumn; column <= range.lastColumn; ++column)
+                m_tiles.add(IntPoint(column, row), Vector<IntRect>()).first->second.append(bounds);
+        }
+    }
+
+    bool overlaps(const IntRect& bounds) const
+    {
+        TileRange range(bounds);
+        if (range.tileCount() > maxTilesPerRect)
+            return intersectsAny(m_rects, bounds);
+
+        if (intersectsAny(m_largeRects, bounds))
+            return true;
+
+        for (int row = range.firstRow; row <= range.lastRow; ++row) {
+            for (int column = range.firstColumn; column <= range.lastColumn; ++column) {
+                TileMap::const_iterator it = m_tiles.find(IntPoint(column, row));
+                if (it != m_tiles.end() && intersectsAny(it->second, bounds))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static const int tileSize = 256;
+    static const int64_t maxTilesPerRect = 64;
+
+    // The tiles a rect touches. Empty rects touch none, just like they never intersect anything.
+    struct TileRange {
+        TileRange(const IntRect& rect)
+            : firstColumn(tileIndex(rect.x()))
+            , lastColumn(tileIndex(rect.maxX() - 1))
+            , firstRow(tileIndex(rect.y()))
+            , lastRow(tileIndex(rect.maxY() - 1))
+        {
+            if (rect.isEmpty()) {
+                lastColumn = firstColumn - 1;
+                lastRow = firstRow - 1;
+            }
+        }
+
+        int64_t tileCount() const { return static_cast<int64_t>(lastColumn - firstColumn + 1) * (lastRow - firstRow + 1); }
+
+        int firstColumn;
+        int lastColumn;
+        int firstRow;
+        int lastRow;
+    };
+
+    static int tileIndex(int coordinate) { return coordinate >= 0 ? coordinate / tileSize : (coordinate + 1) / tileSize - 1; }
+
+    static bool intersectsAny(const Vector<IntRect>& rects, const IntRect& bounds)
+    {
+        size_t size = rects.size();
+        for (size_t i = 0; i < size; ++i) {
+            if (bounds.intersects(rects[i]))
+                return true;
+        }
+        return false;
+    }
+
+    typedef HashMap<IntPoint, Vector<IntRect> > TileMap;
+
+    HashSet<RenderLayer*> m_layers;
+    Vector<IntRect> m_rects;
+    Vector<IntRect> m_largeRects;
+    TileMap m_tiles;
+};
+
 RenderLayerCompositor::RenderLayerCompositor(RenderView* renderView)
     : m_renderView(renderView)
     , m_rootPlatformLayer(0)
@@ -600,15 +697,7 @@ void RenderLayerCompositor::addToOverlapMap(OverlapMap& overlapMap, RenderLayer*
 
 bool RenderLayerCompositor::overlapsCompositedLayers(OverlapMap& overlapMap, const IntRect& layerBounds)
 {
-    RenderLayerCompositor::OverlapMap::const_iterator end = overlapMap.end();
-    for (RenderLayerCompositor::OverlapMap::const_iterator it = overlapMap.begin(); it != end; ++it) {
-        const IntRect& bounds = it->second;
-        if (layerBounds.intersects(bounds)) {
-            return true;
-        }
-    }
-    
-    return false;
+    return overlapMap.overlaps(layerBounds);
 }
 
 #if ENABLE(COMPOSITED_FIXED_ELEMENTS)
@@ -4,6 +4,7 @@ include $(CLEAR_VARS)
 
 # Build the unit tests.
 test_src_files := \
+    ImageDecodingService_test.cpp \
     TreeManager_test.cpp
 
 shared_libraries := \
@@ -26,9 +27,13 @@ c_includes := \
     $(LOCAL_PATH)/../../JavaScriptCore \
     $(LOCAL_PATH)/../../JavaScriptCore/wtf \
     $(LOCAL_PATH)/.. \
+    $(LOCAL_PATH)/../platform \
+    $(LOCAL_PATH)/../platform/text \
     $(LOCAL_PATH)/../platform/graphics \
     $(LOCAL_PATH)/../platform/graphics/transforms \
-    $(LOCAL_PATH)/../platform/graphics/android
+    $(LOCAL_PATH)/../platform/graphics/android \
+    $(LOCAL_PATH)/../../WebKit/android \
+    $(LOCAL_PATH)/../../WebKit/android/jni
 
     # external/webkit/Source/WebCore/platform/graphics/android
 
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <gtest/gtest.h>
+
+#include "BitmapImage.h"
+#include "GraphicsContext.h"
+#include "ImageDecodingService.h"
+#include "ImageObserver.h"
+#include "IntRect.h"
+#include "JavaSharedClient.h"
+#include "PlatformGraphicsContext.h"
+#include "SharedBuffer.h"
+#include "SkBitmapRef.h"
+#include "SkPixelRef.h"
+#include "TimerClient.h"
+
+#include <unistd.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
+#include <wtf/Threading.h>
+
+namespace WebCore {
+
+// A 32x32 green PNG, which ImageSource leaves to be decoded lazily.
+static const unsigned char greenPNG[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+    0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x20,
+    0x08, 0x02, 0x00, 0x00, 0x00, 0xfc, 0x18, 0xed, 0xa3, 0x00, 0x00, 0x00,
+    0x26, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xed, 0xcd, 0xb1, 0x09, 0x00,
+    0x00, 0x08, 0xc0, 0xb0, 0x9e, 0xee, 0xe9, 0x5e, 0xe1, 0x20, 0x04, 0xb2,
+    0xa7, 0xa6, 0x5b, 0x02, 0x81, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x81,
+    0xe0, 0x4b, 0xb0, 0xc2, 0x00, 0x00, 0x1f, 0x60, 0x42, 0x18, 0xac, 0x00,
+    0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+// The workers hand finished decodes to the main thread through
+// JavaSharedClient's queue, which the tests service themselves.
+class TestTimerClient : public android::TimerClient {
+public:
+    void setSharedTimerCallback(void (*)()) { }
+    void setSharedTimer(long long) { }
+    void stopSharedTimer() { }
+    void signalServiceFuncPtrQueue() { }
+};
+
+class TestImageObserver : public ImageObserver {
+public:
+    TestImageObserver()
+        : m_changedCount(0)
+        , m_didDecodeCount(0)
+    {}
+
+    int m_changedCount;
+    IntRect m_changedRect;
+    int m_didDecodeCount;
+
+    void decodedSizeChanged(const Image*, int) { }
+    void didDecode(const Image*, double) { m_didDecodeCount++; }
+    void didDraw(const Image*) { }
+    bool shouldPauseAnimation(const Image*) { return false; }
+    void animationAdvanced(const Image*) { }
+    void changedInRect(const Image*, const IntRect& rect) {
+        m_changedCount++;
+        m_changedRect = rect;
+    }
+};
+
+class ImageDecodingServiceTest : public testing::Test {
+protected:
+    TestImageObserver m_observer;
+
+    static void SetUpTestCase() {
+        WTF::initializeThreading();
+        WTF::initializeMainThread();
+        static TestTimerClient timerClient;
+        android::JavaSharedClient::SetTimerClient(&timerClient);
+    }
+
+    ImageDecodingService& service() {
+        return ImageDecodingService::shared();
+    }
+
+    // All of the image's data arrives at once, which queues its decode.
+    PassRefPtr<BitmapImage> createImage() {
+        RefPtr<BitmapImage> image = BitmapImage::create(&m_observer);
+        image->setData(SharedBuffer::create(reinterpret_cast<const char*>(greenPNG), sizeof(greenPNG)), true);
+        return image.release();
+    }
+
+    SkPixelRef* pixelRef(BitmapImage* image) {
+        return image->nativeImageForCurrentFrame()->bitmap().pixelRef();
+    }
+
+    // Records the image the way tiles are recorded when |defersImageDecoding|.
+    void draw(BitmapImage* image, bool defersImageDecoding) {
+        PlatformGraphicsContext platformContext(image->width(), image->height());
+        platformContext.setDefersImageDecoding(defersImageDecoding);
+        GraphicsContext context(&platformContext);
+        context.drawImage(image, ColorSpaceDeviceRGB, IntPoint());
+    }
+
+    // Until the main thread runs the task a worker posted for it, the pixel
+    // ref is still decoding.
+    void waitForDecode(SkPixelRef* pixelRef) {
+        double deadline = currentTime() + 5;
+        while (service().isDecoding(pixelRef) && currentTime() < deadline) {
+            android::JavaSharedClient::ServiceFunctionPtrQueue();
+            usleep(1000);
+        }
+    }
+};
+
+TEST_F(ImageDecodingServiceTest, DeferredDraw_RepaintsWhenDecoded) {
+    RefPtr<BitmapImage> image = createImage();
+    ASSERT_TRUE(service().isDecoding(pixelRef(image.get())));
+
+    // the image is left out, and repainted once its pixels are ready
+    draw(image.get(), true);
+    ASSERT_EQ(m_observer.m_changedCount, 0);
+
+    waitForDecode(pixelRef(image.get()));
+    ASSERT_FALSE(service().isDecoding(pixelRef(image.get())));
+    ASSERT_EQ(m_observer.m_changedCount, 1);
+    ASSERT_EQ(m_observer.m_changedRect, IntRect(IntPoint(), image->size()));
+
+    // now it is drawn, and the decode time is reported once
+    draw(image.get(), true);
+    draw(image.get(), true);
+    ASSERT_EQ(m_observer.m_changedCount, 1);
+    ASSERT_EQ(m_observer.m_didDecodeCount, 1);
+}
+
+TEST_F(ImageDecodingServiceTest, UndeferredDraw_DoesntAskForRepaint) {
+    RefPtr<BitmapImage> image = createImage();
+    ASSERT_TRUE(service().isDecoding(pixelRef(image.get())));
+
+    draw(image.get(), false);
+    waitForDecode(pixelRef(image.get()));
+    ASSERT_EQ(m_observer.m_changedCount, 0);
+}
+
+TEST_F(ImageDecodingServiceTest, DestroyDecodedData_StillRepaints) {
+    RefPtr<BitmapImage> image = createImage();
+    draw(image.get(), true);
+
+    // the memory cache prunes the image while it is decoding, which cancels
+    // the decode but must not lose the repaint
+    Image* cachedImage = image.get();
+    cachedImage->destroyDecodedData(true);
+    ASSERT_FALSE(service().isDecoding(pixelRef(image.get())));
+    ASSERT_EQ(m_observer.m_changedCount, 1);
+
+    // the repaint draws the image without waiting for the service
+    draw(image.get(), true);
+    android::JavaSharedClient::ServiceFunctionPtrQueue();
+    ASSERT_EQ(m_observer.m_changedCount, 1);
+}
+
+TEST_F(ImageDecodingServiceTest, DestroyedImage_DoesntRepaint) {
+    RefPtr<BitmapImage> image = createImage();
+    SkPixelRef* imagePixelRef = pixelRef(image.get());
+    draw(image.get(), true);
+
+    image.clear();
+    ASSERT_FALSE(service().isDecoding(imagePixelRef));
+    android::JavaSharedClient::ServiceFunctionPtrQueue();
+    ASSERT_EQ(m_observer.m_changedCount, 0);
+}
+
+} // namespace WebCore
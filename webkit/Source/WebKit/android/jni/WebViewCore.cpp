@@ -583,6 +583,7 @@ void WebViewCore::recordPicture(SkPicture* picture)
     SkAutoMemoryUsageProbe mup(__FUNCTION__);
 
     WebCore::PlatformGraphicsContext pgc(arp.getRecordingCanvas());
+    pgc.setDefersImageDecoding(true);
     WebCore::GraphicsContext gc(&pgc);
     view->platformWidget()->draw(&gc, WebCore::IntRect(0, 0,
         view->contentsWidth(), view->contentsHeight()));
@@ -847,6 +848,7 @@ SkPicture* WebViewCore::rebuildPicture(const SkIRect& inval)
     SkCanvas* recordingCanvas = arp.getRecordingCanvas();
 
     WebCore::PlatformGraphicsContext pgc(recordingCanvas);
+    pgc.setDefersImageDecoding(true);
     WebCore::GraphicsContext gc(&pgc);
     IntPoint origin = view->minimumScrollPosition();
     WebCore::IntRect drawArea(inval.fLeft + origin.x(), inval.fTop + origin.y(),
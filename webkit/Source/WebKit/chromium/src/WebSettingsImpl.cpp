@@ -363,6 +363,11 @@ void WebSettingsImpl::setHyperlinkAuditingEnabled(bool enabled)
     m_settings->setHyperlinkAuditingEnabled(enabled);
 }
 
+void WebSettingsImpl::setThreadedHTMLParserEnabled(bool enabled)
+{
+    m_settings->setThreadedHTMLParserEnabled(enabled);
+}
+
 void WebSettingsImpl::setAsynchronousSpellCheckingEnabled(bool enabled)
 {
     m_settings->setAsynchronousSpellCheckingEnabled(enabled);
@@ -390,6 +390,7 @@ static bool useQuickLookQuirks(void)
         [NSNumber numberWithBool:NO],   WebKitAsynchronousSpellCheckingEnabledPreferenceKey,
         [NSNumber numberWithBool:NO],   WebKitMemoryInfoEnabledPreferenceKey,
         [NSNumber numberWithBool:YES],  WebKitHyperlinkAuditingEnabledPreferenceKey,
+        [NSNumber numberWithBool:NO],   WebKitThreadedHTMLParserEnabledPreferenceKey,
         [NSNumber numberWithBool:NO],   WebKitUsePreHTML5ParserQuirksKey,
         [NSNumber numberWithBool:useQuickLookQuirks()], WebKitUseQuickLookResourceCachingQuirksPreferenceKey,
         [NSNumber numberWithLongLong:WebCore::ApplicationCacheStorage::noQuota()], WebKitApplicationCacheTotalQuota,
@@ -1404,6 +1405,16 @@ static NSString *classIBCreatorID = nil;
     [self _setBoolValue:flag forKey:WebKitHyperlinkAuditingEnabledPreferenceKey];
 }
 
+- (BOOL)threadedHTMLParserEnabled
+{
+    return [self _boolValueForKey:WebKitThreadedHTMLParserEnabledPreferenceKey];
+}
+
+- (void)setThreadedHTMLParserEnabled:(BOOL)flag
+{
+    [self _setBoolValue:flag forKey:WebKitThreadedHTMLParserEnabledPreferenceKey];
+}
+
 - (WebKitEditingBehavior)editingBehavior
 {
     return static_cast<WebKitEditingBehavior>([self _integerValueForKey:WebKitEditingBehaviorPreferenceKey]);
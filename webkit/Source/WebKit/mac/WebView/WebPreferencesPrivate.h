@@ -210,6 +210,9 @@ extern NSString *WebPreferencesChangedInternalNotification;
 - (BOOL)hyperlinkAuditingEnabled;
 - (void)setHyperlinkAuditingEnabled:(BOOL)enabled;
 
+- (BOOL)threadedHTMLParserEnabled;
+- (void)setThreadedHTMLParserEnabled:(BOOL)enabled;
+
 // Other private methods
 - (void)_postPreferencesChangedNotification;
 - (void)_postPreferencesChangedAPINotification;
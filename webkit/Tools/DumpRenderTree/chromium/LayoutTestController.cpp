@@ -1352,6 +1352,8 @@ void LayoutTestController::overridePreference(const CppArgumentList& arguments,
         prefs->experimentalWebGLEnabled = cppVariantToBool(value);
     else if (key == "WebKitHyperlinkAuditingEnabled")
         prefs->hyperlinkAuditingEnabled = cppVariantToBool(value);
+    else if (key == "WebKitThreadedHTMLParserEnabled")
+        prefs->threadedHTMLParserEnabled = cppVariantToBool(value);
     else if (key == "WebKitEnableCaretBrowsing")
         prefs->caretBrowsingEnabled = cppVariantToBool(value);
     else {
@@ -102,6 +102,7 @@ void WebPreferences::reset()
 
     tabsToLinks = false;
     hyperlinkAuditingEnabled = false;
+    threadedHTMLParserEnabled = false;
     acceleratedCompositingEnabled = false;
     accelerated2dCanvasEnabled = false;
     forceCompositingMode = false;
@@ -145,6 +146,7 @@ void WebPreferences::applyTo(WebView* webView)
     settings->setAllowUniversalAccessFromFileURLs(allowUniversalAccessFromFileURLs);
     settings->setEditingBehavior(editingBehavior);
     settings->setHyperlinkAuditingEnabled(hyperlinkAuditingEnabled);
+    settings->setThreadedHTMLParserEnabled(threadedHTMLParserEnabled);
     // LayoutTests were written with Safari Mac in mind which does not allow
     // tabbing to links by default.
     webView->setTabsToLinks(tabsToLinks);
@@ -76,6 +76,7 @@ struct WebPreferences {
     WebKit::WebSettings::EditingBehavior editingBehavior;
     bool tabsToLinks;
     bool hyperlinkAuditingEnabled;
+    bool threadedHTMLParserEnabled;
     bool caretBrowsingEnabled;
     bool acceleratedCompositingEnabled;
     bool forceCompositingMode;